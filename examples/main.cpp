@@ -7,6 +7,8 @@
 #include <cstdio>
 #include <cmath>
 #include <iomanip>
+#include <span>
+#include <algorithm>
 
 using namespace tama;
 
@@ -343,7 +345,1089 @@ void benchmark_stateful_gd() {
 
 
 
+template <typename Single, typename Bank>
+void benchmark_bank(const char* name, Bank& bank, std::size_t instrumentCount, std::size_t tickCount, std::size_t warmupTicks = 1) {
+    std::vector<double> ticks = make_random_doubles(instrumentCount * tickCount, 1.0, 100.0);
+    std::span<const double> allTicks(ticks);
 
+    for (std::size_t t = 0; t < warmupTicks; ++t) {
+        bank.update(allTicks.subspan(t * instrumentCount, instrumentCount));
+    }
+
+    std::vector<Single> singles;
+    singles.reserve(instrumentCount);
+    for (std::size_t i = 0; i < instrumentCount; ++i) {
+        singles.emplace_back(bank.getState(i));
+    }
+
+    long long singleNs = measure_ns([&]() {
+        for (std::size_t t = warmupTicks; t < tickCount; ++t) {
+            std::span<const double> row = allTicks.subspan(t * instrumentCount, instrumentCount);
+            for (std::size_t i = 0; i < instrumentCount; ++i) {
+                singles[i].update(row[i]);
+            }
+        }
+    });
+
+    long long bankNs = measure_ns([&]() {
+        for (std::size_t t = warmupTicks; t < tickCount; ++t) {
+            bank.update(allTicks.subspan(t * instrumentCount, instrumentCount));
+        }
+    });
+
+    const double updates = static_cast<double>(instrumentCount) * static_cast<double>(tickCount - warmupTicks);
+    std::printf("\n%s bank timing (%zu instruments)\n", name, instrumentCount);
+    std::printf("single update(): %.3f ns/instrument\n", static_cast<double>(singleNs) / updates);
+    std::printf("bank update():   %.3f ns/instrument\n", static_cast<double>(bankNs) / updates);
+}
+
+void benchmark_ema_banks() {
+    constexpr std::size_t instrumentCount = 20'000;
+    constexpr std::size_t tickCount = 200;
+
+    std::vector<uint16_t> periods(instrumentCount);
+    std::vector<double> volumeFactors(instrumentCount);
+    for (std::size_t i = 0; i < instrumentCount; ++i) {
+        periods[i] = static_cast<uint16_t>(5 + i % 196);
+        volumeFactors[i] = 0.7;
+    }
+
+    ExponentialMovingAverageBank ema(periods);
+    DoubleExponentialMovingAverageBank dema(periods);
+    TripleExponentialMovingAverageBank tema(periods);
+    GeneralizedDoubleExponentialMovingAverageBank gd(volumeFactors, periods);
+
+    benchmark_bank<ExponentialMovingAverage>("EMA", ema, instrumentCount, tickCount);
+    benchmark_bank<DoubleExponentialMovingAverage>("DEMA", dema, instrumentCount, tickCount);
+    benchmark_bank<TripleExponentialMovingAverage>("TEMA", tema, instrumentCount, tickCount);
+    benchmark_bank<GeneralizedDoubleExponentialMovingAverage>("GD", gd, instrumentCount, tickCount);
+}
+
+void benchmark_window_banks() {
+    constexpr std::size_t instrumentCount = 10'000;
+    constexpr std::size_t tickCount = 300;
+    constexpr uint16_t maxPeriod = 50;
+
+    // A handful of production periods, so instruments land in a few buckets.
+    constexpr uint16_t bucketPeriods[] = {5, 10, 20, maxPeriod};
+    std::vector<uint16_t> periods(instrumentCount);
+    for (std::size_t i = 0; i < instrumentCount; ++i) {
+        periods[i] = bucketPeriods[i % 4];
+    }
+
+    SimpleMovingAverageBank sma(periods);
+    WeightedMovingAverageBank wma(periods);
+
+    benchmark_bank<SimpleMovingAverage>("SMA", sma, instrumentCount, tickCount, maxPeriod);
+    benchmark_bank<WeightedMovingAverage>("WMA", wma, instrumentCount, tickCount, maxPeriod);
+}
+
+void benchmark_sweeps() {
+    constexpr std::size_t count = 200'000;
+
+    std::vector<double> prices = make_random_doubles(count, 1.0, 100.0);
+    std::vector<double> volumes = make_random_doubles(count, 1.0, 1'000.0);
+    std::vector<uint16_t> periods;
+    for (uint16_t p = 5; p <= 200; ++p) {
+        periods.push_back(p);
+    }
+
+    // Both sides write the full periods x count matrix, pre-faulted.
+    std::vector<double> out(periods.size() * count);
+    std::vector<double> sweepOut(periods.size() * count);
+
+    long long smaLoopNs = measure_ns([&]() {
+        for (uint16_t p : periods) {
+            std::vector<double> row;
+            SimpleMovingAverage(p).compute(prices, row);
+            std::copy(row.begin(), row.end(), out.begin() + static_cast<std::ptrdiff_t>((p - 5) * count));
+        }
+    });
+    long long smaSweepNs = measure_ns([&]() {
+        SimpleMovingAverage::sweep(prices, periods, sweepOut);
+    });
+
+    long long wmaLoopNs = measure_ns([&]() {
+        for (uint16_t p : periods) {
+            std::vector<double> row;
+            WeightedMovingAverage(p).compute(prices, row);
+            std::copy(row.begin(), row.end(), out.begin() + static_cast<std::ptrdiff_t>((p - 5) * count));
+        }
+    });
+    long long wmaSweepNs = measure_ns([&]() {
+        WeightedMovingAverage::sweep(prices, periods, sweepOut);
+    });
+
+    long long vwmaLoopNs = measure_ns([&]() {
+        for (uint16_t p : periods) {
+            std::vector<double> row;
+            VolumeWeightedMovingAverage(p).compute(prices, volumes, row);
+            std::copy(row.begin(), row.end(), out.begin() + static_cast<std::ptrdiff_t>((p - 5) * count));
+        }
+    });
+    long long vwmaSweepNs = measure_ns([&]() {
+        VolumeWeightedMovingAverage::sweep(prices, volumes, periods, sweepOut);
+    });
+
+    std::printf("\nPeriod sweep timing (%zu periods x 200k)\n", periods.size());
+    std::printf("SMA  compute loop: %8.3f ms, sweep: %8.3f ms\n", static_cast<double>(smaLoopNs) / 1'000'000.0, static_cast<double>(smaSweepNs) / 1'000'000.0);
+    std::printf("WMA  compute loop: %8.3f ms, sweep: %8.3f ms\n", static_cast<double>(wmaLoopNs) / 1'000'000.0, static_cast<double>(wmaSweepNs) / 1'000'000.0);
+    std::printf("VWMA compute loop: %8.3f ms, sweep: %8.3f ms\n", static_cast<double>(vwmaLoopNs) / 1'000'000.0, static_cast<double>(vwmaSweepNs) / 1'000'000.0);
+}
+
+void benchmark_ema_sweeps() {
+    constexpr std::size_t count = 1'000'000;
+
+    std::vector<double> prices = make_random_doubles(count, 1.0, 100.0);
+    std::vector<uint16_t> periods;
+    for (uint16_t p = 5; p < 69; ++p) {
+        periods.push_back(p);
+    }
+
+    std::vector<double> out;
+    std::vector<double> sweepOut(periods.size() * count);
+
+    auto report = [&](const char* name, auto&& loop, auto&& sweep) {
+        long long loopNs = measure_ns(loop);
+        long long sweepNs = measure_ns(sweep);
+        std::printf("%-4s compute loop: %8.3f ms, sweep: %8.3f ms\n", name, static_cast<double>(loopNs) / 1'000'000.0, static_cast<double>(sweepNs) / 1'000'000.0);
+    };
+
+    std::printf("\nEMA-family sweep timing (%zu periods x 1M)\n", periods.size());
+    report("EMA",
+        [&]() { for (uint16_t p : periods) ExponentialMovingAverage(p).compute(prices, out); },
+        [&]() { ExponentialMovingAverage::sweep(prices, periods, sweepOut); });
+    report("DEMA",
+        [&]() { for (uint16_t p : periods) DoubleExponentialMovingAverage(p).compute(prices, out); },
+        [&]() { DoubleExponentialMovingAverage::sweep(prices, periods, sweepOut); });
+    report("TEMA",
+        [&]() { for (uint16_t p : periods) TripleExponentialMovingAverage(p).compute(prices, out); },
+        [&]() { TripleExponentialMovingAverage::sweep(prices, periods, sweepOut); });
+    report("GD",
+        [&]() { for (uint16_t p : periods) GeneralizedDoubleExponentialMovingAverage(0.7, p).compute(prices, out); },
+        [&]() { GeneralizedDoubleExponentialMovingAverage::sweep(prices, 0.7, periods, sweepOut); });
+}
+
+void benchmark_ema_scan() {
+    constexpr std::size_t count = 20'000'000;
+    constexpr uint16_t period = 200;
+
+    std::vector<double> prices = make_random_doubles(count, 1.0, 100.0);
+    std::vector<double> out(count);
+
+    ExponentialMovingAverage ema(period);
+
+    long long serialNs = measure_ns([&]() {
+        ema.compute(prices, out);
+    });
+    long long simdNs = measure_ns([&]() {
+        ema.computeScan(prices, out, scanMode::simd);
+    });
+    long long threadedNs = measure_ns([&]() {
+        ema.computeScan(prices, out, scanMode::threaded);
+    });
+
+    std::printf("\nEMA scan timing (20M)\n");
+    std::printf("serial compute:      %8.3f ms\n", static_cast<double>(serialNs) / 1'000'000.0);
+    std::printf("simd computeScan:    %8.3f ms\n", static_cast<double>(simdNs) / 1'000'000.0);
+    std::printf("threaded computeScan:%8.3f ms\n", static_cast<double>(threadedNs) / 1'000'000.0);
+}
+
+void benchmark_fused_ema_cascades() {
+    constexpr std::size_t count = 20'000'000;
+    constexpr uint16_t period = 20;
+
+    std::vector<double> prices = make_random_doubles(count, 1.0, 100.0);
+    std::vector<double> out(count);
+
+    DoubleExponentialMovingAverage dema(period);
+    TripleExponentialMovingAverage tema(period);
+    GeneralizedDoubleExponentialMovingAverage gd(0.7, period);
+
+    long long demaNs = measure_ns([&]() { dema.compute(prices, out); });
+    long long temaNs = measure_ns([&]() { tema.compute(prices, out); });
+    long long gdNs = measure_ns([&]() { gd.compute(prices, out); });
+
+    std::printf("\nFused EMA cascade compute (20M)\n");
+    std::printf("DEMA: %8.3f ms (%.3f ns/sample)\n", static_cast<double>(demaNs) / 1'000'000.0, static_cast<double>(demaNs) / static_cast<double>(count));
+    std::printf("TEMA: %8.3f ms (%.3f ns/sample)\n", static_cast<double>(temaNs) / 1'000'000.0, static_cast<double>(temaNs) / static_cast<double>(count));
+    std::printf("GD:   %8.3f ms (%.3f ns/sample)\n", static_cast<double>(gdNs) / 1'000'000.0, static_cast<double>(gdNs) / static_cast<double>(count));
+}
+
+void benchmark_fused_hma() {
+    constexpr std::size_t count = 20'000'000;
+    constexpr uint16_t period = 20;
+
+    std::vector<double> prices = make_random_doubles(count, 1.0, 100.0);
+    std::vector<double> out(count);
+
+    HullMovingAverage hma(period);
+    long long fusedNs = measure_ns([&]() { hma.compute(prices, out); });
+
+    // The three-pass pipeline HMA::compute used to run, with its two temporaries.
+    long long passesNs = measure_ns([&]() {
+        WeightedMovingAverage w1(period / 2);
+        WeightedMovingAverage w2(period);
+        WeightedMovingAverage w3(static_cast<uint16_t>(std::lround(std::sqrt(static_cast<double>(period)))));
+        std::vector<double> a(count);
+        std::vector<double> b(count);
+        w1.compute(prices, a);
+        w2.compute(prices, b);
+        for (std::size_t i = 0; i < count; ++i) {
+            a[i] = 2.0 * a[i] - b[i];
+        }
+        w3.compute(a, out);
+    });
+
+    std::printf("\nFused HMA compute (20M)\n");
+    std::printf("fused:       %8.3f ms (%.3f ns/sample)\n", static_cast<double>(fusedNs) / 1'000'000.0, static_cast<double>(fusedNs) / static_cast<double>(count));
+    std::printf("three-pass:  %8.3f ms (%.3f ns/sample)\n", static_cast<double>(passesNs) / 1'000'000.0, static_cast<double>(passesNs) / static_cast<double>(count));
+}
+
+void benchmark_frama_monotonic() {
+    constexpr std::size_t updateCount = 200'000;
+
+    std::printf("\nFRAMA update on a monotonic series\n");
+    for (uint16_t period : {16, 64, 256, 1024, 4096}) {
+        // A steadily rising market keeps evicting the window lows.
+        const std::size_t count = period + updateCount;
+        std::vector<double> high(count);
+        std::vector<double> low(count);
+        std::vector<double> close(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            low[i] = 1.0 + 0.001 * static_cast<double>(i);
+            high[i] = low[i] + 0.5;
+            close[i] = low[i] + 0.25;
+        }
+
+        std::vector<double> out;
+        FractalAdaptiveMovingAverage frama(period);
+        frama.compute(std::span<const double>(close).first(period), std::span<const double>(low).first(period), std::span<const double>(high).first(period), out);
+
+        long long updatesNs = measure_ns([&]() {
+            for (std::size_t i = period; i < count; ++i) {
+                frama.update(close[i], low[i], high[i]);
+            }
+        });
+
+        std::printf("period %4u: %.3f ns/update\n", static_cast<unsigned>(period), static_cast<double>(updatesNs) / static_cast<double>(updateCount));
+    }
+}
+
+void benchmark_simd_kernels() {
+    constexpr std::size_t calls = 2'000'000;
+
+    const char* isaNames[] = {"scalar", "sse2", "avx2", "avx512", "neon"};
+    std::printf("\nSIMD kernel per-call timing (%s)\n", isaNames[static_cast<int>(helpers::activeSimdIsa())]);
+    for (std::size_t n : {8, 64, 4096}) {
+        std::vector<double> values = make_random_doubles(n, 1.0, 100.0);
+        std::vector<double> state = make_random_doubles(n, 1.0, 100.0);
+        std::vector<double> alpha(n, 0.1);
+        std::vector<double> oma(n, 0.9);
+        const std::size_t reps = calls / n + 1;
+
+        volatile double sink = 0.0;
+        long long sumNs = measure_ns([&]() {
+            for (std::size_t r = 0; r < reps; ++r) {
+                sink = sink + helpers::simdSum(values);
+            }
+        });
+        long long stepNs = measure_ns([&]() {
+            for (std::size_t r = 0; r < reps; ++r) {
+                helpers::simdEmaStep(state, alpha, oma, values);
+            }
+        });
+
+        std::printf("n=%4zu  simdSum: %8.3f ns/call  simdEmaStep: %8.3f ns/call\n", n,
+            static_cast<double>(sumNs) / static_cast<double>(reps), static_cast<double>(stepNs) / static_cast<double>(reps));
+    }
+}
+
+template <typename T>
+double max_deviation(const std::vector<T>& got, const std::vector<double>& expected, std::size_t from) {
+    double worst = 0.0;
+    for (std::size_t i = from; i < expected.size(); ++i) {
+        worst = std::max(worst, std::abs(static_cast<double>(got[i]) - expected[i]));
+    }
+    return worst;
+}
+
+void benchmark_precision() {
+    constexpr std::size_t count = 20'000'000;
+    constexpr uint16_t period = 20;
+
+    std::vector<double> prices = make_random_doubles(count, 1.0, 100.0);
+    std::vector<double> volume = make_random_doubles(count, 1.0, 1'000.0);
+    std::vector<float> pricesF(prices.begin(), prices.end());
+    std::vector<float> volumeF(volume.begin(), volume.end());
+    std::vector<double> out(count);
+    std::vector<float> outF(count);
+    std::vector<float> outFF(count);
+
+    auto report = [&](const char* name, long long doubleNs, long long mixedNs, long long floatNs) {
+        const double samples = static_cast<double>(count);
+        std::printf("%-5s double %7.1f Ms/s | float+double %7.1f Ms/s, max dev %.3g | float %7.1f Ms/s, max dev %.3g\n", name,
+            samples / static_cast<double>(doubleNs) * 1'000.0,
+            samples / static_cast<double>(mixedNs) * 1'000.0, max_deviation(outF, out, period),
+            samples / static_cast<double>(floatNs) * 1'000.0, max_deviation(outFF, out, period));
+    };
+
+    std::printf("\nReduced-precision compute (20M)\n");
+
+    long long d = measure_ns([&]() { SimpleMovingAverage(period).compute(prices, out); });
+    long long m = measure_ns([&]() { BasicSimpleMovingAverage<float>(period).compute(pricesF, outF); });
+    long long f = measure_ns([&]() { BasicSimpleMovingAverage<float, float>(period).compute(pricesF, outFF); });
+    report("SMA", d, m, f);
+
+    d = measure_ns([&]() { ExponentialMovingAverage(period).compute(prices, out); });
+    m = measure_ns([&]() { BasicExponentialMovingAverage<float>(period).compute(pricesF, outF); });
+    f = measure_ns([&]() { BasicExponentialMovingAverage<float, float>(period).compute(pricesF, outFF); });
+    report("EMA", d, m, f);
+
+    d = measure_ns([&]() { WeightedMovingAverage(period).compute(prices, out); });
+    m = measure_ns([&]() { BasicWeightedMovingAverage<float>(period).compute(pricesF, outF); });
+    f = measure_ns([&]() { BasicWeightedMovingAverage<float, float>(period).compute(pricesF, outFF); });
+    report("WMA", d, m, f);
+
+    d = measure_ns([&]() { VolumeWeightedMovingAverage(period).compute(prices, volume, out); });
+    m = measure_ns([&]() { BasicVolumeWeightedMovingAverage<float>(period).compute(pricesF, volumeF, outF); });
+    f = measure_ns([&]() { BasicVolumeWeightedMovingAverage<float, float>(period).compute(pricesF, volumeF, outFF); });
+    report("VWMA", d, m, f);
+}
+
+void benchmark_window_updates() {
+    constexpr std::size_t warmCount = 1'000;
+    constexpr std::size_t updateCount = 2'000'000;
+    constexpr uint16_t period = 50;
+
+    std::vector<double> prices = make_random_doubles(warmCount + updateCount, 1.0, 100.0);
+    std::vector<double> volume = make_random_doubles(warmCount + updateCount, 1.0, 1'000.0);
+    std::vector<double> low(prices.size());
+    std::vector<double> high(prices.size());
+    for (std::size_t i = 0; i < prices.size(); ++i) {
+        low[i] = prices[i] - 0.5;
+        high[i] = prices[i] + 0.5;
+    }
+    const std::span<const double> warm(prices.data(), warmCount);
+    std::vector<double> out;
+
+    SimpleMovingAverage sma(period);
+    WeightedMovingAverage wma(period);
+    VolumeWeightedMovingAverage vwma(period);
+    FractalAdaptiveMovingAverage frama(period);
+    sma.compute(warm, out);
+    wma.compute(warm, out);
+    vwma.compute(warm, std::span<const double>(volume.data(), warmCount), out);
+    frama.compute(warm, std::span<const double>(low.data(), warmCount), std::span<const double>(high.data(), warmCount), out);
+
+    volatile double sink = 0.0;
+    auto perUpdate = [&](auto&& step) {
+        long long ns = measure_ns([&]() {
+            double acc = 0.0;
+            for (std::size_t i = warmCount; i < prices.size(); ++i) {
+                acc += step(i);
+            }
+            sink = acc;
+        });
+        return static_cast<double>(ns) / static_cast<double>(updateCount);
+    };
+
+    std::printf("\nWindowed update latency (period 50)\n");
+    std::printf("SMA:   %.3f ns/update\n", perUpdate([&](std::size_t i) { return sma.update(prices[i]); }));
+    std::printf("WMA:   %.3f ns/update\n", perUpdate([&](std::size_t i) { return wma.update(prices[i]); }));
+    std::printf("VWMA:  %.3f ns/update\n", perUpdate([&](std::size_t i) { return vwma.update(prices[i], volume[i]); }));
+    std::printf("FRAMA: %.3f ns/update\n", perUpdate([&](std::size_t i) { return frama.update(prices[i], low[i], high[i]); }));
+}
+
+void benchmark_static_periods() {
+    constexpr std::size_t warmCount = 1'000;
+    constexpr std::size_t updateCount = 2'000'000;
+    constexpr uint16_t period = 20;
+
+    std::vector<double> prices = make_random_doubles(warmCount + updateCount, 1.0, 100.0);
+    const std::span<const double> warm(prices.data(), warmCount);
+    std::vector<double> out;
+
+    SimpleMovingAverage sma(period);
+    WeightedMovingAverage wma(period);
+    HullMovingAverage hma(period);
+    StaticSMA<period> staticSma;
+    StaticWMA<period> staticWma;
+    StaticHMA<period> staticHma;
+    sma.compute(warm, out);
+    wma.compute(warm, out);
+    hma.compute(warm, out);
+    staticSma.compute(warm, out);
+    staticWma.compute(warm, out);
+    staticHma.compute(warm, out);
+
+    volatile double sink = 0.0;
+    auto perUpdate = [&](auto&& step) {
+        long long ns = measure_ns([&]() {
+            double acc = 0.0;
+            for (std::size_t i = warmCount; i < prices.size(); ++i) {
+                acc += step(prices[i]);
+            }
+            sink = acc;
+        });
+        return static_cast<double>(ns) / static_cast<double>(updateCount);
+    };
+
+    std::printf("\nCompile-time period update latency (period 20, dynamic vs static)\n");
+    std::printf("SMA: %.3f vs %.3f ns/update\n",
+        perUpdate([&](double p) { return sma.update(p); }), perUpdate([&](double p) { return staticSma.update(p); }));
+    std::printf("WMA: %.3f vs %.3f ns/update\n",
+        perUpdate([&](double p) { return wma.update(p); }), perUpdate([&](double p) { return staticWma.update(p); }));
+    std::printf("HMA: %.3f vs %.3f ns/update\n",
+        perUpdate([&](double p) { return hma.update(p); }), perUpdate([&](double p) { return staticHma.update(p); }));
+}
+
+
+void benchmark_tick_updates() {
+    constexpr std::size_t warmCount = 1'000;
+    constexpr std::size_t updateCount = 2'000'000;
+    constexpr uint16_t period = 20;
+
+    std::vector<double> prices = make_random_doubles(warmCount + updateCount, 1.0, 100.0);
+    std::vector<double> volume = make_random_doubles(warmCount + updateCount, 1.0, 1'000.0);
+    std::vector<double> low(prices.size());
+    std::vector<double> high(prices.size());
+    for (std::size_t i = 0; i < prices.size(); ++i) {
+        low[i] = prices[i] - 0.5;
+        high[i] = prices[i] + 0.5;
+    }
+    const std::span<const double> warm(prices.data(), warmCount);
+    std::vector<double> out;
+
+    ExponentialMovingAverage ema(period);
+    SimpleMovingAverage sma(period);
+    WeightedMovingAverage wma(period);
+    VolumeWeightedMovingAverage vwma(period);
+    HullMovingAverage hma(period);
+    DoubleExponentialMovingAverage dema(period);
+    TripleExponentialMovingAverage tema(period);
+    McGinleyDynamicMovingAverage md(period);
+    FractalAdaptiveMovingAverage frama(period);
+    GeneralizedDoubleExponentialMovingAverage gd(0.7, period);
+    ema.compute(warm, out);
+    sma.compute(warm, out);
+    wma.compute(warm, out);
+    vwma.compute(warm, std::span<const double>(volume.data(), warmCount), out);
+    hma.compute(warm, out);
+    dema.compute(warm, out);
+    tema.compute(warm, out);
+    md.compute(warm, out);
+    frama.compute(warm, std::span<const double>(low.data(), warmCount), std::span<const double>(high.data(), warmCount), out);
+    gd.compute(warm, out);
+
+    volatile double sink = 0.0;
+    auto perUpdate = [&](auto&& step) {
+        long long ns = measure_ns([&]() {
+            double acc = 0.0;
+            for (std::size_t i = warmCount; i < prices.size(); ++i) {
+                acc += step(i);
+            }
+            sink = acc;
+        });
+        return static_cast<double>(ns) / static_cast<double>(updateCount);
+    };
+
+#ifdef TAMA_HEADER_INLINE
+    std::printf("\nPer-tick update latency, header-inline (period 20)\n");
+#else
+    std::printf("\nPer-tick update latency, library calls (period 20)\n");
+#endif
+    std::printf("EMA:   %.3f ns/update\n", perUpdate([&](std::size_t i) { return ema.update(prices[i]); }));
+    std::printf("SMA:   %.3f ns/update\n", perUpdate([&](std::size_t i) { return sma.update(prices[i]); }));
+    std::printf("WMA:   %.3f ns/update\n", perUpdate([&](std::size_t i) { return wma.update(prices[i]); }));
+    std::printf("VWMA:  %.3f ns/update\n", perUpdate([&](std::size_t i) { return vwma.update(prices[i], volume[i]); }));
+    std::printf("HMA:   %.3f ns/update\n", perUpdate([&](std::size_t i) { return hma.update(prices[i]); }));
+    std::printf("DEMA:  %.3f ns/update\n", perUpdate([&](std::size_t i) { return dema.update(prices[i]); }));
+    std::printf("TEMA:  %.3f ns/update\n", perUpdate([&](std::size_t i) { return tema.update(prices[i]); }));
+    std::printf("MD:    %.3f ns/update\n", perUpdate([&](std::size_t i) { return md.update(prices[i]); }));
+    std::printf("FRAMA: %.3f ns/update\n", perUpdate([&](std::size_t i) { return frama.update(prices[i], low[i], high[i]); }));
+    std::printf("GD:    %.3f ns/update\n", perUpdate([&](std::size_t i) { return gd.update(prices[i]); }));
+}
+
+void benchmark_state_snapshots() {
+    constexpr std::size_t instrumentCount = 20'000;
+    constexpr std::size_t warmCount = 200;
+    constexpr uint16_t period = 50;
+
+    std::vector<double> prices = make_random_doubles(warmCount, 1.0, 100.0);
+    std::vector<double> out;
+    std::vector<SimpleMovingAverage> smas(instrumentCount, SimpleMovingAverage(period));
+    std::vector<HullMovingAverage> hmas(instrumentCount, HullMovingAverage(period));
+    for (std::size_t i = 0; i < instrumentCount; ++i) {
+        smas[i].compute(prices, out);
+        hmas[i].compute(prices, out);
+    }
+
+    std::vector<SimpleMovingAverageState> smaStates(instrumentCount);
+    std::vector<HullMovingAverageState> hmaStates(instrumentCount);
+    std::vector<std::byte> arena(instrumentCount * (smas[0].packedSize() + hmas[0].packedSize()));
+
+    auto perInstrument = [&](auto&& checkpoint) {
+        checkpoint();
+        long long ns = measure_ns(checkpoint);
+        return static_cast<double>(ns) / static_cast<double>(instrumentCount);
+    };
+
+    const double smaFresh = perInstrument([&]() {
+        for (std::size_t i = 0; i < instrumentCount; ++i) smaStates[i] = smas[i].getState();
+    });
+    const double smaReused = perInstrument([&]() {
+        for (std::size_t i = 0; i < instrumentCount; ++i) smas[i].getState(smaStates[i]);
+    });
+    const double hmaFresh = perInstrument([&]() {
+        for (std::size_t i = 0; i < instrumentCount; ++i) hmaStates[i] = hmas[i].getState();
+    });
+    const double hmaReused = perInstrument([&]() {
+        for (std::size_t i = 0; i < instrumentCount; ++i) hmas[i].getState(hmaStates[i]);
+    });
+    const double packed = perInstrument([&]() {
+        std::span<std::byte> free(arena);
+        for (std::size_t i = 0; i < instrumentCount; ++i) {
+            smas[i].pack(free);
+            free = free.subspan(smas[i].packedSize());
+            hmas[i].pack(free);
+            free = free.subspan(hmas[i].packedSize());
+        }
+    });
+
+    std::printf("\nState checkpoint of 20k instruments (period 50), ns/instrument\n");
+    std::printf("SMA getState(): %.1f  getState(out): %.1f\n", smaFresh, smaReused);
+    std::printf("HMA getState(): %.1f  getState(out): %.1f\n", hmaFresh, hmaReused);
+    std::printf("SMA+HMA pack() into one arena: %.1f\n", packed);
+}
+
+void benchmark_batch_updates() {
+    constexpr std::size_t warmCount = 1'000;
+    constexpr std::size_t updateCount = 2'000'000;
+    constexpr std::size_t batchSize = 256;
+    constexpr uint16_t period = 20;
+
+    std::vector<double> prices = make_random_doubles(warmCount + updateCount, 1.0, 100.0);
+    std::vector<double> volume = make_random_doubles(warmCount + updateCount, 1.0, 1'000.0);
+    const std::span<const double> warm(prices.data(), warmCount);
+    std::vector<double> out;
+    std::vector<double> batchOut(batchSize);
+
+    // Each row replays the same ticks through two copies of a warmed indicator:
+    // one update() per tick, then update(span) per batch of 256.
+    auto compare = [&](const char* name, auto indicator, auto&& single, auto&& batch) {
+        auto a = indicator;
+        auto b = indicator;
+        volatile double sink = 0.0;
+        long long singleNs = measure_ns([&]() {
+            double acc = 0.0;
+            for (std::size_t i = warmCount; i < prices.size(); ++i) {
+                acc += single(a, i);
+            }
+            sink = acc;
+        });
+        long long batchNs = measure_ns([&]() {
+            double acc = 0.0;
+            for (std::size_t i = warmCount; i < prices.size(); i += batchSize) {
+                const std::size_t n = std::min(batchSize, prices.size() - i);
+                batch(b, i, n);
+                acc += batchOut[n - 1];
+            }
+            sink = acc;
+        });
+        std::printf("%-5s single: %.3f  batch: %.3f ns/tick\n", name,
+            static_cast<double>(singleNs) / static_cast<double>(updateCount),
+            static_cast<double>(batchNs) / static_cast<double>(updateCount));
+    };
+
+    auto warmed = [&](auto indicator) {
+        indicator.compute(warm, out);
+        return indicator;
+    };
+    auto single = [&](auto& indicator, std::size_t i) { return indicator.update(prices[i]); };
+    auto batch = [&](auto& indicator, std::size_t i, std::size_t n) {
+        indicator.update(std::span<const double>(prices.data() + i, n), std::span<double>(batchOut.data(), n));
+    };
+
+    std::printf("\nBatch update vs per-tick update (period 20, batches of 256)\n");
+    compare("EMA", warmed(ExponentialMovingAverage(period)), single, batch);
+    compare("SMA", warmed(SimpleMovingAverage(period)), single, batch);
+    compare("WMA", warmed(WeightedMovingAverage(period)), single, batch);
+    compare("HMA", warmed(HullMovingAverage(period)), single, batch);
+    compare("TEMA", warmed(TripleExponentialMovingAverage(period)), single, batch);
+
+    VolumeWeightedMovingAverage vwma(period);
+    vwma.compute(warm, std::span<const double>(volume.data(), warmCount), out);
+    compare("VWMA", vwma,
+        [&](auto& indicator, std::size_t i) { return indicator.update(prices[i], volume[i]); },
+        [&](auto& indicator, std::size_t i, std::size_t n) {
+            indicator.update(std::span<const double>(prices.data() + i, n), std::span<const double>(volume.data() + i, n), std::span<double>(batchOut.data(), n));
+        });
+}
+
+void benchmark_intrabar_amends() {
+    constexpr std::size_t historyCount = 1'000;
+    constexpr std::size_t barCount = 20;
+    constexpr std::size_t ticksPerBar = 1'000;
+    constexpr uint16_t period = 20;
+
+    // Every bar opens with update() and then revises its close 999 times: amend()
+    // on the live indicator vs compute() over the whole history on each revision.
+    std::vector<double> prices = make_random_doubles(historyCount, 1.0, 100.0);
+    std::vector<double> volume = make_random_doubles(historyCount, 1.0, 1'000.0);
+    const std::vector<double> ticks = make_random_doubles(barCount * ticksPerBar, 1.0, 100.0);
+    std::vector<double> out;
+
+    auto compare = [&](const char* name, auto indicator, auto&& open, auto&& amend, auto&& rebuild) {
+        auto live = indicator;
+        volatile double sink = 0.0;
+        long long amendNs = measure_ns([&]() {
+            double acc = 0.0;
+            for (std::size_t bar = 0; bar < barCount; ++bar) {
+                const std::size_t first = bar * ticksPerBar;
+                acc += open(live, ticks[first]);
+                for (std::size_t k = first + 1; k < first + ticksPerBar; ++k) {
+                    acc += amend(live, ticks[k]);
+                }
+            }
+            sink = acc;
+        });
+
+        std::vector<double> series(prices);
+        std::vector<double> seriesVolume(volume);
+        long long rebuildNs = measure_ns([&]() {
+            double acc = 0.0;
+            for (std::size_t bar = 0; bar < barCount; ++bar) {
+                series.push_back(0.0);
+                seriesVolume.push_back(500.0);
+                for (std::size_t k = bar * ticksPerBar; k < (bar + 1) * ticksPerBar; ++k) {
+                    series.back() = ticks[k];
+                    acc += rebuild(indicator, series, seriesVolume);
+                }
+            }
+            sink = acc;
+        });
+
+        const double tickCount = static_cast<double>(barCount * ticksPerBar);
+        std::printf("%-5s amend: %.3f  rebuild: %.1f ns/tick\n", name,
+            static_cast<double>(amendNs) / tickCount,
+            static_cast<double>(rebuildNs) / tickCount);
+    };
+
+    auto warmed = [&](auto indicator) {
+        indicator.compute(prices, out);
+        return indicator;
+    };
+    auto open = [](auto& indicator, double price) { return indicator.update(price); };
+    auto amend = [](auto& indicator, double price) { return indicator.amend(price); };
+    auto rebuild = [&](auto& indicator, const std::vector<double>& series, const std::vector<double>&) {
+        indicator.compute(series, out);
+        return out.back();
+    };
+
+    std::printf("\nIntrabar amend vs rebuild-on-amend (period 20, %zu-bar history, 1000 ticks per bar)\n", historyCount);
+    compare("EMA", warmed(ExponentialMovingAverage(period)), open, amend, rebuild);
+    compare("SMA", warmed(SimpleMovingAverage(period)), open, amend, rebuild);
+    compare("WMA", warmed(WeightedMovingAverage(period)), open, amend, rebuild);
+    compare("HMA", warmed(HullMovingAverage(period)), open, amend, rebuild);
+    compare("TEMA", warmed(TripleExponentialMovingAverage(period)), open, amend, rebuild);
+    compare("MD", warmed(McGinleyDynamicMovingAverage(period)), open, amend, rebuild);
+
+    VolumeWeightedMovingAverage vwma(period);
+    vwma.compute(prices, volume, out);
+    compare("VWMA", vwma,
+        [](auto& indicator, double price) { return indicator.update(price, 500.0); },
+        [](auto& indicator, double price) { return indicator.amend(price, 500.0); },
+        [&](auto& indicator, const std::vector<double>& series, const std::vector<double>& seriesVolume) {
+            indicator.compute(series, seriesVolume, out);
+            return out.back();
+        });
+
+    // FRAMA bars span one unit either side of the close.
+    std::vector<double> lows(prices.size());
+    std::vector<double> highs(prices.size());
+    auto bands = [&](const std::vector<double>& series) {
+        lows.resize(series.size());
+        highs.resize(series.size());
+        for (std::size_t i = 0; i < series.size(); ++i) {
+            lows[i] = series[i] - 1.0;
+            highs[i] = series[i] + 1.0;
+        }
+    };
+    bands(prices);
+    FractalAdaptiveMovingAverage frama(period);
+    frama.compute(prices, lows, highs, out);
+    compare("FRAMA", frama,
+        [](auto& indicator, double price) { return indicator.update(price, price - 1.0, price + 1.0); },
+        [](auto& indicator, double price) { return indicator.amend(price, price - 1.0, price + 1.0); },
+        [&](auto& indicator, const std::vector<double>& series, const std::vector<double>&) {
+            bands(series);
+            indicator.compute(series, lows, highs, out);
+            return out.back();
+        });
+}
+
+void benchmark_peek_ladders() {
+    constexpr std::size_t warmCount = 1'000;
+    constexpr std::size_t tickCount = 20'000;
+    constexpr std::size_t levelCount = 50;
+    constexpr uint16_t period = 20;
+
+    const std::vector<double> prices = make_random_doubles(warmCount + tickCount, 1.0, 100.0);
+    std::vector<double> levels(levelCount);
+    std::vector<double> peeked(levelCount);
+    std::vector<double> out;
+
+    // Each tick asks for the value at 50 price levels around the close, then
+    // takes the tick: a copy plus update() per level, peek() per level, and one
+    // span peek() for the whole ladder.
+    auto compare = [&](const char* name, auto indicator) {
+        indicator.compute(std::span<const double>(prices.data(), warmCount), out);
+        auto run = [&](auto&& ask) {
+            auto live = indicator;
+            volatile double sink = 0.0;
+            const long long ns = measure_ns([&]() {
+                double acc = 0.0;
+                for (std::size_t i = warmCount; i < prices.size(); ++i) {
+                    for (std::size_t k = 0; k < levelCount; ++k) {
+                        levels[k] = prices[i] * (0.975 + 0.001 * static_cast<double>(k));
+                    }
+                    acc += ask(live);
+                    live.update(prices[i]);
+                }
+                sink = acc;
+            });
+            return static_cast<double>(ns) / static_cast<double>(tickCount * levelCount);
+        };
+
+        const double copyNs = run([&](auto& live) {
+            double acc = 0.0;
+            for (double level : levels) {
+                auto copy = live;
+                acc += copy.update(level);
+            }
+            return acc;
+        });
+        const double peekNs = run([&](auto& live) {
+            double acc = 0.0;
+            for (double level : levels) {
+                acc += live.peek(level);
+            }
+            return acc;
+        });
+        const double ladderNs = run([&](auto& live) {
+            live.peek(levels, std::span<double>(peeked));
+            return peeked[levelCount - 1];
+        });
+        std::printf("%-5s copy+update: %.2f  peek: %.2f  span peek: %.2f ns/level\n", name, copyNs, peekNs, ladderNs);
+    };
+
+    std::printf("\nPeek at a 50-level ladder per tick (period 20)\n");
+    compare("EMA", ExponentialMovingAverage(period));
+    compare("SMA", SimpleMovingAverage(period));
+    compare("WMA", WeightedMovingAverage(period));
+    compare("HMA", HullMovingAverage(period));
+    compare("TEMA", TripleExponentialMovingAverage(period));
+}
+
+void benchmark_scenario_forks() {
+    constexpr std::size_t warmCount = 2'000;
+    constexpr std::size_t branchCount = 1'000;
+    constexpr std::size_t horizon = 10;
+
+    const std::vector<double> prices = make_random_doubles(warmCount, 1.0, 100.0);
+    const std::vector<double> shocks = make_random_doubles(branchCount * horizon, 0.9, 1.1);
+    std::vector<double> out;
+
+    // Fans the live indicator out into 1000 branches and advances each by a
+    // 10-tick shock path: deep copies against fork().
+    auto compare = [&](const char* name, auto indicator) {
+        indicator.compute(prices, out);
+        const double last = prices.back();
+        auto run = [&](auto&& branch) {
+            volatile double sink = 0.0;
+            const long long ns = measure_ns([&]() {
+                double acc = 0.0;
+                for (std::size_t b = 0; b < branchCount; ++b) {
+                    auto path = branch(indicator);
+                    for (std::size_t k = 0; k < horizon; ++k) {
+                        acc += path.update(last * shocks[b * horizon + k]);
+                    }
+                }
+                sink = acc;
+            });
+            return static_cast<double>(ns) / static_cast<double>(branchCount);
+        };
+
+        const double copyNs = run([](auto& live) { return live; });
+        const double forkNs = run([](auto& live) { return live.fork(); });
+        std::printf("%-5s copy: %.1f  fork: %.1f ns/branch\n", name, copyNs, forkNs);
+    };
+
+    for (uint16_t period : {20, 200}) {
+        std::printf("\nScenario branches of 10 ticks (period %u)\n", static_cast<unsigned>(period));
+        compare("SMA", SimpleMovingAverage(period));
+        compare("WMA", WeightedMovingAverage(period));
+        compare("HMA", HullMovingAverage(period));
+        compare("TEMA", TripleExponentialMovingAverage(period));
+    }
+}
+
+void benchmark_monte_carlo_paths() {
+    constexpr std::size_t pathCount = 10'000;
+    constexpr std::size_t steps = 252;
+
+    const std::vector<double> shocks = make_random_doubles(pathCount * steps, 0.98, 1.02);
+    std::vector<double> paths(pathCount * steps);
+    for (std::size_t p = 0; p < pathCount; ++p) {
+        double price = 100.0;
+        for (std::size_t t = 0; t < steps; ++t) {
+            price *= shocks[p * steps + t];
+            paths[p * steps + t] = price;
+        }
+    }
+    std::vector<double> byTime(paths.size());
+    for (std::size_t p = 0; p < pathCount; ++p) {
+        for (std::size_t t = 0; t < steps; ++t) {
+            byTime[t * pathCount + p] = paths[p * steps + t];
+        }
+    }
+    std::vector<double> scalarOut(paths.size());
+    std::vector<double> pathsOut(paths.size());
+
+    // 10k one-year daily paths through one parameter set: compute() on a fresh
+    // indicator per path against computePaths() with paths as SIMD lanes.
+    auto compare = [&](const char* name, auto indicator) {
+        const long long scalarNs = measure_ns([&]() {
+            for (std::size_t p = 0; p < pathCount; ++p) {
+                auto copy = indicator;
+                copy.compute(std::span<const double>(paths.data() + p * steps, steps), std::span<double>(scalarOut.data() + p * steps, steps));
+            }
+        });
+        const long long pathsNs = measure_ns([&]() {
+            indicator.computePaths(paths, pathCount, std::span<double>(pathsOut));
+        });
+        const long long timeNs = measure_ns([&]() {
+            indicator.computePaths(byTime, pathCount, std::span<double>(pathsOut), pathLayout::timeMajor);
+        });
+        std::printf("%-4s per-path: %lld ms  computePaths path-major: %lld ms (%.1fx)  time-major: %lld ms (%.1fx)\n", name,
+                    scalarNs / 1'000'000, pathsNs / 1'000'000, static_cast<double>(scalarNs) / static_cast<double>(pathsNs),
+                    timeNs / 1'000'000, static_cast<double>(scalarNs) / static_cast<double>(timeNs));
+    };
+
+    std::printf("\nMonte Carlo paths (10k x 252, period 20)\n");
+    compare("EMA", ExponentialMovingAverage(20));
+    compare("MD", McGinleyDynamicMovingAverage(20));
+    compare("HMA", HullMovingAverage(20));
+}
+
+void benchmark_md_arithmetic() {
+    constexpr std::size_t count = 1'000'000;
+    constexpr uint16_t period = 10;
+
+    // A random walk: independent uniform prices swing the ratio far enough to
+    // overflow (mt / price)^4 in either arithmetic.
+    std::vector<double> prices = make_random_doubles(count, 0.98, 1.02);
+    double price = 100.0;
+    for (double& p : prices) {
+        price *= p;
+        p = price;
+    }
+    std::vector<double> exactOut(count);
+    std::vector<double> fastOut(count);
+
+    McGinleyDynamicMovingAverage exact(period);
+    McGinleyDynamicMovingAverage fast(period, 0.0, mdArithmetic::fast);
+    const long long exactComputeNs = measure_ns([&]() {
+        exact.compute(prices, std::span<double>(exactOut));
+    });
+    const long long fastComputeNs = measure_ns([&]() {
+        fast.compute(prices, std::span<double>(fastOut));
+    });
+
+    double worst = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        worst = std::max(worst, std::abs(fastOut[i] - exactOut[i]) / std::abs(exactOut[i]));
+    }
+
+    const long long exactUpdateNs = measure_ns([&]() {
+        for (double price : prices) {
+            exact.update(price);
+        }
+    });
+    const long long fastUpdateNs = measure_ns([&]() {
+        for (double price : prices) {
+            fast.update(price);
+        }
+    });
+
+    std::printf("\nMD arithmetic (1M samples, period 10)\n");
+    std::printf("compute exact: %.3f ns/sample  fast: %.3f ns/sample (%.1fx)\n",
+                static_cast<double>(exactComputeNs) / static_cast<double>(count), static_cast<double>(fastComputeNs) / static_cast<double>(count),
+                static_cast<double>(exactComputeNs) / static_cast<double>(fastComputeNs));
+    std::printf("update  exact: %.3f ns/sample  fast: %.3f ns/sample (%.1fx)\n",
+                static_cast<double>(exactUpdateNs) / static_cast<double>(count), static_cast<double>(fastUpdateNs) / static_cast<double>(count),
+                static_cast<double>(exactUpdateNs) / static_cast<double>(fastUpdateNs));
+    std::printf("max relative difference: %.3g\n", worst);
+
+    constexpr std::size_t instrumentCount = 20'000;
+    constexpr std::size_t tickCount = 200;
+    std::vector<uint16_t> periods(instrumentCount);
+    for (std::size_t i = 0; i < instrumentCount; ++i) {
+        periods[i] = static_cast<uint16_t>(5 + i % 196);
+    }
+
+    McGinleyDynamicMovingAverageBank exactBank(periods);
+    McGinleyDynamicMovingAverageBank fastBank(periods, mdArithmetic::fast);
+    benchmark_bank<McGinleyDynamicMovingAverage>("MD exact", exactBank, instrumentCount, tickCount);
+    benchmark_bank<McGinleyDynamicMovingAverage>("MD fast", fastBank, instrumentCount, tickCount);
+}
+
+void benchmark_frama_arithmetic() {
+    constexpr std::size_t count = 1'000'000;
+    constexpr uint16_t period = 16;
+
+    std::vector<double> close = make_random_doubles(count, 0.98, 1.02);
+    const std::vector<double> spread = make_random_doubles(count, 0.001, 0.02);
+    std::vector<double> low(count);
+    std::vector<double> high(count);
+    double price = 100.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        price *= close[i];
+        close[i] = price;
+        low[i] = price * (1.0 - spread[i]);
+        high[i] = price * (1.0 + spread[i] * 0.5);
+    }
+
+    std::vector<double> exactOut(count);
+    std::vector<double> approxOut(count);
+    FractalAdaptiveMovingAverage exact(period);
+    FractalAdaptiveMovingAverage approx(period, -4.6, framaArithmetic::approximate);
+    const long long exactComputeNs = measure_ns([&]() {
+        exact.compute(close, low, high, std::span<double>(exactOut));
+    });
+    const long long approxComputeNs = measure_ns([&]() {
+        approx.compute(close, low, high, std::span<double>(approxOut));
+    });
+
+    double worst = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        worst = std::max(worst, std::abs(approxOut[i] - exactOut[i]) / close[i]);
+    }
+
+    // Replays the series as live bars on the computed indicators.
+    const long long exactUpdateNs = measure_ns([&]() {
+        for (std::size_t i = 0; i < count; ++i) {
+            exact.update(close[i], low[i], high[i]);
+        }
+    });
+    const long long approxUpdateNs = measure_ns([&]() {
+        for (std::size_t i = 0; i < count; ++i) {
+            approx.update(close[i], low[i], high[i]);
+        }
+    });
+
+    const double samples = static_cast<double>(count);
+    std::printf("\nFRAMA arithmetic (1M bars, period 16)\n");
+    std::printf("compute exact: %.3f ns/bar  approximate: %.3f ns/bar (%.1fx)\n",
+                static_cast<double>(exactComputeNs) / samples, static_cast<double>(approxComputeNs) / samples,
+                static_cast<double>(exactComputeNs) / static_cast<double>(approxComputeNs));
+    std::printf("update  exact: %.3f ns/bar  approximate: %.3f ns/bar (%.1fx)\n",
+                static_cast<double>(exactUpdateNs) / samples, static_cast<double>(approxUpdateNs) / samples,
+                static_cast<double>(exactUpdateNs) / static_cast<double>(approxUpdateNs));
+    std::printf("max difference relative to the close: %.3g\n", worst);
+
+    // Next-bar alpha of 10k instruments, one indicator each.
+    constexpr std::size_t instrumentCount = 10'000;
+    constexpr int rounds = 100;
+    std::vector<FractalAdaptiveMovingAverage> exactBook;
+    std::vector<FractalAdaptiveMovingAverage> approxBook;
+    for (std::size_t i = 0; i < instrumentCount; ++i) {
+        const std::size_t at = (i * 97) % (count - period);
+        const auto bars = [&](const std::vector<double>& v) { return std::span<const double>(v).subspan(at, period); };
+        exactBook.emplace_back(period);
+        approxBook.emplace_back(period, -4.6, framaArithmetic::approximate);
+        exactBook.back().compute(bars(close), bars(low), bars(high), std::span<double>(exactOut).first(period));
+        approxBook.back().compute(bars(close), bars(low), bars(high), std::span<double>(exactOut).first(period));
+    }
+    std::vector<double> alphas(instrumentCount);
+    const long long exactAlphaNs = measure_ns([&]() {
+        for (int r = 0; r < rounds; ++r) {
+            FractalAdaptiveMovingAverage::nextAlphas(exactBook, alphas);
+        }
+    });
+    const long long approxAlphaNs = measure_ns([&]() {
+        for (int r = 0; r < rounds; ++r) {
+            FractalAdaptiveMovingAverage::nextAlphas(approxBook, alphas);
+        }
+    });
+    const double evaluations = static_cast<double>(instrumentCount) * rounds;
+    std::printf("nextAlphas (10k instruments) exact: %.3f ns/instrument  approximate: %.3f ns/instrument\n",
+                static_cast<double>(exactAlphaNs) / evaluations, static_cast<double>(approxAlphaNs) / evaluations);
+}
+
+void benchmark_vwma_compute() {
+    constexpr std::size_t count = 10'000'000;
+
+    const std::vector<double> prices = make_random_doubles(count, 1.0, 100.0);
+    const std::vector<double> volumes = make_random_doubles(count, 1.0, 1'000.0);
+    std::vector<double> out(count);
+
+    // Two inputs read and one output written per bar: the bandwidth floor is a
+    // plain streaming pass over the same three arrays.
+    const long long streamNs = measure_ns([&]() {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = prices[i] * volumes[i];
+        }
+    });
+
+    std::printf("\nVWMA compute (10M bars)\n");
+    std::printf("streaming floor: %.3f ns/bar (%.2f GB/s)\n", static_cast<double>(streamNs) / static_cast<double>(count),
+                static_cast<double>(3 * sizeof(double) * count) / static_cast<double>(streamNs));
+    for (uint16_t period : {14, 200}) {
+        VolumeWeightedMovingAverage vwma(period);
+        const long long computeNs = measure_ns([&]() {
+            vwma.compute(prices, volumes, std::span<double>(out));
+        });
+        std::printf("period %3u: %.3f ns/bar (%.2f GB/s)\n", static_cast<unsigned>(period), static_cast<double>(computeNs) / static_cast<double>(count),
+                    static_cast<double>(3 * sizeof(double) * count) / static_cast<double>(computeNs));
+    }
+}
+
+void benchmark_blocked_windows() {
+    // Repeats small series so every size times about 10M samples in total.
+    constexpr std::size_t totalSamples = 10'000'000;
+    const std::vector<std::size_t> lengths{1'000, 100'000, 10'000'000, 100'000'000};
+
+    std::printf("\nBlocked window sums vs rolling compute (ns/sample)\n");
+    std::printf("%-4s %6s %11s %9s %9s %7s\n", "", "period", "samples", "rolling", "blocked", "speedup");
+    for (std::size_t length : lengths) {
+        const std::vector<double> prices = make_random_doubles(length, 1.0, 100.0);
+        std::vector<double> out(length);
+        const int repeats = static_cast<int>(std::max<std::size_t>(1, totalSamples / length));
+        const double samples = static_cast<double>(length) * repeats;
+
+        for (uint16_t period : {5, 50, 500}) {
+            auto run = [&](const char* name, auto indicator) {
+                const long long rollingNs = measure_ns([&]() {
+                    for (int r = 0; r < repeats; ++r) {
+                        indicator.compute(prices, std::span<double>(out));
+                    }
+                });
+                const long long blockedNs = measure_ns([&]() {
+                    for (int r = 0; r < repeats; ++r) {
+                        indicator.computeBlocked(prices, std::span<double>(out));
+                    }
+                });
+                std::printf("%-4s %6u %11zu %9.3f %9.3f %6.2fx\n", name, static_cast<unsigned>(period), length,
+                            static_cast<double>(rollingNs) / samples, static_cast<double>(blockedNs) / samples,
+                            static_cast<double>(rollingNs) / static_cast<double>(blockedNs));
+            };
+            run("SMA", SimpleMovingAverage(period));
+            run("WMA", WeightedMovingAverage(period));
+        }
+    }
+}
 
 int main() {
     benchmark_stateful_wma();
@@ -356,6 +1440,29 @@ int main() {
     benchmark_stateful_md();
     benchmark_stateful_frama();
     benchmark_stateful_gd();
+    benchmark_ema_banks();
+    benchmark_window_banks();
+    benchmark_sweeps();
+    benchmark_ema_sweeps();
+    benchmark_ema_scan();
+    benchmark_fused_ema_cascades();
+    benchmark_fused_hma();
+    benchmark_frama_monotonic();
+    benchmark_simd_kernels();
+    benchmark_precision();
+    benchmark_window_updates();
+    benchmark_static_periods();
+    benchmark_tick_updates();
+    benchmark_state_snapshots();
+    benchmark_batch_updates();
+    benchmark_intrabar_amends();
+    benchmark_peek_ladders();
+    benchmark_scenario_forks();
+    benchmark_monte_carlo_paths();
+    benchmark_md_arithmetic();
+    benchmark_frama_arithmetic();
+    benchmark_vwma_compute();
+    benchmark_blocked_windows();
 
 
     return 0;
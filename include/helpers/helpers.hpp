@@ -1,17 +1,333 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
 #include <memory>
+#include <memory_resource>
+#include <new>
 #include <span>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <numbers>
+#include <type_traits>
 
 
 
 namespace helpers {
+    /// Instruction sets the SIMD kernels below can be dispatched to.
+    enum class simdIsa { scalar, sse2, avx2, avx512, neon };
+
+    /// Returns the instruction set the SIMD kernels run on. It is picked once, on
+    /// first use, from the running CPU's features. Setting TAMA_SIMD_ISA to sse2 or
+    /// avx2 caps the choice on x86-64.
+    simdIsa activeSimdIsa();
+
     double simdSum(std::span<const double> elms);
 
+    /// Advances one EMA step per lane: state[i] = alpha[i] * x[i] + oma[i] * state[i].
+    /// All spans must have the same length.
+    void simdEmaStep(std::span<double> state, std::span<const double> alpha, std::span<const double> oma, std::span<const double> x);
+
+    /// Advances one McGinley Dynamic step per lane in mdArithmetic::fast form:
+    /// state[i] += (x[i] - state[i]) * invPeriod[i] * (state[i] / x[i])^4.
+    /// All spans must have the same length.
+    void simdMdStep(std::span<double> state, std::span<const double> invPeriod, std::span<const double> x);
+
+    /// Affine prefix scan of the EMA recurrence out[t] = alpha * x[t] + oma * out[t - 1],
+    /// starting from out[-1] = carry. Samples are combined 4 (AVX2) or 2 (NEON) at a time
+    /// in registers, so only one dependent step is taken per vector.
+    /// @return The last value written, or `carry` if `x` is empty.
+    double simdEmaScan(std::span<const double> x, double alpha, double oma, double carry, std::span<double> out);
+
+    /// Rolling window sum advanced by sum[t] = sum[t - 1] + x[t] - old[t] from
+    /// sum[-1] = carry, writing scale * sum[t]. The deltas are prefix-summed 4 (AVX2)
+    /// or 2 (SSE2/NEON) at a time in registers, so only one dependent add is taken
+    /// per vector. `old` must be as long as `x`.
+    /// @return The last sum, or `carry` if `x` is empty.
+    double simdWindowScan(std::span<const double> x, std::span<const double> old, double scale, double carry, std::span<double> out);
+
+    /// The linearly weighted counterpart of simdWindowScan(): advances `sum` as above and
+    /// weightedSum[t] = weightedSum[t - 1] + period * x[t] - sum[t - 1], writing
+    /// weightedSum[t] / denominator. Both sums are prefix-summed in registers.
+    void simdWeightedWindowScan(std::span<const double> x, std::span<const double> old, double period, double denominator, double& sum, double& weightedSum, std::span<double> out);
+
+    /// Runs `depth` (1..3) cascaded EMAs over `prices` with one alpha/oma pair per lane and
+    /// writes sum_k coefficients[k * lanes + l] * ema_k to output[t * timeStride + l * laneStride].
+    /// Every stage is seeded with prices[0], like compute(). If `lastStates` is not empty it
+    /// receives the final value of stage k for lane l at lastStates[k * lanes + l]. If
+    /// `initialStates` is not empty, stages start from it (same layout) instead, and
+    /// prices[0] is applied as an ordinary step.
+    void simdEmaCascade(std::span<const double> prices, std::span<const double> alpha, std::span<const double> oma, std::span<const double> coefficients, size_t depth, std::span<double> output, size_t timeStride, size_t laneStride, std::span<double> lastStates = {}, std::span<const double> initialStates = {});
+
+    /// Walks [0, n) in blocks. For each block [start, end) it builds two prefix sums of
+    /// `term(j, k)` over [base, end), where base = start - lookback (clamped at 0) and
+    /// k = j - base, then calls `emit(start, end, base, first, second)`; window sums are
+    /// differences first[b] - first[a]. Restarting the sums every block keeps their
+    /// magnitude, and so the cancellation error, bounded on long series. The two
+    /// block buffers are taken from `scratch`.
+    template <typename Term, typename Emit>
+    void blockedPrefixSums(size_t n, size_t lookback, std::pmr::memory_resource* scratch, Term&& term, Emit&& emit) {
+        constexpr size_t block = 4096;
+
+        std::pmr::vector<double> first(block + lookback + 1, scratch);
+        std::pmr::vector<double> second(block + lookback + 1, scratch);
+
+        for (size_t start = 0; start < n; start += block) {
+            const size_t end = std::min(n, start + block);
+            const size_t base = start > lookback ? start - lookback : 0;
+
+            first[0] = 0.0;
+            second[0] = 0.0;
+            for (size_t j = base; j < end; j++) {
+                const size_t k = j - base;
+                const auto [a, b] = term(j, k);
+                first[k + 1] = first[k] + a;
+                second[k + 1] = second[k] + b;
+            }
+
+            emit(start, end, base, std::span<const double>(first), std::span<const double>(second));
+        }
+    }
+
+    /// Walks `steps` samples of `series` interleaved series in tiles of Lanes series
+    /// by Block steps. Sample t of series i is at in[t * timeStride + i * laneStride].
+    /// Each tile is gathered time-major into Lanes columns, lanes past the last series
+    /// copying the tile's first, then `kernel(tile, x, y, t0, count)` fills y row by
+    /// row and its live columns are scattered to `out` at the same positions. Kernels
+    /// thus see unit-stride rows whatever the layout. Every tile advances one block
+    /// before any moves on, so a time-major matrix is read a row segment at a time.
+    template <size_t Lanes, size_t Block, typename Kernel>
+    void forEachLaneBlock(const double* in, double* out, size_t steps, size_t timeStride, size_t laneStride, size_t series, Kernel&& kernel) {
+        alignas(64) double x[Block * Lanes];
+        alignas(64) double y[Block * Lanes];
+
+        const size_t tiles = (series + Lanes - 1) / Lanes;
+        for (size_t t0 = 0; t0 < steps; t0 += Block) {
+            const size_t count = std::min(Block, steps - t0);
+            for (size_t tile = 0; tile < tiles; tile++) {
+                const size_t width = std::min(Lanes, series - tile * Lanes);
+                const double* src = in + t0 * timeStride + tile * Lanes * laneStride;
+                double* dst = out + t0 * timeStride + tile * Lanes * laneStride;
+
+                // Walk the source in its own order so both layouts read sequentially.
+                if (laneStride == 1 && width == Lanes) {
+                    for (size_t k = 0; k < count; k++) {
+                        std::copy_n(src + k * timeStride, Lanes, x + k * Lanes);
+                    }
+                } else if (laneStride == 1) {
+                    for (size_t k = 0; k < count; k++) {
+                        for (size_t l = 0; l < width; l++) {
+                            x[k * Lanes + l] = src[k * timeStride + l];
+                        }
+                    }
+                } else {
+                    for (size_t l = 0; l < width; l++) {
+                        for (size_t k = 0; k < count; k++) {
+                            x[k * Lanes + l] = src[k * timeStride + l * laneStride];
+                        }
+                    }
+                }
+                for (size_t k = 0; k < count; k++) {
+                    for (size_t l = width; l < Lanes; l++) {
+                        x[k * Lanes + l] = x[k * Lanes];
+                    }
+                }
+
+                kernel(tile, static_cast<const double*>(x), static_cast<double*>(y), t0, count);
+
+                if (laneStride == 1 && width == Lanes) {
+                    for (size_t k = 0; k < count; k++) {
+                        std::copy_n(y + k * Lanes, Lanes, dst + k * timeStride);
+                    }
+                } else if (laneStride == 1) {
+                    for (size_t k = 0; k < count; k++) {
+                        for (size_t l = 0; l < width; l++) {
+                            dst[k * timeStride + l] = y[k * Lanes + l];
+                        }
+                    }
+                } else {
+                    for (size_t l = 0; l < width; l++) {
+                        for (size_t k = 0; k < count; k++) {
+                            dst[k * timeStride + l * laneStride] = y[k * Lanes + l];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /// 2 / ((2k + 1) ln 2): the odd series log2(m) = sum_k c[k] * s^(2k + 1) in
+    /// s = (m - 1) / (m + 1), truncated where |s| <= 0.1716 leaves it under 1e-15.
+    inline constexpr auto approxLog2Coefficients = [] {
+        std::array<double, 9> c{};
+        for (size_t k = 0; k < c.size(); k++) {
+            c[k] = 2.0 / (std::numbers::ln2 * static_cast<double>(2 * k + 1));
+        }
+        return c;
+    }();
+
+    /// ln2^k / k!: the Taylor series of 2^f, truncated where |f| <= 0.5 leaves it under 1e-16.
+    inline constexpr auto approxExp2Coefficients = [] {
+        std::array<double, 13> c{};
+        double term = 1.0;
+        for (size_t k = 0; k < c.size(); k++) {
+            c[k] = term;
+            term = term * std::numbers::ln2 / static_cast<double>(k + 1);
+        }
+        return c;
+    }();
+
+    /// log2(x) for positive, finite, normal x. The exponent is read from the bits and
+    /// the mantissa, folded into [sqrt(1/2), sqrt(2)), goes through a short odd series.
+    /// Branch free, so loops over it vectorize. Absolute error about 1e-15 plus an ulp
+    /// of the result.
+    inline double approxLog2(double x) noexcept {
+        constexpr double twoPow52 = 4503599627370496.0;
+        const uint64_t bits = std::bit_cast<uint64_t>(x);
+        // The exponent field becomes a double by OR-ing it under 2^52, which needs no
+        // integer conversion the vector units may lack.
+        double e = std::bit_cast<double>((bits >> 52) | std::bit_cast<uint64_t>(twoPow52)) - (twoPow52 + 1023.0);
+        double m = std::bit_cast<double>((bits & ((uint64_t{1} << 52) - 1)) | std::bit_cast<uint64_t>(1.0));
+        const bool fold = m > std::numbers::sqrt2;
+        m = fold ? 0.5 * m : m;
+        e = fold ? e + 1.0 : e;
+
+        const double s = (m - 1.0) / (m + 1.0);
+        const double s2 = s * s;
+        double poly = approxLog2Coefficients.back();
+        for (size_t k = approxLog2Coefficients.size() - 1; k-- > 0;) {
+            poly = poly * s2 + approxLog2Coefficients[k];
+        }
+        return e + s * poly;
+    }
+
+    /// 2^y, with y clamped to [-1022, 1023] so the result stays normal. y is split
+    /// into the nearest integer n, applied through the exponent bits, and f in
+    /// [-0.5, 0.5], applied by a polynomial. Branch free; relative error about 2e-16.
+    /// NaN stays NaN.
+    inline double approxExp2(double y) noexcept {
+        // Adding 1.5 * 2^52 rounds y to an integer held in the low mantissa bits.
+        constexpr double shifter = 6755399441055744.0;
+        y = std::clamp(y, -1022.0, 1023.0);
+        const double shifted = y + shifter;
+        const double f = y - (shifted - shifter);
+
+        double poly = approxExp2Coefficients.back();
+        for (size_t k = approxExp2Coefficients.size() - 1; k-- > 0;) {
+            poly = poly * f + approxExp2Coefficients[k];
+        }
+        return std::bit_cast<double>((std::bit_cast<uint64_t>(shifted) + 1023) << 52) * poly;
+    }
+
+    /// Allocator returning storage aligned to `Alignment` bytes (one cache line by default).
+    template <typename T, size_t Alignment = 64>
+    struct AlignedAllocator {
+        using value_type = T;
+
+        template <typename U>
+        struct rebind {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() noexcept = default;
+
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+        T* allocate(size_t n) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+        }
+
+        void deallocate(T* p, size_t) noexcept {
+            ::operator delete(p, std::align_val_t(Alignment));
+        }
+
+        template <typename U>
+        bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept {
+            return true;
+        }
+    };
+
+    template <typename T>
+    using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+    /// Interleaved sliding-window storage for many lanes that share one period.
+    /// Slots are stored column by column; each column holds one value per lane and
+    /// starts on a cache line, so a whole column can be swept with aligned SIMD loads.
+    template <typename T>
+    class WindowSlab {
+    private:
+        size_t slots;
+        size_t lanes;
+        size_t laneStride;
+        size_t headIdx{0};
+        size_t count{0};
+        AlignedVector<T> buf;
+
+    public:
+        WindowSlab(size_t slots, size_t lanes)
+            : slots(slots),
+              lanes(lanes),
+              laneStride((lanes + 64 / sizeof(T) - 1) / (64 / sizeof(T)) * (64 / sizeof(T))),
+              buf(slots * laneStride, T{}) {
+            if (slots == 0 || lanes == 0) {
+                throw std::invalid_argument("invalid size");
+            }
+        }
+
+        /// Column that the next advance() commits: the oldest slot once full.
+        T* next() {
+            return buf.data() + (count < slots ? count : headIdx) * laneStride;
+        }
+
+        void advance() {
+            if (count < slots) {
+                count++;
+            } else {
+                headIdx++;
+                if (headIdx >= slots) {
+                    headIdx = 0;
+                }
+            }
+        }
+
+        /// Value `i` slots after the oldest one for `lane`.
+        T at(size_t i, size_t lane) const {
+            if (i >= count || lane >= lanes) {
+                throw std::out_of_range("index out of range");
+            }
+
+            size_t idx = headIdx + i;
+            if (idx >= slots) {
+                idx -= slots;
+            }
+            return buf[idx * laneStride + lane];
+        }
+
+        size_t len() const {
+            return count;
+        }
+
+        size_t cap() const {
+            return slots;
+        }
+
+        size_t width() const {
+            return lanes;
+        }
+
+        bool full() const {
+            return count == slots;
+        }
+    };
+
     template <typename T>
     class RingBuffer {
     private:
@@ -96,4 +412,429 @@ namespace helpers {
     };
 
 
+    /// Non-owning view of a ring buffer's live window, oldest first, as up to three
+    /// contiguous runs (a ring that shares its older samples after share() has one
+    /// more than a plain one). Valid until the buffer is next modified.
+    template <typename T>
+    struct RingView {
+        std::array<std::span<const T>, 3> runs;
+
+        size_t size() const noexcept {
+            return runs[0].size() + runs[1].size() + runs[2].size();
+        }
+
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        const T& operator[](size_t i) const noexcept {
+            if (i < runs[0].size()) {
+                return runs[0][i];
+            }
+            i -= runs[0].size();
+            return i < runs[1].size() ? runs[1][i] : runs[2][i - runs[1].size()];
+        }
+
+        /// Replaces the contents of `out`, reusing its capacity.
+        void assignTo(std::vector<T>& out) const {
+            out.clear();
+            for (const std::span<const T>& run : runs) {
+                out.insert(out.end(), run.begin(), run.end());
+            }
+        }
+
+        /// Copies the window to `out` and returns the byte past the last one written.
+        std::byte* copyTo(std::byte* out) const noexcept {
+            for (const std::span<const T>& run : runs) {
+                std::memcpy(out, run.data(), run.size_bytes());
+                out += run.size_bytes();
+            }
+            return out;
+        }
+    };
+
+    /// Fixed-capacity ring buffer for the per-tick update path.
+    /// Storage is allocated once, cache-line aligned, and rounded up to a power of
+    /// two so indexing is a mask. `period` is the logical window length. Accessors
+    /// are unchecked; callers validate indices and emptiness.
+    ///
+    /// share() hands the window over to immutable storage that copies of the ring
+    /// hold by reference, so a copy taken afterwards costs O(1). Each copy then
+    /// reads the samples it inherited from there and keeps only its own inserts
+    /// until the inherited ones leave the window: the first few inside the object,
+    /// the rest in heap storage that grows with them.
+    template <typename T>
+    class FixedRingBuffer {
+        static_assert(std::is_trivially_copyable_v<T>, "FixedRingBuffer copies elements with memcpy");
+
+    private:
+        size_t period;
+        size_t mask;
+        size_t tail{0};     // total number of inserts; the next write goes to tail & mask
+        AlignedVector<T> buf;
+        size_t count{0};
+
+        // Inherited samples: the oldest `borrowed` of the window, at slots
+        // sharedHead & mask onwards of `shared`. While any are left, own inserts
+        // start over at tail 0 and sit unwrapped in ownData()[0, tail), which is
+        // `local` until they outgrow it and `buf` after.
+        size_t borrowed{0};
+        size_t sharedHead{0};
+        std::shared_ptr<const AlignedVector<T>> shared;
+        std::array<T, 128 / sizeof(T)> local{};
+
+        size_t start() const noexcept {
+            return (tail - count) & mask;
+        }
+
+        const T& inherited(size_t i) const noexcept {
+            return (*shared)[(sharedHead + i) & mask];
+        }
+
+        T* ownData() noexcept {
+            return buf.empty() ? local.data() : buf.data();
+        }
+
+        const T* ownData() const noexcept {
+            return buf.empty() ? local.data() : buf.data();
+        }
+
+        // Moves own samples to `buf`, sized to at least `size` slots.
+        void spill(size_t size) {
+            if (buf.empty()) {
+                buf.resize(size);
+                std::memcpy(buf.data(), local.data(), tail * sizeof(T));
+            } else if (buf.size() < size) {
+                buf.resize(size);
+            }
+        }
+
+        void pushOwn(const T& val) {
+            const size_t room = buf.empty() ? local.size() : buf.size();
+            if (tail == room) {
+                spill(std::min(mask + 1, 2 * room));
+            }
+            ownData()[tail] = val;
+            tail++;
+        }
+
+        // Drops the inherited samples once none is left in the window.
+        void releaseShared() {
+            if (borrowed == 0) {
+                shared.reset();
+                spill(mask + 1);
+            }
+        }
+
+        // Out of line so that the plain ring's update path stays small.
+        [[gnu::noinline]] void insertShared(T val) {
+            pushOwn(val);
+            if (count < period) {
+                count++;
+            } else {
+                sharedHead++;
+                borrowed--;
+                releaseShared();
+            }
+        }
+
+        [[gnu::noinline]] void replaceShared(T val) {
+            if (count > borrowed) {
+                ownData()[tail - 1] = val;
+                return;
+            }
+            // The newest sample is inherited: it becomes the first own one.
+            pushOwn(val);
+            borrowed--;
+            releaseShared();
+        }
+
+        // Copies the inherited samples into own storage, in front of the own ones.
+        void gather() {
+            spill(mask + 1);
+            for (size_t i = 0; i < borrowed; i++) {
+                buf[(tail - count + i) & mask] = inherited(i);
+            }
+            borrowed = 0;
+            shared.reset();
+        }
+
+    public:
+        FixedRingBuffer(size_t size)
+            : period(size > 0 ? size : 1),
+              mask(std::bit_ceil(size > 0 ? size : 1) - 1),
+              buf(mask + 1) {}
+
+        const T& head() const noexcept {
+            if (borrowed > 0) [[unlikely]] {
+                return inherited(0);
+            }
+            return buf[start()];
+        }
+
+        const T& back() const noexcept {
+            if (borrowed > 0) [[unlikely]] {
+                return count == borrowed ? inherited(borrowed - 1) : ownData()[tail - 1];
+            }
+            return buf[(tail - 1) & mask];
+        }
+
+        const T& operator[](size_t i) const noexcept {
+            if (borrowed > 0) [[unlikely]] {
+                return i < borrowed ? inherited(i) : ownData()[i - borrowed];
+            }
+            return buf[(tail - count + i) & mask];
+        }
+
+        /// Overwrites the newest element in place; the ring must not be empty.
+        void replaceBack(const T& val) {
+            if (borrowed > 0) [[unlikely]] {
+                replaceShared(val);
+                return;
+            }
+            buf[(tail - 1) & mask] = val;
+        }
+
+        void insert(const T& val) {
+            if (borrowed > 0) [[unlikely]] {
+                insertShared(val);
+                return;
+            }
+            buf[tail & mask] = val;
+            tail++;
+            count += count < period;
+        }
+
+        /// Appends `vals` with at most two memcpy calls. Only the last `period`
+        /// values can survive, so longer inputs are trimmed first.
+        void insert(std::span<const T> vals) {
+            if (vals.empty()) {
+                return;
+            }
+            if (vals.size() >= period) {
+                vals = vals.subspan(vals.size() - period);
+                clear();
+            }
+            if (borrowed > 0) {
+                gather();
+            }
+
+            const size_t n = vals.size();
+            const size_t at = tail & mask;
+            const size_t first = std::min(n, mask + 1 - at);
+            std::memcpy(buf.data() + at, vals.data(), first * sizeof(T));
+            std::memcpy(buf.data(), vals.data() + first, (n - first) * sizeof(T));
+
+            tail += n;
+            count = std::min(count + n, period);
+        }
+
+        void insert(const std::vector<T>& vals) {
+            insert(std::span<const T>(vals));
+        }
+
+        /// Moves the window into storage that copies of this ring share, so that
+        /// copying the ring afterwards is O(1). Free if the ring has taken no own
+        /// inserts since it last shared or inherited; otherwise the inherited
+        /// samples still in the window are gathered first.
+        void share() {
+            if (borrowed > 0) {
+                if (count == borrowed) {
+                    return;
+                }
+                gather();
+            }
+            if (count == 0) {
+                return;
+            }
+
+            borrowed = count;
+            sharedHead = tail - count;
+            tail = 0;
+            shared = std::make_shared<const AlignedVector<T>>(std::move(buf));
+            buf = AlignedVector<T>();
+        }
+
+        /// The live window, oldest first, as up to two contiguous runs. Only for a
+        /// ring that holds its whole window itself; view() covers every ring.
+        std::pair<std::span<const T>, std::span<const T>> spans() const noexcept {
+            const size_t at = start();
+            const size_t first = std::min(count, mask + 1 - at);
+            return {std::span<const T>(buf.data() + at, first), std::span<const T>(buf.data(), count - first)};
+        }
+
+        RingView<T> view() const noexcept {
+            if (borrowed > 0) {
+                const size_t at = sharedHead & mask;
+                const size_t first = std::min(borrowed, mask + 1 - at);
+                return {{std::span<const T>(shared->data() + at, first),
+                         std::span<const T>(shared->data(), borrowed - first),
+                         std::span<const T>(ownData(), count - borrowed)}};
+            }
+            const auto [older, newer] = spans();
+            return {{older, newer, std::span<const T>()}};
+        }
+
+        void clear() {
+            tail = 0;
+            count = 0;
+            if (borrowed > 0) {
+                borrowed = 0;
+                releaseShared();
+            }
+        }
+
+        size_t len() const noexcept {
+            return count;
+        }
+
+        size_t cap() const noexcept {
+            return period;
+        }
+
+        bool empty() const noexcept {
+            return count == 0;
+        }
+
+        /// Whether some of the window still lives in storage shared with other rings.
+        bool sharing() const noexcept {
+            return borrowed > 0;
+        }
+    };
+
+    // Packed snapshots are a trivially copyable header followed by ring windows
+    // as raw doubles, oldest first and back to back. The layout is that of the
+    // host; it is meant for memcpy'ing checkpoints, not for exchange across ABIs.
+
+    template <typename Header>
+    constexpr size_t packedSize(size_t values) noexcept {
+        static_assert(std::is_trivially_copyable_v<Header>, "snapshot headers are copied with memcpy");
+        return sizeof(Header) + values * sizeof(double);
+    }
+
+    /// Writes `header` then each window; `out` must hold packedSize() bytes.
+    template <typename Header>
+    void packSnapshot(std::byte* out, const Header& header, std::initializer_list<RingView<double>> windows) noexcept {
+        static_assert(std::is_trivially_copyable_v<Header>, "snapshot headers are copied with memcpy");
+        std::memcpy(out, &header, sizeof(Header));
+        out += sizeof(Header);
+        for (const RingView<double>& window : windows) {
+            out = window.copyTo(out);
+        }
+    }
+
+    template <typename Header>
+    Header unpackHeader(std::span<const std::byte> packed) {
+        static_assert(std::is_trivially_copyable_v<Header>, "snapshot headers are copied with memcpy");
+        if (packed.size() < sizeof(Header)) {
+            throw std::invalid_argument("packed snapshot is truncated");
+        }
+        Header header;
+        std::memcpy(&header, packed.data(), sizeof(Header));
+        return header;
+    }
+
+    /// Reads `count` doubles at byte `offset` and advances `offset` past them.
+    inline std::vector<double> unpackValues(std::span<const std::byte> packed, size_t& offset, size_t count) {
+        if (count > (packed.size() - offset) / sizeof(double)) {
+            throw std::invalid_argument("packed snapshot is truncated");
+        }
+        std::vector<double> values(count);
+        if (count > 0) {
+            std::memcpy(values.data(), packed.data() + offset, count * sizeof(double));
+        }
+        offset += count * sizeof(double);
+        return values;
+    }
+
+    /// Sliding-window extremum over the last `window` pushed values.
+    /// Keeps only candidates that can still become the extremum, so push() is
+    /// amortized O(1) and front() is O(1). `Better` is std::greater<T> for a
+    /// running max and std::less<T> for a running min.
+    template <typename T, typename Better>
+    class MonotonicDeque {
+    private:
+        struct Entry {
+            uint64_t seq;
+            T value;
+        };
+
+        size_t window;
+        size_t headIdx{0};
+        size_t count{0};
+        uint64_t nextSeq{0};
+        std::vector<Entry> buf;
+        Better better;
+
+        size_t slot(size_t i) const {
+            size_t idx = headIdx + i;
+            if (idx >= window) {
+                idx -= window;
+            }
+            return idx;
+        }
+
+    public:
+        MonotonicDeque(size_t window) : window(window) {
+            if (window == 0) {
+                throw std::invalid_argument("invalid size");
+            }
+
+            buf.resize(window);
+        }
+
+        void push(const T& val) {
+            // The entry leaving the window can only be at the front; at most one expires per push.
+            if (count > 0 && buf[headIdx].seq + window <= nextSeq) {
+                headIdx = slot(1);
+                count--;
+            }
+
+            while (count > 0 && !better(buf[slot(count - 1)].value, val)) {
+                count--;
+            }
+
+            buf[slot(count)] = {nextSeq, val};
+            count++;
+            nextSeq++;
+        }
+
+        /// Replaces the newest value, which is always the last entry, by `val`.
+        /// `val` must be at least as good as the value it replaces: a worse one could
+        /// revive older entries that the newest value already evicted, so callers
+        /// rebuild the deque from their window in that case.
+        void replaceBack(const T& val) {
+            count--;
+            nextSeq--;
+            push(val);
+        }
+
+        void insert(std::span<const T> vals) {
+            for (const auto& val : vals) {
+                push(val);
+            }
+        }
+
+        T front() const {
+            if (count == 0) {
+                throw std::runtime_error("buffer is empty");
+            }
+            return buf[headIdx].value;
+        }
+
+        void clear() {
+            headIdx = 0;
+            count = 0;
+            nextSeq = 0;
+        }
+
+        size_t len() const {
+            return count;
+        }
+
+        bool empty() const {
+            return count == 0;
+        }
+    };
+
 } // namespace helpers
@@ -0,0 +1,481 @@
+#pragma once
+
+// Per-tick hot paths of the stateful indicators. Included at the end of
+// tama.hpp when TAMA_HEADER_INLINE is defined, and compiled out of line by
+// src/tama/inline.cpp otherwise; never include it directly.
+
+#include <cmath>
+
+#ifdef TAMA_HEADER_INLINE
+#define TAMA_HOT inline
+#else
+#define TAMA_HOT
+#endif
+
+namespace tama {
+    TAMA_HOT double ExponentialMovingAverage::step(double price) noexcept {
+        this->prevEma = this->lastEma;
+        this->hasPrevEma = true;
+        this->newestSeeded = false;
+        this->lastEma = this->alpha * price + this->oma * this->lastEma;
+        return this->lastEma;
+    }
+
+    TAMA_HOT double ExponentialMovingAverage::amendStep(double price) {
+        if (this->newestSeeded) [[unlikely]] {
+            this->lastEma = price;
+            return price;
+        }
+        if (!this->hasPrevEma) [[unlikely]] {
+            detail::throwNotAmendable("ema");
+        }
+        this->lastEma = this->prevEma;
+        return this->step(price);
+    }
+
+    TAMA_HOT double ExponentialMovingAverage::peekStep(double price) const noexcept {
+        return this->alpha * price + this->oma * this->lastEma;
+    }
+
+    TAMA_HOT double ExponentialMovingAverage::update(double price) {
+        if (!this->initalized) [[unlikely]] {
+            detail::throwNotInitialized("ema");
+        }
+        return this->step(price);
+    }
+
+    TAMA_HOT double ExponentialMovingAverage::amend(double price) {
+        if (!this->initalized) [[unlikely]] {
+            detail::throwNotInitialized("ema");
+        }
+        return this->amendStep(price);
+    }
+
+    TAMA_HOT double ExponentialMovingAverage::peek(double price) const {
+        if (!this->initalized) [[unlikely]] {
+            detail::throwNotInitialized("ema");
+        }
+        return this->peekStep(price);
+    }
+
+    TAMA_HOT double ExponentialMovingAverage::latest() const noexcept {
+        return this->lastEma;
+    }
+
+    TAMA_HOT double SimpleMovingAverage::update(double price) {
+        if (!this->initalized) [[unlikely]] {
+            detail::throwNotInitialized("sma");
+        }
+
+        this->rollingSum -= this->priceBuf.head();
+        this->rollingSum += price;
+        this->priceBuf.insert(price);
+
+        this->lastSma = this->alpha * this->rollingSum;
+        return this->lastSma;
+    }
+
+    TAMA_HOT double SimpleMovingAverage::amend(double price) {
+        if (!this->initalized) [[unlikely]] {
+            detail::throwNotInitialized("sma");
+        }
+
+        this->rollingSum += price - this->priceBuf.back();
+        this->priceBuf.replaceBack(price);
+
+        this->lastSma = this->alpha * this->rollingSum;
+        return this->lastSma;
+    }
+
+    TAMA_HOT double SimpleMovingAverage::peek(double price) const {
+        if (!this->initalized) [[unlikely]] {
+            detail::throwNotInitialized("sma");
+        }
+        return this->alpha * (this->rollingSum - this->priceBuf.head() + price);
+    }
+
+    TAMA_HOT double SimpleMovingAverage::latest() const noexcept {
+        return this->lastSma;
+    }
+
+    TAMA_HOT double WeightedMovingAverage::step(double price) {
+        const double oldSum = this->rollingSum;
+
+        this->rollingWeightedSum = this->rollingWeightedSum - oldSum + (price * this->period);
+        this->rollingSum = oldSum - this->priceBuf.head() + price;
+
+        this->priceBuf.insert(price);
+
+        this->lastWma = this->rollingWeightedSum / this->denominator;
+        return this->lastWma;
+    }
+
+    TAMA_HOT double WeightedMovingAverage::amendStep(double price) {
+        const double delta = price - this->priceBuf.back();
+
+        this->rollingWeightedSum += delta * this->period;
+        this->rollingSum += delta;
+        this->priceBuf.replaceBack(price);
+
+        this->lastWma = this->rollingWeightedSum / this->denominator;
+        return this->lastWma;
+    }
+
+    TAMA_HOT double WeightedMovingAverage::peekStep(double price) const noexcept {
+        return (this->rollingWeightedSum - this->rollingSum + (price * this->period)) / this->denominator;
+    }
+
+    TAMA_HOT double WeightedMovingAverage::update(double price) {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("wma");
+        }
+        return this->step(price);
+    }
+
+    TAMA_HOT double WeightedMovingAverage::amend(double price) {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("wma");
+        }
+        return this->amendStep(price);
+    }
+
+    TAMA_HOT double WeightedMovingAverage::peek(double price) const {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("wma");
+        }
+        return this->peekStep(price);
+    }
+
+    TAMA_HOT double WeightedMovingAverage::latest() const noexcept {
+        return this->lastWma;
+    }
+
+    TAMA_HOT double VolumeWeightedMovingAverage::update(double price, double volume) {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("vwma");
+        }
+
+        this->rollingNumerator -= this->priceBuf.head() * this->volumeBuf.head();
+        this->rollingNumerator += price * volume;
+
+        this->rollingDenominator -= this->volumeBuf.head();
+        this->rollingDenominator += volume;
+
+        this->priceBuf.insert(price);
+        this->volumeBuf.insert(volume);
+
+        this->lastCalculation = this->rollingNumerator / this->rollingDenominator;
+        return this->lastCalculation;
+    }
+
+    TAMA_HOT double VolumeWeightedMovingAverage::amend(double price, double volume) {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("vwma");
+        }
+
+        this->rollingNumerator += price * volume - this->priceBuf.back() * this->volumeBuf.back();
+        this->rollingDenominator += volume - this->volumeBuf.back();
+
+        this->priceBuf.replaceBack(price);
+        this->volumeBuf.replaceBack(volume);
+
+        this->lastCalculation = this->rollingNumerator / this->rollingDenominator;
+        return this->lastCalculation;
+    }
+
+    TAMA_HOT double VolumeWeightedMovingAverage::peek(double price, double volume) const {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("vwma");
+        }
+
+        const double numerator = this->rollingNumerator - this->priceBuf.head() * this->volumeBuf.head() + price * volume;
+        const double denominator = this->rollingDenominator - this->volumeBuf.head() + volume;
+        return numerator / denominator;
+    }
+
+    TAMA_HOT double VolumeWeightedMovingAverage::latest() const noexcept {
+        return this->lastCalculation;
+    }
+
+    TAMA_HOT double HullMovingAverage::update(double price) {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("hma");
+        }
+
+        const double w1 = this->w1.step(price);
+        const double w2 = this->w2.step(price);
+
+        this->lastHull = this->w3.step(2 * w1 - w2);
+        return this->lastHull;
+    }
+
+    TAMA_HOT double HullMovingAverage::amend(double price) {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("hma");
+        }
+
+        const double w1 = this->w1.amendStep(price);
+        const double w2 = this->w2.amendStep(price);
+
+        this->lastHull = this->w3.amendStep(2 * w1 - w2);
+        return this->lastHull;
+    }
+
+    TAMA_HOT double HullMovingAverage::peek(double price) const {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("hma");
+        }
+        return this->w3.peekStep(2 * this->w1.peekStep(price) - this->w2.peekStep(price));
+    }
+
+    TAMA_HOT double HullMovingAverage::latest() const noexcept {
+        return this->lastHull;
+    }
+
+    TAMA_HOT double DoubleExponentialMovingAverage::update(double price) {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("dema");
+        }
+
+        const double ema1Value = this->ema1.step(price);
+        const double ema2Value = this->ema2.step(ema1Value);
+
+        this->lastDema = 2.0 * ema1Value - ema2Value;
+        return this->lastDema;
+    }
+
+    TAMA_HOT double DoubleExponentialMovingAverage::amend(double price) {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("dema");
+        }
+
+        const double ema1Value = this->ema1.amendStep(price);
+        const double ema2Value = this->ema2.amendStep(ema1Value);
+
+        this->lastDema = 2.0 * ema1Value - ema2Value;
+        return this->lastDema;
+    }
+
+    TAMA_HOT double DoubleExponentialMovingAverage::peek(double price) const {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("dema");
+        }
+
+        const double ema1Value = this->ema1.peekStep(price);
+        return 2.0 * ema1Value - this->ema2.peekStep(ema1Value);
+    }
+
+    TAMA_HOT double DoubleExponentialMovingAverage::latest() const noexcept {
+        return this->lastDema;
+    }
+
+    TAMA_HOT double TripleExponentialMovingAverage::update(double price) {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("tema");
+        }
+
+        const double ema1Value = this->ema1.step(price);
+        const double ema2Value = this->ema2.step(ema1Value);
+        const double ema3Value = this->ema3.step(ema2Value);
+
+        this->lastTema = 3.0 * ema1Value - 3.0 * ema2Value + ema3Value;
+        return this->lastTema;
+    }
+
+    TAMA_HOT double TripleExponentialMovingAverage::amend(double price) {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("tema");
+        }
+
+        const double ema1Value = this->ema1.amendStep(price);
+        const double ema2Value = this->ema2.amendStep(ema1Value);
+        const double ema3Value = this->ema3.amendStep(ema2Value);
+
+        this->lastTema = 3.0 * ema1Value - 3.0 * ema2Value + ema3Value;
+        return this->lastTema;
+    }
+
+    TAMA_HOT double TripleExponentialMovingAverage::peek(double price) const {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("tema");
+        }
+
+        const double ema1Value = this->ema1.peekStep(price);
+        const double ema2Value = this->ema2.peekStep(ema1Value);
+        return 3.0 * ema1Value - 3.0 * ema2Value + this->ema3.peekStep(ema2Value);
+    }
+
+    TAMA_HOT double TripleExponentialMovingAverage::latest() const noexcept {
+        return this->lastTema;
+    }
+
+    TAMA_HOT double McGinleyDynamicMovingAverage::step(double mt, double price) const {
+        const double period = static_cast<double>(this->period);
+        if (this->arithmetic == mdArithmetic::fast) {
+            return detail::mdStep<mdArithmetic::fast>(mt, price, period, this->invPeriod);
+        }
+        return detail::mdStep<mdArithmetic::exact>(mt, price, period, this->invPeriod);
+    }
+
+    TAMA_HOT double McGinleyDynamicMovingAverage::update(double price) {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("md");
+        }
+
+        this->prevMd = this->lastMd;
+        this->hasPrevMd = true;
+        this->newestSeeded = false;
+        this->lastMd = this->step(this->lastMd, price);
+        return this->lastMd;
+    }
+
+    TAMA_HOT double McGinleyDynamicMovingAverage::amend(double price) {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("md");
+        }
+        if (this->newestSeeded) [[unlikely]] {
+            this->lastMd = price;
+            return price;
+        }
+        if (!this->hasPrevMd) [[unlikely]] {
+            detail::throwNotAmendable("md");
+        }
+
+        this->lastMd = this->prevMd;
+        return this->update(price);
+    }
+
+    TAMA_HOT double McGinleyDynamicMovingAverage::peek(double price) const {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("md");
+        }
+
+        return this->step(this->lastMd, price);
+    }
+
+    TAMA_HOT double McGinleyDynamicMovingAverage::latest() const noexcept {
+        return this->lastMd;
+    }
+
+    TAMA_HOT double FractalAdaptiveMovingAverage::update(double close, double low, double high) {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("frama");
+        }
+
+        const double alpha = this->nextAlpha();
+        const double out = alpha * close + (1 - alpha) * this->lastFrama;
+
+        this->slide(high, low);
+
+        this->prevFrama = this->lastFrama;
+        this->lastAlpha = alpha;
+        this->hasPrevFrama = true;
+        this->lastFrama = out;
+        return out;
+    }
+
+    TAMA_HOT double FractalAdaptiveMovingAverage::amend(double close, double low, double high) {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("frama");
+        }
+        if (!this->hasPrevFrama) [[unlikely]] {
+            detail::throwNotAmendable("frama");
+        }
+
+        this->replaceNewest(high, low);
+
+        this->lastFrama = this->lastAlpha * close + (1 - this->lastAlpha) * this->prevFrama;
+        return this->lastFrama;
+    }
+
+    TAMA_HOT double FractalAdaptiveMovingAverage::windowRatio() const noexcept {
+        const double fullWindowHigh = this->highBuf1Max > this->highBuf2Max ? this->highBuf1Max : this->highBuf2Max;
+        const double fullWindowLow = this->lowBuf1min < this->lowBuf2min ? this->lowBuf1min : this->lowBuf2min;
+
+        const double l1 = (this->highBuf1Max - this->lowBuf1min) / this->halfPeriod;
+        const double l2 = (this->highBuf2Max - this->lowBuf2min) / this->halfPeriod;
+        const double l3 = (fullWindowHigh - fullWindowLow) / this->period;
+        return (l1 + l2) / l3;
+    }
+
+    TAMA_HOT double FractalAdaptiveMovingAverage::nextAlpha() const noexcept {
+        if (this->arithmetic == framaArithmetic::approximate) {
+            return detail::framaAlpha<framaArithmetic::approximate>(this->windowRatio(), this->eulerNumber, this->logTwo);
+        }
+        return detail::framaAlpha<framaArithmetic::exact>(this->windowRatio(), this->eulerNumber, this->logTwo);
+    }
+
+    TAMA_HOT double FractalAdaptiveMovingAverage::peek(double close) const {
+        if (!this->initialized) [[unlikely]] {
+            detail::throwNotInitialized("frama");
+        }
+
+        const double alpha = this->nextAlpha();
+        return alpha * close + (1 - alpha) * this->lastFrama;
+    }
+
+    TAMA_HOT void FractalAdaptiveMovingAverage::slide(double high, double low) {
+        // The oldest sample of the second half moves into the first half.
+        const double hb2_head = this->highBuf2.head();
+        const double lb2_head = this->lowBuf2.head();
+
+        this->highBuf1.insert(hb2_head);
+        this->highMax1.push(hb2_head);
+        this->highBuf1Max = this->highMax1.front();
+
+        this->highBuf2.insert(high);
+        this->highMax2.push(high);
+        this->highBuf2Max = this->highMax2.front();
+
+        this->lowBuf1.insert(lb2_head);
+        this->lowMin1.push(lb2_head);
+        this->lowBuf1min = this->lowMin1.front();
+
+        this->lowBuf2.insert(low);
+        this->lowMin2.push(low);
+        this->lowBuf2min = this->lowMin2.front();
+    }
+
+    TAMA_HOT double FractalAdaptiveMovingAverage::latest() const noexcept {
+        return this->lastFrama;
+    }
+
+    TAMA_HOT double GeneralizedDoubleExponentialMovingAverage::update(double price) {
+        if (!this->emaBuf1.initalized || !this->emaBuf2.initalized) [[unlikely]] {
+            detail::throwNotInitialized("ema");
+        }
+
+        const double ema1res = this->emaBuf1.step(price);
+        const double ema2res = this->emaBuf2.step(ema1res);
+
+        this->lastGd = this->onePlusPeriod * ema1res - this->period * ema2res;
+        return this->lastGd;
+    }
+
+    TAMA_HOT double GeneralizedDoubleExponentialMovingAverage::amend(double price) {
+        if (!this->emaBuf1.initalized || !this->emaBuf2.initalized) [[unlikely]] {
+            detail::throwNotInitialized("ema");
+        }
+
+        const double ema1res = this->emaBuf1.amendStep(price);
+        const double ema2res = this->emaBuf2.amendStep(ema1res);
+
+        this->lastGd = this->onePlusPeriod * ema1res - this->period * ema2res;
+        return this->lastGd;
+    }
+
+    TAMA_HOT double GeneralizedDoubleExponentialMovingAverage::peek(double price) const {
+        if (!this->emaBuf1.initalized || !this->emaBuf2.initalized) [[unlikely]] {
+            detail::throwNotInitialized("ema");
+        }
+
+        const double ema1res = this->emaBuf1.peekStep(price);
+        return this->onePlusPeriod * ema1res - this->period * this->emaBuf2.peekStep(ema1res);
+    }
+
+    TAMA_HOT double GeneralizedDoubleExponentialMovingAverage::latest() const noexcept {
+        return this->lastGd;
+    }
+}
+
+#undef TAMA_HOT
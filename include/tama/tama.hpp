@@ -1,4 +1,10 @@
+#include <array>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <memory_resource>
+#include <numbers>
+#include <stdexcept>
 #include <vector>
 #include <span>
 #include <helpers/helpers.hpp>
@@ -10,11 +16,70 @@ enum class status : uint8_t {
     invalidParam
 };
 
+/// Memory layout of multi-period (sweep) outputs.
+/// periodMajor: row k holds the whole series for periods[k].
+/// timeMajor: row t holds the value of every period at time t.
+enum class sweepLayout : uint8_t {
+    periodMajor,
+    timeMajor
+};
+
+/// Memory layout of computePaths() inputs and outputs.
+/// pathMajor: row p holds the whole series of path p.
+/// timeMajor: row t holds the value of every path at time t.
+enum class pathLayout : uint8_t {
+    pathMajor,
+    timeMajor
+};
+
+/// Evaluation strategy for ExponentialMovingAverage::computeScan().
+/// simd: in-register affine prefix scan over a few samples per step.
+/// threaded: chunks scanned in parallel from a zero carry, carries combined, then fixed up.
+enum class scanMode : uint8_t {
+    simd,
+    threaded
+};
+
+/// How compute() treats an indicator that is already initialized.
+/// restart: seed from the first sample, discarding the previous state.
+/// resume: treat the input as the samples following the previous compute() call, so a
+/// series fed in chunks yields the same bytes as one compute() over all of it. On an
+/// uninitialized indicator, resume behaves like restart.
+enum class computeMode : uint8_t {
+    restart,
+    resume
+};
+
+/// Arithmetic of the McGinley Dynamic step.
+/// exact: std::pow and two divisions, bit for bit what earlier releases computed.
+/// fast: (mt / price)^4 by two squarings and multiplies by 1/price and 1/period; the
+/// only division does not depend on the previous value, so it stays off the
+/// recurrence. Stays within 1e-12 relative of exact.
+enum class mdArithmetic : uint8_t {
+    exact,
+    fast
+};
+
+/// Arithmetic of FractalAdaptiveMovingAverage's smoothing factor.
+/// exact: std::log and std::exp, bit for bit what earlier releases computed.
+/// approximate: the branch-free helpers::approxLog2 and helpers::approxExp2, which
+/// vectorize. Alpha stays within 1e-13 relative of exact for |eulerNumber| <= 10.
+enum class framaArithmetic : uint8_t {
+    exact,
+    approximate
+};
+
 struct ExponentialMovingAverageState {
     double lastEma{0.0};
     double period;
     double alpha;
     double oma;
+    /// Value before the newest sample, which amend() steps from again. Without
+    /// hasPrevEma or newestSeeded, amend() on the restored EMA throws.
+    double prevEma{0.0};
+    bool hasPrevEma{false};
+    /// The newest sample seeded the EMA, so amend() re-seeds.
+    bool newestSeeded{false};
 };
 
 struct SimpleMovingAverageState {
@@ -26,6 +91,27 @@ struct SimpleMovingAverageState {
     std::vector<double> priceBuf;
 };
 
+/// SimpleMovingAverageState without the copy; the window is a view into the
+/// indicator and is valid until it is next updated.
+struct SimpleMovingAverageStateView {
+    double alpha{0.0};
+    size_t period{0};
+    double rollingSum{0.0};
+    bool initialized{false};
+    double lastSma{0.0};
+    helpers::RingView<double> priceBuf;
+};
+
+/// Fixed-layout header of SimpleMovingAverage::pack(); followed by priceCount doubles.
+struct SimpleMovingAverageSnapshot {
+    uint64_t period;
+    uint64_t initialized;
+    uint64_t priceCount;
+    double alpha;
+    double rollingSum;
+    double lastSma;
+};
+
 struct WeightedMovingAverageState {
     size_t period{0};
     double denominator{0.0};
@@ -36,6 +122,27 @@ struct WeightedMovingAverageState {
     std::vector<double> priceBuf;
 };
 
+struct WeightedMovingAverageStateView {
+    size_t period{0};
+    double denominator{0.0};
+    double rollingSum{0.0};
+    double rollingWeightedSum{0.0};
+    bool initialized{false};
+    double lastWma{0.0};
+    helpers::RingView<double> priceBuf;
+};
+
+/// Fixed-layout header of WeightedMovingAverage::pack(); followed by priceCount doubles.
+struct WeightedMovingAverageSnapshot {
+    uint64_t period;
+    uint64_t initialized;
+    uint64_t priceCount;
+    double denominator;
+    double rollingSum;
+    double rollingWeightedSum;
+    double lastWma;
+};
+
 struct VolumeWeightedMovingAverageState {
     size_t period{0};
     bool initialized{false};
@@ -46,6 +153,28 @@ struct VolumeWeightedMovingAverageState {
     std::vector<double> volumeBuf;
 };
 
+struct VolumeWeightedMovingAverageStateView {
+    size_t period{0};
+    bool initialized{false};
+    double rollingNumerator{0.0};
+    double rollingDenominator{0.0};
+    double lastCalculation{0.0};
+    helpers::RingView<double> priceBuf;
+    helpers::RingView<double> volumeBuf;
+};
+
+/// Fixed-layout header of VolumeWeightedMovingAverage::pack(); followed by
+/// priceCount prices, then volumeCount volumes.
+struct VolumeWeightedMovingAverageSnapshot {
+    uint64_t period;
+    uint64_t initialized;
+    uint64_t priceCount;
+    uint64_t volumeCount;
+    double rollingNumerator;
+    double rollingDenominator;
+    double lastCalculation;
+};
+
 struct HullMovingAverageState {
     uint16_t p1{0};
     uint16_t p2{0};
@@ -57,6 +186,30 @@ struct HullMovingAverageState {
     WeightedMovingAverageState w3;
 };
 
+struct HullMovingAverageStateView {
+    uint16_t p1{0};
+    uint16_t p2{0};
+    uint16_t period{0};
+    double lastHull{0.0};
+    bool initialized{false};
+    WeightedMovingAverageStateView w1;
+    WeightedMovingAverageStateView w2;
+    WeightedMovingAverageStateView w3;
+};
+
+/// Fixed-layout header of HullMovingAverage::pack(); followed by the w1, w2 and
+/// w3 windows in that order.
+struct HullMovingAverageSnapshot {
+    uint64_t p1;
+    uint64_t p2;
+    uint64_t period;
+    uint64_t initialized;
+    double lastHull;
+    WeightedMovingAverageSnapshot w1;
+    WeightedMovingAverageSnapshot w2;
+    WeightedMovingAverageSnapshot w3;
+};
+
 struct DoubleExponentialMovingAverageState {
     size_t period{0};
     bool initialized{false};
@@ -78,6 +231,11 @@ struct McGinleyDynamicMovingAverageState {
     uint16_t period{0};
     double lastMd{0.0};
     bool initialized{false};
+    mdArithmetic arithmetic{mdArithmetic::exact};
+    /// amend() bookkeeping, as in ExponentialMovingAverageState.
+    double prevMd{0.0};
+    bool hasPrevMd{false};
+    bool newestSeeded{false};
 };
 
 struct FractalAdaptiveMovingAverageState {
@@ -91,12 +249,62 @@ struct FractalAdaptiveMovingAverageState {
     double lowBuf1min{0.0};
     double lowBuf2min{0.0};
     double lastFrama{0.0};
+    framaArithmetic arithmetic{framaArithmetic::exact};
+    /// Blend of the newest step, for amend(). Without hasPrevFrama, amend() on the
+    /// restored FRAMA throws.
+    double prevFrama{0.0};
+    double lastAlpha{1.0};
+    bool hasPrevFrama{false};
     std::vector<double> highBuf1;
     std::vector<double> highBuf2;
     std::vector<double> lowBuf1;
     std::vector<double> lowBuf2;
 };
 
+struct FractalAdaptiveMovingAverageStateView {
+    bool initialized{false};
+    size_t period{0};
+    double eulerNumber{-4.6};
+    double halfPeriod{0.0};
+    double logTwo{0.0};
+    double highBuf1Max{0.0};
+    double highBuf2Max{0.0};
+    double lowBuf1min{0.0};
+    double lowBuf2min{0.0};
+    double lastFrama{0.0};
+    framaArithmetic arithmetic{framaArithmetic::exact};
+    double prevFrama{0.0};
+    double lastAlpha{1.0};
+    bool hasPrevFrama{false};
+    helpers::RingView<double> highBuf1;
+    helpers::RingView<double> highBuf2;
+    helpers::RingView<double> lowBuf1;
+    helpers::RingView<double> lowBuf2;
+};
+
+/// Fixed-layout header of FractalAdaptiveMovingAverage::pack(); followed by the
+/// highBuf1, highBuf2, lowBuf1 and lowBuf2 windows in that order.
+struct FractalAdaptiveMovingAverageSnapshot {
+    uint64_t period;
+    uint64_t initialized;
+    uint64_t highBuf1Count;
+    uint64_t highBuf2Count;
+    uint64_t lowBuf1Count;
+    uint64_t lowBuf2Count;
+    double eulerNumber;
+    double halfPeriod;
+    double logTwo;
+    double highBuf1Max;
+    double highBuf2Max;
+    double lowBuf1min;
+    double lowBuf2min;
+    double lastFrama;
+    uint64_t arithmetic;
+    double prevFrama;
+    double lastAlpha;
+    uint64_t hasPrevFrama;
+};
+
 struct GeneralizedDoubleExponentialMovingAverageState {
     double period{0.0};
     double emaPeriod{0.0};
@@ -107,6 +315,93 @@ struct GeneralizedDoubleExponentialMovingAverageState {
 };
 
 namespace tama {
+    namespace detail {
+        /// Cold path of update() on an indicator that has not been computed or seeded.
+        [[noreturn]] void throwNotInitialized(const char* indicator);
+
+        /// Cold path of amend() on an indicator restored without the value before its newest sample.
+        [[noreturn]] void throwNotAmendable(const char* indicator);
+
+        /// ExponentialMovingAverage::cascade() advances every stage with the first
+        /// stage's alpha, so restored stages must all run at the indicator's period.
+        /// Throws std::invalid_argument otherwise.
+        void requireCascadeStages(double period, std::span<const ExponentialMovingAverageState> stages);
+
+        /// Paths that computePaths() advances together, one per SIMD lane.
+        constexpr size_t pathLanes = 16;
+
+        /// Steps of each path gathered per tile, keeping a tile within L1.
+        constexpr size_t pathBlock = 16;
+
+        /// Tiles advanced together, so a time-major row is read pathGroup * pathLanes
+        /// values at a time rather than one tile's worth per far-apart row.
+        constexpr size_t pathGroup = 32;
+
+        /// Paths handled per computePaths() group in `layout`; a path-major series is
+        /// already contiguous, so it is walked one tile at a time.
+        constexpr size_t pathsPerGroup(pathLayout layout) {
+            return layout == pathLayout::timeMajor ? pathGroup * pathLanes : pathLanes;
+        }
+
+        /// Spacing of a computePaths() matrix: `steps` samples per path, `time`
+        /// between consecutive samples of a path and `path` between paths.
+        struct PathStrides {
+            size_t steps;
+            size_t time;
+            size_t path;
+        };
+
+        /// Validates computePaths() arguments and, on status::ok, fills `strides`.
+        inline status checkPaths(size_t values, size_t paths, size_t outputSize, size_t statesSize, pathLayout layout, PathStrides& strides) {
+            if (values == 0 || paths == 0) {
+                return status::emptyParams;
+            }
+            if (values % paths != 0 || outputSize < values || (statesSize != 0 && statesSize != paths)) {
+                return status::invalidParam;
+            }
+            const size_t steps = values / paths;
+            strides = layout == pathLayout::timeMajor ? PathStrides{steps, paths, 1} : PathStrides{steps, 1, steps};
+            return status::ok;
+        }
+
+        /// Outputs between the exact window sums computeBlocked() restarts from. At least
+        /// 16 windows, so the restart costs a small fraction of the scan it bounds.
+        constexpr size_t rebaseInterval(size_t period) {
+            return period * 16 > 4096 ? period * 16 : 4096;
+        }
+
+        /// One McGinley Dynamic step from `mt` towards `price` in the given arithmetic.
+        template <mdArithmetic Arithmetic>
+        inline double mdStep(double mt, double price, double period, double invPeriod) {
+            if constexpr (Arithmetic == mdArithmetic::fast) {
+                const double ratio = mt * (1.0 / price);
+                const double ratio2 = ratio * ratio;
+                return (price - mt) * invPeriod * (ratio2 * ratio2) + mt;
+            } else {
+                const double numerator = price - mt;
+                const double denominator = period * std::pow(price / mt, 4.0);
+                return numerator / denominator + mt;
+            }
+        }
+
+        /// FRAMA's smoothing factor exp(eulerNumber * (D - 1)) from the ratio
+        /// (l1 + l2) / l3 of its window ranges, whose log2 is the fractal dimension D.
+        /// D is taken as 1 where it would not be positive.
+        template <framaArithmetic Arithmetic>
+        inline double framaAlpha(double ratio, double eulerNumber, double logTwo) {
+            if constexpr (Arithmetic == framaArithmetic::approximate) {
+                // D <= 0 exactly when ratio <= 1, which also keeps zero out of approxLog2.
+                const double D = ratio > 1.0 ? helpers::approxLog2(ratio) : 1.0;
+                const double alpha = helpers::approxExp2(eulerNumber * std::numbers::log2e * (D - 1.0));
+                return std::isnan(ratio) ? ratio : alpha;
+            } else {
+                double D = std::log(ratio) / logTwo;
+                if (D <= 0) D = 1;
+                return std::exp(eulerNumber * (D - 1));
+            }
+        }
+    }
+
     /// Stateful Exponential Moving Average (EMA) indicator.
     /// Supports both batch computation and single-tick updates.
     class ExponentialMovingAverage {
@@ -116,6 +411,34 @@ namespace tama {
         double alpha;
         double oma;
         bool initalized = false;
+        // Value before the newest sample, for amend(); see ExponentialMovingAverageState.
+        double prevEma{0.0};
+        bool hasPrevEma{false};
+        bool newestSeeded{false};
+
+        friend class DoubleExponentialMovingAverage;
+        friend class TripleExponentialMovingAverage;
+        friend class GeneralizedDoubleExponentialMovingAverage;
+
+        /// update() without the initialization check, for cascades that check once.
+        double step(double price) noexcept;
+
+        /// amend() without the initialization check, for the same cascades.
+        double amendStep(double price);
+
+        /// peek() without the initialization check, for the same cascades.
+        double peekStep(double price) const noexcept;
+
+        /// Records `before` as the value amend() steps from again.
+        void markStepped(double before) noexcept;
+
+        /// Records that the newest sample seeded the EMA, so amend() re-seeds.
+        void markSeeded() noexcept;
+
+        /// Runs `stages` (sharing the first stage's alpha) over `prices` with
+        /// simdEmaCascade. The newest sample is applied as a separate resumed step, so
+        /// every stage keeps the value amendStep() returns to.
+        static void cascade(std::span<ExponentialMovingAverage* const> stages, std::span<const double> coefficients, std::span<const double> prices, std::span<double> output, size_t timeStride, bool resume);
     public:
         /// Creates an EMA indicator instance.
         /// @param period Lookback period used to derive the EMA smoothing factor.
@@ -127,16 +450,101 @@ namespace tama {
         /// Computes EMA values for the full input series.
         /// @param prices Input price series.
         /// @param output Output vector resized/written with EMA values.
+        /// @param mode Whether an initialized indicator restarts or continues its series.
         /// @return status indicating success or failure.
-        status compute(std::span<const double> prices, std::vector<double>& output);
+        status compute(std::span<const double> prices, std::vector<double>& output, computeMode mode = computeMode::restart);
+
+        /// Computes EMA values into caller-owned storage without allocating.
+        /// @param prices Input price series.
+        /// @param output Destination of at least prices.size() elements.
+        /// @param mode Whether an initialized indicator restarts or continues its series.
+        /// @return status::invalidParam if `output` is too short.
+        status compute(std::span<const double> prices, std::span<double> output, computeMode mode = computeMode::restart);
+
+        /// Runs compute() over many simulated price paths at once, one path per SIMD
+        /// lane, all with this indicator's parameters. The indicator is left unchanged:
+        /// each output row and final state is what compute() in `mode` on a copy of
+        /// it would produce for that path, so resume continues every path from here.
+        /// EMA's two products may fuse differently from compute()'s, so its paths can
+        /// differ from compute() in the last bit; MD and HMA match exactly.
+        /// @param paths pathCount series of equal length, laid out as `layout` says.
+        /// @param pathCount Number of paths; must divide paths.size().
+        /// @param output Destination of at least paths.size() elements, same layout.
+        /// @param layout Layout of both `paths` and `output`.
+        /// @param mode Whether the paths start afresh or continue this indicator.
+        /// @param finalStates Empty, or pathCount entries receiving each path's end state.
+        /// @return status::invalidParam on a ragged matrix or short output.
+        status computePaths(std::span<const double> paths, size_t pathCount, std::vector<double>& output, pathLayout layout = pathLayout::pathMajor, computeMode mode = computeMode::restart, std::span<ExponentialMovingAverageState> finalStates = {}) const;
+        status computePaths(std::span<const double> paths, size_t pathCount, std::span<double> output, pathLayout layout = pathLayout::pathMajor, computeMode mode = computeMode::restart, std::span<ExponentialMovingAverageState> finalStates = {}) const;
+
+        /// Computes EMA values for several periods in one pass over the input,
+        /// evaluating one period per SIMD lane. Each row matches compute() for that period.
+        /// @param prices Input price series.
+        /// @param periods Periods to evaluate.
+        /// @param output Output matrix resized to periods.size() * prices.size().
+        /// @param layout Row order of the output matrix.
+        /// @return status indicating success or failure.
+        static status sweep(std::span<const double> prices, std::span<const uint16_t> periods, std::vector<double>& output, sweepLayout layout = sweepLayout::periodMajor);
+
+        /// Sweeps into caller-owned storage of at least periods.size() * prices.size()
+        /// elements. The per-period coefficients are taken from `scratch`, so a
+        /// std::pmr::monotonic_buffer_resource over a stack buffer makes the call
+        /// allocation-free.
+        static status sweep(std::span<const double> prices, std::span<const uint16_t> periods, std::span<double> output, sweepLayout layout = sweepLayout::periodMajor, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
+        /// Computes EMA values for the full input series by treating each step as the
+        /// affine map y = alpha * x + oma * y_prev and scanning those maps associatively.
+        /// Results match compute() to within 1e-12 relative error, since only the
+        /// association of the recurrence changes. State is updated as in compute().
+        /// @param prices Input price series.
+        /// @param output Output vector resized/written with EMA values.
+        /// @param mode SIMD-only scan or multi-threaded blocked scan.
+        /// @param threads Worker count for scanMode::threaded; 0 uses hardware concurrency.
+        /// @return status indicating success or failure.
+        status computeScan(std::span<const double> prices, std::vector<double>& output, scanMode mode = scanMode::threaded, size_t threads = 0);
 
         /// Updates the EMA with a single new price sample.
         /// @param price New price value.
         /// @return Updated EMA value.
         double update(double price);
 
+        /// Advances the EMA by every sample of `prices`, as that many update() calls
+        /// would, writing each new value to `output`. The result and the final state
+        /// are bit-identical to the single-tick path under the library's floating-point
+        /// flags; a caller adding e.g. -ffast-math to header-inline code loses that.
+        /// @param prices New price samples.
+        /// @param output Destination of at least prices.size() elements; must not overlap `prices`.
+        /// @return status::invalidParam if `output` is too short.
+        status update(std::span<const double> prices, std::span<double> output);
+
+        /// Replaces the newest sample, as if the last update() had been given `price`.
+        /// On an intrabar tick this keeps the bar to one sample instead of adding one
+        /// per tick. When the newest value is a seed (a one-sample compute()) the EMA
+        /// is re-seeded with `price`. Throws std::runtime_error on an EMA restored from
+        /// a state that does not carry the value before its newest sample.
+        /// @param price Replacement for the newest price.
+        /// @return Amended EMA value.
+        double amend(double price);
+
+        /// Returns the EMA update(price) would produce, leaving the indicator unchanged.
+        /// @param price Hypothetical next price.
+        double peek(double price) const;
+        /// peek() for every candidate price, e.g. a ladder of order levels. The state
+        /// is read once and the loop has no carried dependency, so it vectorizes.
+        /// @param candidates Hypothetical next prices.
+        /// @param output Destination of at least candidates.size() elements.
+        /// @return status::invalidParam if `output` is too short.
+        status peek(std::span<const double> candidates, std::span<double> output) const;
+
+        /// Returns a branch for scenario analysis: an independent indicator that
+        /// starts from this one's state. Either side can then update, amend or
+        /// compute without affecting the other. The EMA keeps no window, so this
+        /// is a plain copy; the window indicators share theirs instead of copying
+        /// it, see SimpleMovingAverage::fork().
+        ExponentialMovingAverage fork() const;
+
         /// Returns the latest EMA value stored by the indicator.
-        double latest();
+        double latest() const noexcept;
 
         ExponentialMovingAverageState getState();
         
@@ -151,28 +559,89 @@ namespace tama {
         double rollingSum{0.0};
         bool initalized{false};
         double lastSma{0.0};
-        helpers::RingBuffer<double> priceBuf;
+        helpers::FixedRingBuffer<double> priceBuf;
     public:
         /// Creates an SMA indicator instance.
         /// @param period Number of samples used in the SMA window.
         SimpleMovingAverage(uint16_t period, std::vector<double> prevCalc = {});
         SimpleMovingAverage(SimpleMovingAverageState prevCalculation);
+        /// Restores an indicator from pack() output.
+        SimpleMovingAverage(std::span<const std::byte> packed);
 
         /// Computes SMA values for the full input series.
         /// @param prices Input price series.
         /// @param output Output vector resized/written with SMA values.
         /// @return status indicating success or failure.
-        status compute(std::span<const double> prices, std::vector<double>& output);
+        status compute(std::span<const double> prices, std::vector<double>& output, computeMode mode = computeMode::restart);
+        /// Writes into `output`, which must hold one value per input sample; never allocates.
+        status compute(std::span<const double> prices, std::span<double> output, computeMode mode = computeMode::restart);
+
+        /// Computes SMA values for the full input series with helpers::simdWindowScan(),
+        /// which prefix-sums the window deltas several samples at a time instead of
+        /// adding them one by one. The sum restarts from an exact window total every
+        /// detail::rebaseInterval() samples, so drift cannot build up over a long series.
+        /// Results match compute() to within 1e-12 relative on price-like series; always
+        /// restarts, and the state is updated as in compute().
+        /// @param prices Input price series.
+        /// @param output Output vector resized/written with SMA values.
+        /// @return status indicating success or failure.
+        status computeBlocked(std::span<const double> prices, std::vector<double>& output);
+        /// Writes into `output`, which must hold one value per input sample; never allocates.
+        status computeBlocked(std::span<const double> prices, std::span<double> output);
+
+        /// Computes SMA values for several periods in one pass over the input.
+        /// Rows are differences of blocked prefix sums, so each matches compute() for
+        /// that period to about 1e-9 rather than bit for bit.
+        /// @param prices Input price series.
+        /// @param periods Periods to evaluate.
+        /// @param output Output matrix resized to periods.size() * prices.size().
+        /// @param layout Row order of the output matrix.
+        /// @return status indicating success or failure.
+        static status sweep(std::span<const double> prices, std::span<const uint16_t> periods, std::vector<double>& output, sweepLayout layout = sweepLayout::periodMajor);
+        /// As above, writing into `output` and taking temporaries from `scratch`.
+        static status sweep(std::span<const double> prices, std::span<const uint16_t> periods, std::span<double> output, sweepLayout layout = sweepLayout::periodMajor, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
 
         /// Updates the SMA with a single new price sample.
         /// @param price New price value.
         /// @return Updated SMA value.
         double update(double price);
+        /// Batch form of update(); matches that many single updates bit for bit under the library's floating-point flags.
+        status update(std::span<const double> prices, std::span<double> output);
+
+        /// Replaces the newest sample in O(1): the ring slot is overwritten and the
+        /// rolling sum moves by the difference.
+        /// @param price Replacement for the newest price.
+        /// @return Amended SMA value.
+        double amend(double price);
+
+        /// Returns the SMA update(price) would produce, leaving the indicator unchanged.
+        double peek(double price) const;
+        /// peek() for each of `candidates`, written to `output` without allocating.
+        status peek(std::span<const double> candidates, std::span<double> output) const;
+
+        /// Returns a branch that shares this indicator's window instead of copying
+        /// it. Both sides read the shared samples and store only the ticks they take
+        /// afterwards, so forking is O(1) and so is every later tick; a branch that
+        /// is forked again after taking ticks first gathers its window, O(period).
+        SimpleMovingAverage fork();
 
         /// Returns the latest SMA value stored by the indicator.
-        double latest();
+        double latest() const noexcept;
 
         SimpleMovingAverageState getState();
+
+        /// Fills `out` with the current state, reusing the capacity of its buffers.
+        void getState(SimpleMovingAverageState& out) const;
+
+        /// Returns the current state without copying the windows.
+        SimpleMovingAverageStateView view() const noexcept;
+
+        /// Size in bytes of pack()'s output for the current state.
+        size_t packedSize() const noexcept;
+
+        /// Writes a SimpleMovingAverageSnapshot followed by its windows.
+        /// @return status::invalidParam if `out` is smaller than packedSize().
+        status pack(std::span<std::byte> out) const noexcept;
     };
 
 
@@ -187,7 +656,22 @@ namespace tama {
             
             bool initialized{false};
             double lastWma{0.0};
-            helpers::RingBuffer<double> priceBuf;
+            helpers::FixedRingBuffer<double> priceBuf;
+
+            friend class HullMovingAverage;
+
+            /// update() without the initialization check, for HMA's three windows.
+            double step(double price);
+
+            /// amend() without the initialization check, for the same windows.
+            double amendStep(double price);
+
+            /// peek() without the initialization check, for the same windows.
+            double peekStep(double price) const noexcept;
+
+            /// Packed snapshot pieces, shared with HMA's snapshot of its three windows.
+            WeightedMovingAverageSnapshot snapshotHeader() const noexcept;
+            static WeightedMovingAverageState unpackState(const WeightedMovingAverageSnapshot& header, std::span<const std::byte> packed, size_t& offset);
 
         public:
             /// Creates a WMA indicator instance.
@@ -196,22 +680,81 @@ namespace tama {
             /// prices ordered from past to present (oldest to newest).
             WeightedMovingAverage(uint16_t period, std::vector<double> prevCalc = {});
             WeightedMovingAverage(WeightedMovingAverageState prevCalculation);
+            /// Restores an indicator from pack() output.
+            WeightedMovingAverage(std::span<const std::byte> packed);
 
             /// Computes WMA values for the full input series.
             /// @param prices Input price series.
             /// @param output Output vector resized/written with WMA values.
             /// @return status indicating success or failure.
-            status compute(std::span<const double> prices, std::vector<double>& output);
+            status compute(std::span<const double> prices, std::vector<double>& output, computeMode mode = computeMode::restart);
+            /// Writes into `output`, which must hold one value per input sample; never allocates.
+            status compute(std::span<const double> prices, std::span<double> output, computeMode mode = computeMode::restart);
+
+            /// Computes WMA values for the full input series with
+            /// helpers::simdWeightedWindowScan(), which prefix-sums the plain and weighted
+            /// window deltas in registers. Both sums restart from exact window totals every
+            /// detail::rebaseInterval() samples, so the error stays at a few 1e-12 relative
+            /// however long the series; compute()'s rolling weighted sum drifts further,
+            /// and the two agree to about 1e-9 relative. Always restarts, and the state is
+            /// updated as in compute().
+            /// @param prices Input price series.
+            /// @param output Output vector resized/written with WMA values.
+            /// @return status indicating success or failure.
+            status computeBlocked(std::span<const double> prices, std::vector<double>& output);
+            /// Writes into `output`, which must hold one value per input sample; never allocates.
+            status computeBlocked(std::span<const double> prices, std::span<double> output);
+
+            /// Computes WMA values for several periods in one pass over the input.
+            /// Each row matches compute() for that period to about 1e-9 relative; the
+            /// index-weighted prefix sums cancel more than plain ones for short periods.
+            /// @param prices Input price series.
+            /// @param periods Periods to evaluate.
+            /// @param output Output matrix resized to periods.size() * prices.size().
+            /// @param layout Row order of the output matrix.
+            /// @return status indicating success or failure.
+            static status sweep(std::span<const double> prices, std::span<const uint16_t> periods, std::vector<double>& output, sweepLayout layout = sweepLayout::periodMajor);
+            /// As above, writing into `output` and taking temporaries from `scratch`.
+            static status sweep(std::span<const double> prices, std::span<const uint16_t> periods, std::span<double> output, sweepLayout layout = sweepLayout::periodMajor, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
 
             /// Updates the WMA with a single new price sample.
             /// @param price New price value           /// @return Updated WMA value.
             double update(double price);
+            /// Batch form of update(); matches that many single updates bit for bit under the library's floating-point flags.
+            status update(std::span<const double> prices, std::span<double> output);
+
+            /// Replaces the newest sample in O(1). It carries the full weight `period`,
+            /// so both rolling sums move by a multiple of the difference.
+            /// @param price Replacement for the newest price.
+            /// @return Amended WMA value.
+            double amend(double price);
+
+            /// Returns the WMA update(price) would produce, leaving the indicator unchanged.
+            double peek(double price) const;
+            /// peek() for each of `candidates`, written to `output` without allocating.
+            status peek(std::span<const double> candidates, std::span<double> output) const;
+
+            /// Returns a branch sharing this indicator's window; see SimpleMovingAverage::fork().
+            WeightedMovingAverage fork();
 
             /// Returns the latest WMA value stored by the indicator.
-            double latest();
+            double latest() const noexcept;
 
             WeightedMovingAverageState getState();
 
+            /// Fills `out` with the current state, reusing the capacity of its buffers.
+            void getState(WeightedMovingAverageState& out) const;
+
+            /// Returns the current state without copying the windows.
+            WeightedMovingAverageStateView view() const noexcept;
+
+            /// Size in bytes of pack()'s output for the current state.
+            size_t packedSize() const noexcept;
+
+            /// Writes a WeightedMovingAverageSnapshot followed by its windows.
+            /// @return status::invalidParam if `out` is smaller than packedSize().
+            status pack(std::span<std::byte> out) const noexcept;
+
     };
 
     class VolumeWeightedMovingAverage {
@@ -221,16 +764,53 @@ namespace tama {
             double rollingNumerator;
             double rollingDenominator;
             double lastCalculation;
-            helpers::RingBuffer<double> priceBuf;
-            helpers::RingBuffer<double> volumeBuf;
+            helpers::FixedRingBuffer<double> priceBuf;
+            helpers::FixedRingBuffer<double> volumeBuf;
             
         public:
             VolumeWeightedMovingAverage(uint16_t period, std::vector<double> prevPrices = {}, std::vector<double> prevVolume = {});
             VolumeWeightedMovingAverage(VolumeWeightedMovingAverageState prevCalculation);
-            status compute(std::span<const double> prices, std::span<const double> volume, std::vector<double>& output);
+            /// Restores an indicator from pack() output.
+            VolumeWeightedMovingAverage(std::span<const std::byte> packed);
+            status compute(std::span<const double> prices, std::span<const double> volume, std::vector<double>& output, computeMode mode = computeMode::restart);
+            /// Writes into `output`, which must hold one value per input sample; never allocates.
+            status compute(std::span<const double> prices, std::span<const double> volume, std::span<double> output, computeMode mode = computeMode::restart);
+
+            /// Computes VWMA values for several periods in one pass over the input.
+            /// Both sums of each row are differences of blocked prefix sums, so it matches
+            /// compute() for that period to about 1e-9 rather than bit for bit.
+            static status sweep(std::span<const double> prices, std::span<const double> volume, std::span<const uint16_t> periods, std::vector<double>& output, sweepLayout layout = sweepLayout::periodMajor);
+            /// As above, writing into `output` and taking temporaries from `scratch`.
+            static status sweep(std::span<const double> prices, std::span<const double> volume, std::span<const uint16_t> periods, std::span<double> output, sweepLayout layout = sweepLayout::periodMajor, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
             double update(double price, double volume);
-            double latest();
+            /// Batch form of update(); matches that many single updates bit for bit under the library's floating-point flags.
+            status update(std::span<const double> prices, std::span<const double> volume, std::span<double> output);
+            /// Replaces the newest price and volume in O(1).
+            double amend(double price, double volume);
+            /// Returns the VWMA update(price, volume) would produce, leaving the indicator unchanged.
+            double peek(double price, double volume) const;
+            /// peek() for every candidate; `volume` pairs with `candidates` element by element.
+            /// @return status::invalidParam if the sizes differ or `output` is too short.
+            status peek(std::span<const double> candidates, std::span<const double> volume, std::span<double> output) const;
+
+            /// Returns a branch sharing this indicator's windows; see SimpleMovingAverage::fork().
+            VolumeWeightedMovingAverage fork();
+            double latest() const noexcept;
             VolumeWeightedMovingAverageState getState();
+
+            /// Fills `out` with the current state, reusing the capacity of its buffers.
+            void getState(VolumeWeightedMovingAverageState& out) const;
+
+            /// Returns the current state without copying the windows.
+            VolumeWeightedMovingAverageStateView view() const noexcept;
+
+            /// Size in bytes of pack()'s output for the current state.
+            size_t packedSize() const noexcept;
+
+            /// Writes a VolumeWeightedMovingAverageSnapshot followed by its windows.
+            /// @return status::invalidParam if `out` is smaller than packedSize().
+            status pack(std::span<std::byte> out) const noexcept;
     };
 
 
@@ -245,6 +825,9 @@ namespace tama {
         WeightedMovingAverage w1;
         WeightedMovingAverage w2;
         WeightedMovingAverage w3;
+
+        /// With `resume`, continues from the current windows instead of filling them.
+        void fusedCompute(std::span<const double> prices, std::span<double> output, size_t timeStride, bool resume = false);
     public:
         /// Creates an HMA indicator instance.
         /// @param period Base lookback period used by the HMA.
@@ -252,22 +835,60 @@ namespace tama {
         /// prices ordered from past to present (oldest to newest).
         HullMovingAverage(uint16_t period, std::vector<double> prevCalc = {});
         HullMovingAverage(HullMovingAverageState prevCalculation);
+        /// Restores an indicator from pack() output.
+        HullMovingAverage(std::span<const std::byte> packed);
 
         /// Computes HMA values for the full input series.
         /// @param prices Input price series.
         /// @param output Output vector resized/written with HMA values.
         /// @return status indicating success or failure.
-        status compute(std::span<const double> prices, std::vector<double>& output);
+        status compute(std::span<const double> prices, std::vector<double>& output, computeMode mode = computeMode::restart);
+        /// Writes into `output`, which must hold one value per input sample; never allocates.
+        status compute(std::span<const double> prices, std::span<double> output, computeMode mode = computeMode::restart);
+
+        /// compute() over many paths at once, one per SIMD lane; see
+        /// ExponentialMovingAverage::computePaths(). Unless resumed, each path
+        /// needs at least `period` steps.
+        status computePaths(std::span<const double> paths, size_t pathCount, std::vector<double>& output, pathLayout layout = pathLayout::pathMajor, computeMode mode = computeMode::restart, std::span<HullMovingAverageState> finalStates = {}) const;
+        status computePaths(std::span<const double> paths, size_t pathCount, std::span<double> output, pathLayout layout = pathLayout::pathMajor, computeMode mode = computeMode::restart, std::span<HullMovingAverageState> finalStates = {}) const;
 
         /// Updates the HMA with a single new price sample.
         /// @param price New price value.
         /// @return Updated HMA value.
         double update(double price);
+        /// Batch form of update(); matches that many single updates bit for bit under the library's floating-point flags.
+        status update(std::span<const double> prices, std::span<double> output);
+
+        /// Replaces the newest sample in O(1) by amending each of the three windows.
+        /// @param price Replacement for the newest price.
+        /// @return Amended HMA value.
+        double amend(double price);
+
+        /// Returns the HMA update(price) would produce, leaving the indicator unchanged.
+        double peek(double price) const;
+        /// peek() for each of `candidates`, written to `output` without allocating.
+        status peek(std::span<const double> candidates, std::span<double> output) const;
+
+        /// Returns a branch sharing this indicator's windows; see SimpleMovingAverage::fork().
+        HullMovingAverage fork();
 
         /// Returns the latest HMA value stored by the indicator.
-        double latest();
+        double latest() const noexcept;
 
         HullMovingAverageState getState();
+
+        /// Fills `out` with the current state, reusing the capacity of its buffers.
+        void getState(HullMovingAverageState& out) const;
+
+        /// Returns the current state without copying the windows.
+        HullMovingAverageStateView view() const noexcept;
+
+        /// Size in bytes of pack()'s output for the current state.
+        size_t packedSize() const noexcept;
+
+        /// Writes a HullMovingAverageSnapshot followed by its windows.
+        /// @return status::invalidParam if `out` is smaller than packedSize().
+        status pack(std::span<std::byte> out) const noexcept;
     };
 
     /// Stateful Double Exponential Moving Average (DEMA) indicator.
@@ -276,10 +897,18 @@ namespace tama {
     private:
         size_t period;
         bool initialized{false};
-        double lastDema{0.0};
 
         ExponentialMovingAverage ema1;
         ExponentialMovingAverage ema2;
+
+        // Kept apart from ema1.lastEma so update() does not store the two as one
+        // packed vector, which stalls the next tick's store-to-load forwarding.
+        double lastDema{0.0};
+
+        /// Runs both EMA stages in one pass and writes 2 * ema1 - ema2 to
+        /// output[t * timeStride]; a timeStride of 0 keeps only the last value. With
+        /// `resume`, the stages continue from their current values instead of prices[0].
+        void fusedCompute(std::span<const double> prices, std::span<double> output, size_t timeStride, bool resume = false);
     public:
         /// Creates a DEMA indicator instance.
         /// @param period Lookback period used by the EMA cascade.
@@ -292,15 +921,38 @@ namespace tama {
         /// @param prices Input price series.
         /// @param output Output vector resized/written with DEMA values.
         /// @return status indicating success or failure.
-        status compute(std::span<const double> prices, std::vector<double>& output);
+        status compute(std::span<const double> prices, std::vector<double>& output, computeMode mode = computeMode::restart);
+        /// Writes into `output`, which must hold one value per input sample; never allocates.
+        status compute(std::span<const double> prices, std::span<double> output, computeMode mode = computeMode::restart);
+
+        /// Computes DEMA values for several periods in one pass over the input,
+        /// evaluating one period per SIMD lane. Each row matches compute() for that period.
+        static status sweep(std::span<const double> prices, std::span<const uint16_t> periods, std::vector<double>& output, sweepLayout layout = sweepLayout::periodMajor);
+        /// As above, writing into `output` and taking temporaries from `scratch`.
+        static status sweep(std::span<const double> prices, std::span<const uint16_t> periods, std::span<double> output, sweepLayout layout = sweepLayout::periodMajor, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
 
         /// Updates the DEMA with a single new price sample.
         /// @param price New price value.
         /// @return Updated DEMA value.
         double update(double price);
+        /// Batch form of update(); matches that many single updates bit for bit under the library's floating-point flags.
+        status update(std::span<const double> prices, std::span<double> output);
+
+        /// Replaces the newest sample by amending each EMA stage; see ExponentialMovingAverage::amend().
+        /// @param price Replacement for the newest price.
+        /// @return Amended DEMA value.
+        double amend(double price);
+
+        /// Returns the DEMA update(price) would produce, leaving the indicator unchanged.
+        double peek(double price) const;
+        /// peek() for each of `candidates`, written to `output` without allocating.
+        status peek(std::span<const double> candidates, std::span<double> output) const;
+
+        /// Returns an independent copy for scenario branches; see ExponentialMovingAverage::fork().
+        DoubleExponentialMovingAverage fork() const;
 
         /// Returns the latest DEMA value stored by the indicator.
-        double latest();
+        double latest() const noexcept;
 
         DoubleExponentialMovingAverageState getState();
     };
@@ -311,12 +963,18 @@ namespace tama {
     private:
         size_t period;    
         bool initialized{false};
-        double lastTema{0.0};
 
         ExponentialMovingAverage ema1;
         ExponentialMovingAverage ema2;
         ExponentialMovingAverage ema3;
 
+        // After the stages for the same reason as DoubleExponentialMovingAverage::lastDema.
+        double lastTema{0.0};
+
+        /// Runs the three EMA stages in one pass and writes 3 * ema1 - 3 * ema2 + ema3 to
+        /// output[t * timeStride]; a timeStride of 0 keeps only the last value. With
+        /// `resume`, the stages continue from their current values instead of prices[0].
+        void fusedCompute(std::span<const double> prices, std::span<double> output, size_t timeStride, bool resume = false);
     public:
         /// Creates a TEMA indicator instance.
         /// @param period Lookback period used by the EMA cascade.
@@ -329,15 +987,38 @@ namespace tama {
         /// @param prices Input price series.
         /// @param output Output vector resized/written with TEMA values.
         /// @return status indicating success or failure.
-        status compute(std::span<const double> prices, std::vector<double>& output);
+        status compute(std::span<const double> prices, std::vector<double>& output, computeMode mode = computeMode::restart);
+        /// Writes into `output`, which must hold one value per input sample; never allocates.
+        status compute(std::span<const double> prices, std::span<double> output, computeMode mode = computeMode::restart);
+
+        /// Computes TEMA values for several periods in one pass over the input,
+        /// evaluating one period per SIMD lane. Each row matches compute() for that period.
+        static status sweep(std::span<const double> prices, std::span<const uint16_t> periods, std::vector<double>& output, sweepLayout layout = sweepLayout::periodMajor);
+        /// As above, writing into `output` and taking temporaries from `scratch`.
+        static status sweep(std::span<const double> prices, std::span<const uint16_t> periods, std::span<double> output, sweepLayout layout = sweepLayout::periodMajor, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
 
         /// Updates the TEMA with a single new price sample.
         /// @param price New price value.
         /// @return Updated TEMA value.
         double update(double price);
+        /// Batch form of update(); matches that many single updates bit for bit under the library's floating-point flags.
+        status update(std::span<const double> prices, std::span<double> output);
+
+        /// Replaces the newest sample by amending each EMA stage; see ExponentialMovingAverage::amend().
+        /// @param price Replacement for the newest price.
+        /// @return Amended TEMA value.
+        double amend(double price);
+
+        /// Returns the TEMA update(price) would produce, leaving the indicator unchanged.
+        double peek(double price) const;
+        /// peek() for each of `candidates`, written to `output` without allocating.
+        status peek(std::span<const double> candidates, std::span<double> output) const;
+
+        /// Returns an independent copy for scenario branches; see ExponentialMovingAverage::fork().
+        TripleExponentialMovingAverage fork() const;
 
         /// Returns the latest TEMA value stored by the indicator.
-        double latest();
+        double latest() const noexcept;
 
         TripleExponentialMovingAverageState getState();
     };
@@ -347,29 +1028,63 @@ namespace tama {
     class McGinleyDynamicMovingAverage {
     private:
         uint16_t period;
+        double invPeriod;
         double lastMd{0.0};
         bool initialized{false};
+        mdArithmetic arithmetic{mdArithmetic::exact};
+        // Value before the newest sample, for amend(); see McGinleyDynamicMovingAverageState.
+        double prevMd{0.0};
+        bool hasPrevMd{false};
+        bool newestSeeded{false};
+
+        double step(double mt, double price) const;
 
     public:
         /// Creates an MD indicator instance.
         /// @param period Base lookback period used in the MD calculation.
         /// @param prevCalculation Optional previous MD value used as warm start.
-        McGinleyDynamicMovingAverage(uint16_t period, double prevCalculation = 0.0);
+        /// @param arithmetic exact keeps std::pow; fast trades it for multiplies, see mdArithmetic.
+        McGinleyDynamicMovingAverage(uint16_t period, double prevCalculation = 0.0, mdArithmetic arithmetic = mdArithmetic::exact);
         McGinleyDynamicMovingAverage(McGinleyDynamicMovingAverageState prevCalculation);
 
         /// Computes MD values for the full input series.
         /// @param prices Input price series.
         /// @param output Output vector resized/written with MD values.
         /// @return status indicating success or failure.
-        status compute(std::span<const double> prices, std::vector<double>& output);
+        status compute(std::span<const double> prices, std::vector<double>& output, computeMode mode = computeMode::restart);
+        /// Writes into `output`, which must hold one value per input sample; never allocates.
+        status compute(std::span<const double> prices, std::span<double> output, computeMode mode = computeMode::restart);
+
+        /// compute() over many paths at once, one per SIMD lane; see
+        /// ExponentialMovingAverage::computePaths().
+        status computePaths(std::span<const double> paths, size_t pathCount, std::vector<double>& output, pathLayout layout = pathLayout::pathMajor, computeMode mode = computeMode::restart, std::span<McGinleyDynamicMovingAverageState> finalStates = {}) const;
+        status computePaths(std::span<const double> paths, size_t pathCount, std::span<double> output, pathLayout layout = pathLayout::pathMajor, computeMode mode = computeMode::restart, std::span<McGinleyDynamicMovingAverageState> finalStates = {}) const;
 
         /// Updates the MD with a single new price sample.
         /// @param price New price value.
         /// @return Updated MD value.
         double update(double price);
+        /// Batch form of update(); matches that many single updates bit for bit under the library's floating-point flags.
+        status update(std::span<const double> prices, std::span<double> output);
+
+        /// Replaces the newest sample, as if the last update() had been given `price`.
+        /// A seed value (a one-sample compute()) is re-seeded instead. Throws
+        /// std::runtime_error when the value before the newest sample is unknown: after
+        /// a warm start from `prevCalculation` or a state that does not carry it.
+        /// @param price Replacement for the newest price.
+        /// @return Amended MD value.
+        double amend(double price);
+
+        /// Returns the MD update(price) would produce, leaving the indicator unchanged.
+        double peek(double price) const;
+        /// peek() for each of `candidates`, written to `output` without allocating.
+        status peek(std::span<const double> candidates, std::span<double> output) const;
+
+        /// Returns an independent copy for scenario branches; see ExponentialMovingAverage::fork().
+        McGinleyDynamicMovingAverage fork() const;
 
         /// Returns the latest MD value stored by the indicator.
-        double latest();
+        double latest() const noexcept;
 
         McGinleyDynamicMovingAverageState getState();
     };
@@ -389,19 +1104,86 @@ namespace tama {
         double lowBuf2min{0.0};
 
         double lastFrama{0.0};
+        framaArithmetic arithmetic{framaArithmetic::exact};
+
+        // Blend of the newest step, for amend(). Its alpha came from the window before
+        // the newest bar, so only the close changes the amended value. The defaults
+        // make amend() of a seed return the close.
+        double prevFrama{0.0};
+        double lastAlpha{1.0};
+        bool hasPrevFrama{false};
+
+        helpers::FixedRingBuffer<double> highBuf1;
+        helpers::FixedRingBuffer<double> highBuf2;
+        helpers::FixedRingBuffer<double> lowBuf1;
+        helpers::FixedRingBuffer<double> lowBuf2;
+
+        // Window extrema; rebuilt from the buffers when restoring a state.
+        helpers::MonotonicDeque<double, std::greater<double>> highMax1;
+        helpers::MonotonicDeque<double, std::greater<double>> highMax2;
+        helpers::MonotonicDeque<double, std::less<double>> lowMin1;
+        helpers::MonotonicDeque<double, std::less<double>> lowMin2;
 
-        helpers::RingBuffer<double> highBuf1;
-        helpers::RingBuffer<double> highBuf2;
-        helpers::RingBuffer<double> lowBuf1;
-        helpers::RingBuffer<double> lowBuf2;
+        void slide(double high, double low);
+
+        /// Overwrites the newest high and low in the second half-window and its extrema.
+        void replaceNewest(double high, double low);
+
+        /// (l1 + l2) / l3 of the current half-window extrema, whose log2 is the fractal dimension.
+        double windowRatio() const noexcept;
+
+        /// Smoothing factor of the next step, from the current half-window extrema.
+        double nextAlpha() const noexcept;
 
     public:
-        FractalAdaptiveMovingAverage(uint16_t period, double eulerNumber = -4.6);
+        /// @param arithmetic exact keeps std::log and std::exp; approximate trades
+        /// them for polynomials, see framaArithmetic.
+        FractalAdaptiveMovingAverage(uint16_t period, double eulerNumber = -4.6, framaArithmetic arithmetic = framaArithmetic::exact);
         FractalAdaptiveMovingAverage(FractalAdaptiveMovingAverageState prevCalculation);
-        status compute(std::span<const double> close, std::span<const double> low, std::span<const double> high, std::vector<double>& output);
-        double latest();
+        /// Restores an indicator from pack() output.
+        FractalAdaptiveMovingAverage(std::span<const std::byte> packed);
+        status compute(std::span<const double> close, std::span<const double> low, std::span<const double> high, std::vector<double>& output, computeMode mode = computeMode::restart);
+        /// Writes into `output`, which must hold one value per input sample; never allocates.
+        status compute(std::span<const double> close, std::span<const double> low, std::span<const double> high, std::span<double> output, computeMode mode = computeMode::restart);
+        double latest() const noexcept;
         double update(double close, double low, double high);
+        /// Batch form of update(); matches that many single updates bit for bit under the library's floating-point flags.
+        status update(std::span<const double> close, std::span<const double> low, std::span<const double> high, std::span<double> output);
+        /// Replaces the newest bar. O(1) unless the high falls or the low rises, which
+        /// rebuilds that extremum over the half-window. Throws std::runtime_error on a
+        /// FRAMA restored from a state that does not carry its newest blend.
+        double amend(double close, double low, double high);
+        /// Returns the FRAMA update(close, low, high) would produce, leaving the
+        /// indicator unchanged. That bar's high and low only enter the window after its
+        /// value is taken, so the close alone decides it.
+        double peek(double close) const;
+        /// peek() for every candidate close; the alpha is computed once for all of them.
+        /// @return status::invalidParam if `output` is too short.
+        status peek(std::span<const double> candidates, std::span<double> output) const;
+
+        /// Writes the smoothing factor the next update() of each indicator will use,
+        /// one per instrument. Each indicator keeps its own arithmetic. The approximate
+        /// ones are evaluated together in one vectorized pass.
+        /// @return status::invalidParam if `output` is too short.
+        static status nextAlphas(std::span<const FractalAdaptiveMovingAverage> indicators, std::span<double> output);
+
+        /// Returns a branch sharing this indicator's windows; see SimpleMovingAverage::fork().
+        /// The extremum deques are still copied, O(period).
+        FractalAdaptiveMovingAverage fork();
         FractalAdaptiveMovingAverageState getState();
+
+        /// Fills `out` with the current state, reusing the capacity of its buffers.
+        void getState(FractalAdaptiveMovingAverageState& out) const;
+
+        /// Returns the current state without copying the windows.
+        FractalAdaptiveMovingAverageStateView view() const noexcept;
+
+        /// Size in bytes of pack()'s output for the current state.
+        size_t packedSize() const noexcept;
+
+        /// Writes a FractalAdaptiveMovingAverageSnapshot followed by its windows.
+        /// @return status::invalidParam if `out` is smaller than packedSize().
+        status pack(std::span<std::byte> out) const noexcept;
     };
 
     class GeneralizedDoubleExponentialMovingAverage  {
@@ -416,12 +1198,690 @@ namespace tama {
     public:
         GeneralizedDoubleExponentialMovingAverage(double period, uint16_t emaPeriod);
         GeneralizedDoubleExponentialMovingAverage(GeneralizedDoubleExponentialMovingAverageState prevCalculation);
-        status compute(std::span<const double> price, std::vector<double>& output);
-        double latest();
+        status compute(std::span<const double> price, std::vector<double>& output, computeMode mode = computeMode::restart);
+        /// Writes into `output`, which must hold one value per input sample; never allocates.
+        status compute(std::span<const double> price, std::span<double> output, computeMode mode = computeMode::restart);
+
+        /// Computes GD values with volume factor `period` for several EMA periods in one
+        /// pass over the input. Each row matches compute() for that EMA period.
+        static status sweep(std::span<const double> prices, double period, std::span<const uint16_t> emaPeriods, std::vector<double>& output, sweepLayout layout = sweepLayout::periodMajor);
+        /// As above, writing into `output` and taking temporaries from `scratch`.
+        static status sweep(std::span<const double> prices, double period, std::span<const uint16_t> emaPeriods, std::span<double> output, sweepLayout layout = sweepLayout::periodMajor, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
+        double latest() const noexcept;
         double update(double price);
+        /// Batch form of update(); matches that many single updates bit for bit under the library's floating-point flags.
+        status update(std::span<const double> prices, std::span<double> output);
+        /// Replaces the newest sample by amending both EMA stages.
+        double amend(double price);
+        /// Returns the GD update(price) would produce, leaving the indicator unchanged.
+        double peek(double price) const;
+        /// peek() for every candidate price, without allocating.
+        /// @return status::invalidParam if `output` is too short.
+        status peek(std::span<const double> candidates, std::span<double> output) const;
+
+        /// Returns an independent copy for scenario branches; see ExponentialMovingAverage::fork().
+        GeneralizedDoubleExponentialMovingAverage fork() const;
         GeneralizedDoubleExponentialMovingAverageState getState();
     };  
 
+    /// Structure-of-arrays EMA state for many instruments.
+    /// Each update() advances every instrument by one tick in a single SIMD pass.
+    class ExponentialMovingAverageBank {
+    private:
+        size_t instruments;
+        bool initialized{false};
+        helpers::AlignedVector<double> lastEma;
+        helpers::AlignedVector<double> period;
+        helpers::AlignedVector<double> alpha;
+        helpers::AlignedVector<double> oma;
+    public:
+        /// Creates a bank with one EMA per entry in `periods`.
+        /// The first update() seeds every instrument with its price, like compute().
+        ExponentialMovingAverageBank(std::span<const uint16_t> periods);
+        ExponentialMovingAverageBank(std::span<const ExponentialMovingAverageState> prevCalculations);
+
+        /// Advances every instrument by one tick.
+        /// @param prices One price per instrument, in bank order.
+        /// @return status indicating success or failure.
+        status update(std::span<const double> prices);
+
+        /// Returns the latest EMA value of every instrument.
+        std::span<const double> latest();
+
+        size_t size();
+
+        ExponentialMovingAverageState getState(size_t instrument);
+    };
+
+    /// Structure-of-arrays DEMA state for many instruments, built on two EMA banks.
+    class DoubleExponentialMovingAverageBank {
+    private:
+        bool initialized{false};
+        helpers::AlignedVector<double> lastDema;
+        ExponentialMovingAverageBank ema1;
+        ExponentialMovingAverageBank ema2;
+    public:
+        DoubleExponentialMovingAverageBank(std::span<const uint16_t> periods);
+        DoubleExponentialMovingAverageBank(std::span<const DoubleExponentialMovingAverageState> prevCalculations);
+        status update(std::span<const double> prices);
+        std::span<const double> latest();
+        size_t size();
+        DoubleExponentialMovingAverageState getState(size_t instrument);
+    };
+
+    /// Structure-of-arrays TEMA state for many instruments, built on three EMA banks.
+    class TripleExponentialMovingAverageBank {
+    private:
+        bool initialized{false};
+        helpers::AlignedVector<double> lastTema;
+        ExponentialMovingAverageBank ema1;
+        ExponentialMovingAverageBank ema2;
+        ExponentialMovingAverageBank ema3;
+    public:
+        TripleExponentialMovingAverageBank(std::span<const uint16_t> periods);
+        TripleExponentialMovingAverageBank(std::span<const TripleExponentialMovingAverageState> prevCalculations);
+        status update(std::span<const double> prices);
+        std::span<const double> latest();
+        size_t size();
+        TripleExponentialMovingAverageState getState(size_t instrument);
+    };
+
+    /// Structure-of-arrays GD state for many instruments, built on two EMA banks.
+    class GeneralizedDoubleExponentialMovingAverageBank {
+    private:
+        helpers::AlignedVector<double> period;
+        helpers::AlignedVector<double> onePlusPeriod;
+        helpers::AlignedVector<double> lastGd;
+        ExponentialMovingAverageBank emaBuf1;
+        ExponentialMovingAverageBank emaBuf2;
+    public:
+        /// @param periods GD volume factor per instrument.
+        /// @param emaPeriods EMA period per instrument.
+        GeneralizedDoubleExponentialMovingAverageBank(std::span<const double> periods, std::span<const uint16_t> emaPeriods);
+        GeneralizedDoubleExponentialMovingAverageBank(std::span<const GeneralizedDoubleExponentialMovingAverageState> prevCalculations);
+        status update(std::span<const double> prices);
+        std::span<const double> latest();
+        size_t size();
+        GeneralizedDoubleExponentialMovingAverageState getState(size_t instrument);
+    };
+
+    /// Structure-of-arrays McGinley Dynamic state for many instruments. The recurrence
+    /// is serial in time, so update() advances all instruments by one tick instead, as
+    /// one SIMD kernel when the bank uses mdArithmetic::fast.
+    class McGinleyDynamicMovingAverageBank {
+    private:
+        size_t instruments;
+        bool initialized;
+        mdArithmetic arithmetic;
+        helpers::AlignedVector<double> lastMd;
+        helpers::AlignedVector<double> period;
+        helpers::AlignedVector<double> invPeriod;
+    public:
+        /// Creates a bank with one MD per entry in `periods`; the first update() seeds them.
+        McGinleyDynamicMovingAverageBank(std::span<const uint16_t> periods, mdArithmetic arithmetic = mdArithmetic::exact);
+        /// All states must share one arithmetic and be all initialized or all uninitialized.
+        McGinleyDynamicMovingAverageBank(std::span<const McGinleyDynamicMovingAverageState> prevCalculations);
+
+        /// Advances every instrument by one tick.
+        /// @param prices One price per instrument, in bank order.
+        /// @return status indicating success or failure.
+        status update(std::span<const double> prices);
+
+        /// Returns the latest MD value of every instrument.
+        std::span<const double> latest();
+
+        size_t size();
+
+        McGinleyDynamicMovingAverageState getState(size_t instrument);
+    };
+
+    /// Structure-of-arrays SMA state for many instruments.
+    /// Instruments sharing a period are grouped into one bucket whose windows live in a
+    /// single interleaved slab, so each update() sweeps a bucket with contiguous loads.
+    class SimpleMovingAverageBank {
+    private:
+        struct Bucket {
+            size_t period;
+            double alpha;
+            std::vector<size_t> instruments;
+            helpers::WindowSlab<double> priceBuf;
+            helpers::AlignedVector<double> rollingSum;
+            helpers::AlignedVector<double> prices;
+            helpers::AlignedVector<double> lastSma;
+        };
+
+        std::vector<Bucket> buckets;
+        std::vector<std::pair<size_t, size_t>> lanes;
+        std::vector<double> lastSma;
+    public:
+        /// Creates a bank with one SMA per entry in `periods`.
+        /// Each instrument reports 0 until its window is full, like compute().
+        SimpleMovingAverageBank(std::span<const uint16_t> periods);
+        SimpleMovingAverageBank(std::span<const SimpleMovingAverageState> prevCalculations);
+
+        /// Advances every instrument by one tick.
+        /// @param prices One price per instrument, in bank order.
+        /// @return status indicating success or failure.
+        status update(std::span<const double> prices);
+
+        /// Returns the latest SMA value of every instrument.
+        std::span<const double> latest();
+
+        size_t size();
+
+        /// Returns one instrument's state. Until its window is full, the state is that
+        /// of a fresh SMA: uninitialized, with an empty priceBuf and a zero sum. The
+        /// samples absorbed so far are dropped, so a bank rebuilt from it needs a full
+        /// `period` of ticks before that instrument reports again. Throws
+        /// std::out_of_range for an index outside the bank.
+        SimpleMovingAverageState getState(size_t instrument);
+    };
+
+    /// Structure-of-arrays WMA state for many instruments, bucketed by period.
+    class WeightedMovingAverageBank {
+    private:
+        struct Bucket {
+            size_t period;
+            double denominator;
+            std::vector<size_t> instruments;
+            helpers::WindowSlab<double> priceBuf;
+            helpers::AlignedVector<double> rollingSum;
+            helpers::AlignedVector<double> rollingWeightedSum;
+            helpers::AlignedVector<double> prices;
+            helpers::AlignedVector<double> lastWma;
+        };
+
+        std::vector<Bucket> buckets;
+        std::vector<std::pair<size_t, size_t>> lanes;
+        std::vector<double> lastWma;
+    public:
+        WeightedMovingAverageBank(std::span<const uint16_t> periods);
+        WeightedMovingAverageBank(std::span<const WeightedMovingAverageState> prevCalculations);
+        status update(std::span<const double> prices);
+        std::span<const double> latest();
+        size_t size();
+        /// As SimpleMovingAverageBank::getState(): an instrument still warming up is
+        /// reported as a fresh WMA and its absorbed samples are dropped.
+        WeightedMovingAverageState getState(size_t instrument);
+    };
+
+    /// Structure-of-arrays VWMA state for many instruments, bucketed by period.
+    class VolumeWeightedMovingAverageBank {
+    private:
+        struct Bucket {
+            size_t period;
+            std::vector<size_t> instruments;
+            helpers::WindowSlab<double> priceBuf;
+            helpers::WindowSlab<double> volumeBuf;
+            helpers::AlignedVector<double> rollingNumerator;
+            helpers::AlignedVector<double> rollingDenominator;
+            helpers::AlignedVector<double> prices;
+            helpers::AlignedVector<double> volume;
+            helpers::AlignedVector<double> lastCalculation;
+        };
+
+        std::vector<Bucket> buckets;
+        std::vector<std::pair<size_t, size_t>> lanes;
+        std::vector<double> lastCalculation;
+    public:
+        VolumeWeightedMovingAverageBank(std::span<const uint16_t> periods);
+        VolumeWeightedMovingAverageBank(std::span<const VolumeWeightedMovingAverageState> prevCalculations);
+        status update(std::span<const double> prices, std::span<const double> volume);
+        std::span<const double> latest();
+        size_t size();
+        /// As SimpleMovingAverageBank::getState(): an instrument still warming up is
+        /// reported as a fresh VWMA, with both buffers empty and its samples dropped.
+        VolumeWeightedMovingAverageState getState(size_t instrument);
+    };
+
+    /// Reduced-precision variants of the core indicators for large research grids.
+    /// Windows and outputs are stored as `Sample`; rolling sums and recurrence state
+    /// are kept in `Accum`. BasicSimpleMovingAverage<float> stores float but
+    /// accumulates in double; <float, float> is pure single precision and drifts
+    /// over long series (badly for WMA, whose weighted sum is a running difference).
+    /// Explicitly instantiated for float samples only; the double classes above
+    /// remain the reference implementation.
+    template <typename Sample, typename Accum = double>
+    class BasicSimpleMovingAverage {
+    private:
+        size_t period;
+        Accum alpha;
+        Accum rollingSum{0};
+        bool initialized{false};
+        Sample lastSma{0};
+        helpers::FixedRingBuffer<Sample> priceBuf;
+
+    public:
+        BasicSimpleMovingAverage(uint16_t period, std::vector<Sample> prevCalc = {});
+        status compute(std::span<const Sample> prices, std::vector<Sample>& output);
+        Sample update(Sample price);
+        Sample latest();
+    };
+
+    template <typename Sample, typename Accum = double>
+    class BasicExponentialMovingAverage {
+    private:
+        Accum alpha;
+        Accum oma;
+        Accum lastEma{0};
+        bool initialized{false};
+
+    public:
+        BasicExponentialMovingAverage(uint16_t period);
+        status compute(std::span<const Sample> prices, std::vector<Sample>& output);
+        Sample update(Sample price);
+        Sample latest();
+    };
+
+    template <typename Sample, typename Accum = double>
+    class BasicWeightedMovingAverage {
+    private:
+        size_t period;
+        Accum denominator;
+        Accum rollingSum{0};
+        Accum rollingWeightedSum{0};
+        bool initialized{false};
+        Sample lastWma{0};
+        helpers::FixedRingBuffer<Sample> priceBuf;
+
+    public:
+        BasicWeightedMovingAverage(uint16_t period, std::vector<Sample> prevCalc = {});
+        status compute(std::span<const Sample> prices, std::vector<Sample>& output);
+        Sample update(Sample price);
+        Sample latest();
+    };
+
+    template <typename Sample, typename Accum = double>
+    class BasicVolumeWeightedMovingAverage {
+    private:
+        size_t period;
+        Accum rollingNumerator{0};
+        Accum rollingDenominator{0};
+        bool initialized{false};
+        Sample lastCalculation{0};
+        helpers::FixedRingBuffer<Sample> priceBuf;
+        helpers::FixedRingBuffer<Sample> volumeBuf;
+
+    public:
+        BasicVolumeWeightedMovingAverage(uint16_t period, std::vector<Sample> prevPrices = {}, std::vector<Sample> prevVolume = {});
+        status compute(std::span<const Sample> prices, std::span<const Sample> volume, std::vector<Sample>& output);
+        Sample update(Sample price, Sample volume);
+        Sample latest();
+    };
+
+    /// SMA with the period fixed at compile time. The window lives inline in a
+    /// std::array and every method is header-inline, so update() can be inlined into
+    /// a strategy loop. Results follow SimpleMovingAverage(N) operation for operation
+    /// (bit-identical under the library's floating-point flags), and the state
+    /// converts to and from SimpleMovingAverageState.
+    template <uint16_t N>
+    class StaticSMA {
+        static_assert(N > 0, "period must be positive");
+
+    private:
+        static constexpr double alpha = 1.0 / static_cast<double>(N);
+
+        std::array<double, N> window{};
+        size_t next{0};     // oldest sample, overwritten by the next update
+        double rollingSum{0.0};
+        bool initialized{false};
+        double lastSma{0.0};
+
+    public:
+        /// @param prevCalc Optional warm-start buffer of the latest N prices, oldest first.
+        StaticSMA(std::span<const double> prevCalc = {}) {
+            if (!prevCalc.empty()) {
+                if (prevCalc.size() != N) {
+                    throw std::invalid_argument("prevCalc buffer doesn't match period");
+                }
+                std::copy(prevCalc.begin(), prevCalc.end(), this->window.begin());
+                this->rollingSum = helpers::simdSum(prevCalc);
+                this->lastSma = alpha * this->rollingSum;
+                this->initialized = true;
+            }
+        }
+
+        StaticSMA(const SimpleMovingAverageState& prevCalculation)
+            : rollingSum(prevCalculation.rollingSum),
+              initialized(prevCalculation.initialized),
+              lastSma(prevCalculation.lastSma) {
+            if (prevCalculation.period != N) {
+                throw std::invalid_argument("state period doesn't match StaticSMA period");
+            }
+            if (!prevCalculation.priceBuf.empty() && prevCalculation.priceBuf.size() != N) {
+                throw std::invalid_argument("priceBuf size doesn't match period");
+            }
+            if (this->initialized && prevCalculation.priceBuf.empty()) {
+                throw std::invalid_argument("initialized SMA state requires a full buffer");
+            }
+            std::copy(prevCalculation.priceBuf.begin(), prevCalculation.priceBuf.end(), this->window.begin());
+        }
+
+        status compute(std::span<const double> prices, std::vector<double>& output) {
+            if (prices.empty()) {
+                return status::emptyParams;
+            }
+            const size_t pricesLen = prices.size();
+
+            if (N >= pricesLen) {
+                return status::invalidParam;
+            }
+
+            if (output.size() < pricesLen) {
+                output.resize(pricesLen);
+            }
+            std::fill(output.begin(), output.begin() + N - 1, 0.0);
+
+            double sum = helpers::simdSum(prices.subspan(0, N));
+            output[N - 1] = alpha * sum;
+
+            for (size_t t = N; t < pricesLen; t++) {
+                sum += prices[t] - prices[t - N];
+                output[t] = alpha * sum;
+            }
+
+            std::copy(prices.end() - N, prices.end(), this->window.begin());
+            this->next = 0;
+            this->rollingSum = sum;
+            this->initialized = true;
+            this->lastSma = output.back();
+
+            return status::ok;
+        }
+
+        double update(double price) {
+            if (!this->initialized) {
+                throw std::runtime_error("sma not initialized");
+            }
+
+            this->rollingSum -= this->window[this->next];
+            this->rollingSum += price;
+            this->window[this->next] = price;
+            this->next = this->next + 1 == N ? 0 : this->next + 1;
+
+            this->lastSma = alpha * this->rollingSum;
+            return this->lastSma;
+        }
+
+        double latest() const {
+            return this->lastSma;
+        }
+
+        SimpleMovingAverageState getState() const {
+            SimpleMovingAverageState state{
+                .alpha = alpha,
+                .period = N,
+                .rollingSum = this->rollingSum,
+                .initialized = this->initialized,
+                .lastSma = this->lastSma,
+                .priceBuf = {}
+            };
+            if (this->initialized) {
+                state.priceBuf.reserve(N);
+                state.priceBuf.insert(state.priceBuf.end(), this->window.begin() + this->next, this->window.end());
+                state.priceBuf.insert(state.priceBuf.end(), this->window.begin(), this->window.begin() + this->next);
+            }
+            return state;
+        }
+    };
+
+    /// WMA with the period fixed at compile time; follows WeightedMovingAverage(N)
+    /// operation for operation and converts to and from its state. The denominator
+    /// is constexpr but still divided by, since a reciprocal multiply would round
+    /// differently from the dynamic class.
+    template <uint16_t N>
+    class StaticWMA {
+        static_assert(N > 0, "period must be positive");
+
+    private:
+        static constexpr double denominator = static_cast<double>(N) * static_cast<double>(N + 1) / 2.0;
+
+        std::array<double, N> window{};
+        size_t next{0};
+        size_t count{0};
+        double rollingSum{0.0};
+        double rollingWeightedSum{0.0};
+        bool initialized{false};
+        double lastWma{0.0};
+
+        template <uint16_t> friend class StaticHMA;
+
+        void reset() {
+            this->next = 0;
+            this->count = 0;
+            this->rollingSum = 0.0;
+            this->rollingWeightedSum = 0.0;
+        }
+
+        // Fills the window like compute()'s first loop; reports 0 until it is full.
+        double push(double price) {
+            if (this->count == N) {
+                return this->slide(price);
+            }
+
+            this->rollingSum += price;
+            this->rollingWeightedSum += price * static_cast<double>(this->count + 1);
+            this->window[this->count] = price;
+            this->count++;
+            if (this->count < N) {
+                return 0.0;
+            }
+
+            this->initialized = true;
+            this->lastWma = this->rollingWeightedSum / denominator;
+            return this->lastWma;
+        }
+
+        double slide(double price) {
+            const double oldSum = this->rollingSum;
+
+            this->rollingWeightedSum = this->rollingWeightedSum - oldSum + (price * static_cast<double>(N));
+            this->rollingSum = oldSum - this->window[this->next] + price;
+
+            this->window[this->next] = price;
+            this->next = this->next + 1 == N ? 0 : this->next + 1;
+
+            this->lastWma = this->rollingWeightedSum / denominator;
+            return this->lastWma;
+        }
+
+    public:
+        /// @param prevCalc Optional warm-start buffer of the latest N prices, oldest first.
+        StaticWMA(std::span<const double> prevCalc = {}) {
+            if (!prevCalc.empty()) {
+                if (prevCalc.size() != N) {
+                    throw std::invalid_argument("prevCalc buffer doesn't match period");
+                }
+                for (double price : prevCalc) {
+                    this->push(price);
+                }
+            }
+        }
+
+        StaticWMA(const WeightedMovingAverageState& prevCalculation)
+            : count(prevCalculation.priceBuf.size()),
+              rollingSum(prevCalculation.rollingSum),
+              rollingWeightedSum(prevCalculation.rollingWeightedSum),
+              initialized(prevCalculation.initialized),
+              lastWma(prevCalculation.lastWma) {
+            if (prevCalculation.period != N) {
+                throw std::invalid_argument("state period doesn't match StaticWMA period");
+            }
+            if (!prevCalculation.priceBuf.empty() && prevCalculation.priceBuf.size() != N) {
+                throw std::invalid_argument("priceBuf size doesn't match period");
+            }
+            if (this->initialized && prevCalculation.priceBuf.empty()) {
+                throw std::invalid_argument("initialized WMA state requires a full buffer");
+            }
+            std::copy(prevCalculation.priceBuf.begin(), prevCalculation.priceBuf.end(), this->window.begin());
+        }
+
+        status compute(std::span<const double> prices, std::vector<double>& output) {
+            const size_t n = prices.size();
+
+            if (n == 0) {
+                return status::emptyParams;
+            }
+            if (N > n) {
+                return status::invalidParam;
+            }
+
+            output.resize(n);
+            std::fill(output.begin(), output.begin() + N - 1, 0.0);
+
+            this->reset();
+            for (size_t t = 0; t + 1 < N; ++t) {
+                this->push(prices[t]);
+            }
+            output[N - 1] = this->push(prices[N - 1]);
+
+            for (size_t t = N; t < n; ++t) {
+                output[t] = this->slide(prices[t]);
+            }
+
+            return status::ok;
+        }
+
+        double update(double price) {
+            if (!this->initialized) {
+                throw std::runtime_error("wma not initialized");
+            }
+            return this->slide(price);
+        }
+
+        double latest() const {
+            return this->lastWma;
+        }
+
+        WeightedMovingAverageState getState() const {
+            WeightedMovingAverageState state{
+                .period = N,
+                .denominator = denominator,
+                .rollingSum = this->rollingSum,
+                .rollingWeightedSum = this->rollingWeightedSum,
+                .initialized = this->initialized,
+                .lastWma = this->lastWma,
+                .priceBuf = {}
+            };
+            if (this->count == N) {
+                state.priceBuf.reserve(N);
+                state.priceBuf.insert(state.priceBuf.end(), this->window.begin() + this->next, this->window.end());
+                state.priceBuf.insert(state.priceBuf.end(), this->window.begin(), this->window.begin() + this->next);
+            }
+            return state;
+        }
+    };
+
+    /// HMA with the period fixed at compile time, built from three StaticWMA windows.
+    /// Follows HullMovingAverage(N) operation for operation and converts to and from
+    /// its state.
+    template <uint16_t N>
+    class StaticHMA {
+        static_assert(N > 0, "period must be positive");
+
+    private:
+        // round(sqrt(n)) without libm: sqrt(n) >= k + 0.5 exactly when n > k * k + k.
+        static constexpr uint16_t rounded_sqrt(uint32_t n) {
+            uint32_t k = 0;
+            while ((k + 1) * (k + 1) <= n) {
+                k++;
+            }
+            return static_cast<uint16_t>(n > k * k + k ? k + 1 : k);
+        }
+
+        static constexpr uint16_t p1 = N / 2 > 1 ? N / 2 : 1;
+        static constexpr uint16_t p2 = rounded_sqrt(N) > 1 ? rounded_sqrt(N) : 1;
+
+        StaticWMA<p1> w1;
+        StaticWMA<N> w2;
+        StaticWMA<p2> w3;
+        double lastHull{0.0};
+        bool initialized{false};
+
+    public:
+        /// @param prevCalc Optional warm-start buffer of the latest N prices, oldest first.
+        StaticHMA(std::span<const double> prevCalc = {}) {
+            if (!prevCalc.empty()) {
+                if (prevCalc.size() != N) {
+                    throw std::invalid_argument("prevCalc buffer doesn't match period");
+                }
+                for (double price : prevCalc) {
+                    this->lastHull = this->w3.push(2.0 * this->w1.push(price) - this->w2.push(price));
+                }
+                this->initialized = true;
+            }
+        }
+
+        StaticHMA(const HullMovingAverageState& prevCalculation)
+            : w1(prevCalculation.w1),
+              w2(prevCalculation.w2),
+              w3(prevCalculation.w3),
+              lastHull(prevCalculation.lastHull),
+              initialized(prevCalculation.initialized) {
+            if (prevCalculation.period != N || prevCalculation.p1 != p1 || prevCalculation.p2 != p2) {
+                throw std::invalid_argument("state periods don't match StaticHMA period");
+            }
+        }
+
+        status compute(std::span<const double> prices, std::vector<double>& output) {
+            if (prices.empty()) {
+                return status::emptyParams;
+            }
+
+            const size_t pricesLen = prices.size();
+            if (N > pricesLen) {
+                return status::invalidParam;
+            }
+            if (output.size() < pricesLen) {
+                output.resize(pricesLen);
+            }
+            std::fill(output.begin(), output.begin() + (p2 - 1), 0.0);
+
+            this->w1.reset();
+            this->w2.reset();
+            this->w3.reset();
+            for (size_t t = 0; t < pricesLen; ++t) {
+                const double hull = this->w3.push(2.0 * this->w1.push(prices[t]) - this->w2.push(prices[t]));
+                if (t + 1 >= p2) {
+                    output[t] = hull;
+                }
+            }
+
+            this->lastHull = output[pricesLen - 1];
+            this->initialized = true;
+            return status::ok;
+        }
+
+        double update(double price) {
+            if (!this->initialized) {
+                throw std::runtime_error("hma not initialized");
+            }
+
+            const double a = this->w1.slide(price);
+            const double b = this->w2.slide(price);
+            this->lastHull = this->w3.slide(2 * a - b);
+            return this->lastHull;
+        }
+
+        double latest() const {
+            return this->lastHull;
+        }
+
+        HullMovingAverageState getState() const {
+            return {
+                .p1 = p1,
+                .p2 = p2,
+                .period = N,
+                .lastHull = this->lastHull,
+                .initialized = this->initialized,
+                .w1 = this->w1.getState(),
+                .w2 = this->w2.getState(),
+                .w3 = this->w3.getState()
+            };
+        }
+    };
+
     class KaufmanAdaptiveMovingAverage  {
         private:
     }; 
@@ -429,5 +1889,9 @@ namespace tama {
 
  } // namespace tama
 
-
-
+// Per-tick update()/latest() bodies. With TAMA_HEADER_INLINE they are defined
+// inline here so strategy loops can inline them; otherwise the library compiles
+// them in src/tama/inline.cpp.
+#ifdef TAMA_HEADER_INLINE
+#include <tama/inline.hpp>
+#endif
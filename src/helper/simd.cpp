@@ -1,57 +1,104 @@
 #include <helpers/helpers.hpp>
+#include <cstdlib>
+#include <string_view>
 
-#if defined(__aarch64__) || defined(_M_ARM64)
-#include <arm_neon.h>
-#elif defined(__x86_64__) || defined(_M_X64)
-#include <immintrin.h>
-#endif
+#include "simd_kernels.hpp"
 
-double helpers::simdSum(std::span<const double> elms) {
-    double sum = 0.0;
-    const size_t n = elms.size();
+namespace {
+    helpers::simdIsa detect_isa() {
+        #if defined(__aarch64__) || defined(_M_ARM64)
+            return helpers::simdIsa::neon;
+        #elif defined(__x86_64__) || defined(_M_X64)
+            __builtin_cpu_init();
+            helpers::simdIsa isa = helpers::simdIsa::sse2;
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+                isa = helpers::simdIsa::avx2;
+                if (__builtin_cpu_supports("avx512f")) {
+                    isa = helpers::simdIsa::avx512;
+                }
+            }
 
-    if (n == 0) {
-        return 0.0;
+            // TAMA_SIMD_ISA can only lower the choice, never ask for more than the CPU has.
+            if (const char* cap = std::getenv("TAMA_SIMD_ISA")) {
+                const std::string_view requested(cap);
+                if (requested == "sse2") {
+                    isa = helpers::simdIsa::sse2;
+                } else if (requested == "avx2" && isa == helpers::simdIsa::avx512) {
+                    isa = helpers::simdIsa::avx2;
+                }
+            }
+            return isa;
+        #else
+            return helpers::simdIsa::scalar;
+        #endif
     }
 
-    size_t i = 0;
+    struct Dispatch {
+        helpers::simdIsa isa;
+        const helpers::kernels::Table* table;
+    };
 
-    #if defined(__aarch64__) || defined(_M_ARM64)
-        if (n < 2) {
-            for (; i < n; i++) {
-                sum += elms[i];
+    Dispatch resolve() {
+        const helpers::simdIsa isa = detect_isa();
+        #if defined(__x86_64__) || defined(_M_X64)
+            if (isa == helpers::simdIsa::avx512) {
+                return {isa, &helpers::kernels::avx512};
             }
-            return sum;
-        }
-
-        float64x2_t acc = vdupq_n_f64(0);
-        for (; i + 2 <= n; i += 2) {
-            acc = vaddq_f64(acc, vld1q_f64(&elms[i]));
-        }
-        sum += vaddvq_f64(acc);
-    #elif defined(__x86_64__) || defined(_M_X64)
-        if (n < 4) {
-            for (; i < n; i++) {
-                sum += elms[i];
+            if (isa == helpers::simdIsa::avx2) {
+                return {isa, &helpers::kernels::avx2};
             }
-            return sum;
-        }
+        #endif
+        return {isa, &helpers::kernels::baseline};
+    }
 
-        __m256d acc = _mm256_setzero_pd();
-        for (; i + 4 <= n; i += 4) {
-            acc = _mm256_add_pd(acc, _mm256_loadu_pd(&elms[i]));
-        }
+    // Resolved once; afterwards each call costs one indirect branch.
+    const Dispatch& dispatch() {
+        static const Dispatch active = resolve();
+        return active;
+    }
+}
 
-        __m128d lo = _mm256_castpd256_pd128(acc);
-        __m128d hi = _mm256_extractf128_pd(acc, 1);
-        __m128d sum2 = _mm_add_pd(lo, hi);
+helpers::simdIsa helpers::activeSimdIsa() {
+    return dispatch().isa;
+}
 
-        sum += _mm_cvtsd_f64(_mm_hadd_pd(sum2, sum2));
-    #endif
+double helpers::simdSum(std::span<const double> elms) {
+    return dispatch().table->sum(elms.data(), elms.size());
+}
+
+void helpers::simdEmaStep(std::span<double> state, std::span<const double> alpha, std::span<const double> oma, std::span<const double> x) {
+    dispatch().table->emaStep(state.data(), alpha.data(), oma.data(), x.data(), state.size());
+}
 
-    for (; i < n; i++) {
-        sum += elms[i];
+void helpers::simdMdStep(std::span<double> state, std::span<const double> invPeriod, std::span<const double> x) {
+    dispatch().table->mdStep(state.data(), invPeriod.data(), x.data(), state.size());
+}
+
+void helpers::simdEmaCascade(std::span<const double> prices, std::span<const double> alpha, std::span<const double> oma, std::span<const double> coefficients, size_t depth, std::span<double> output, size_t timeStride, size_t laneStride, std::span<double> lastStates, std::span<const double> initialStates) {
+    if (prices.empty() || alpha.empty()) {
+        return;
     }
 
-    return sum;
+    if (depth < 1 || depth > 3) {
+        throw std::invalid_argument("invalid cascade depth");
+    }
+
+    double* last = lastStates.empty() ? nullptr : lastStates.data();
+    const double* initial = initialStates.empty() ? nullptr : initialStates.data();
+    dispatch().table->emaCascade[depth - 1](prices.data(), prices.size(), alpha.data(), oma.data(), coefficients.data(), alpha.size(), output.data(), timeStride, laneStride, last, initial);
+}
+
+double helpers::simdEmaScan(std::span<const double> x, double alpha, double oma, double carry, std::span<double> out) {
+    return dispatch().table->emaScan(x.data(), x.size(), alpha, oma, carry, out.data());
+}
+
+double helpers::simdWindowScan(std::span<const double> x, std::span<const double> old, double scale, double carry, std::span<double> out) {
+    return dispatch().table->windowScan(x.data(), old.data(), x.size(), scale, carry, out.data());
+}
+
+void helpers::simdWeightedWindowScan(std::span<const double> x, std::span<const double> old, double period, double denominator, double& sum, double& weightedSum, std::span<double> out) {
+    double sums[2] = {sum, weightedSum};
+    dispatch().table->weightedWindowScan(x.data(), old.data(), x.size(), period, denominator, sums, out.data());
+    sum = sums[0];
+    weightedSum = sums[1];
 }
@@ -0,0 +1,6 @@
+// Built with -mavx512f -mavx2 -mfma; only reached when the CPU reports all three.
+#if defined(__x86_64__) || defined(_M_X64)
+#include "simd_kernels_impl.hpp"
+
+const helpers::kernels::Table helpers::kernels::avx512 = table;
+#endif
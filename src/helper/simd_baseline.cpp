@@ -0,0 +1,4 @@
+// Built without AVX so the table runs on any CPU of the target architecture.
+#include "simd_kernels_impl.hpp"
+
+const helpers::kernels::Table helpers::kernels::baseline = table;
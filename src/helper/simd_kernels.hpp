@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+
+// Kernel tables behind the helpers::simd* entry points. Each table is defined in
+// its own translation unit, compiled for the instruction set it is named after;
+// simd.cpp picks one at first use from the running CPU's features.
+namespace helpers::kernels {
+    using CascadeFn = void (*)(const double* prices, size_t n, const double* alpha, const double* oma, const double* coefficients, size_t lanes, double* output, size_t timeStride, size_t laneStride, double* lastStates, const double* initialStates);
+
+    struct Table {
+        double (*sum)(const double* x, size_t n);
+        void (*emaStep)(double* state, const double* alpha, const double* oma, const double* x, size_t n);
+        void (*mdStep)(double* state, const double* invPeriod, const double* x, size_t n);
+        // Indexed by cascade depth - 1.
+        CascadeFn emaCascade[3];
+        double (*emaScan)(const double* x, size_t n, double alpha, double oma, double carry, double* out);
+        double (*windowScan)(const double* x, const double* old, size_t n, double scale, double carry, double* out);
+        // `sums` holds {sum, weightedSum} on entry and is advanced in place.
+        void (*weightedWindowScan)(const double* x, const double* old, size_t n, double period, double denominator, double* sums, double* out);
+    };
+
+    // SSE2 on x86-64, NEON on AArch64, scalar elsewhere.
+    extern const Table baseline;
+
+#if defined(__x86_64__) || defined(_M_X64)
+    extern const Table avx2;
+    extern const Table avx512;
+#endif
+}
@@ -0,0 +1,612 @@
+#pragma once
+
+// Kernel bodies shared by the per-ISA translation units. Each unit includes this
+// once; the preprocessor picks the widest path its compile flags allow. Everything
+// here has internal linkage and works on raw pointers so no inline function from
+// another header gets instantiated with a wider instruction set than its caller.
+
+#include "simd_kernels.hpp"
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#elif defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace {
+    double simd_sum(const double* x, size_t n) {
+        double sum = 0.0;
+        size_t i = 0;
+
+        #if defined(__aarch64__) || defined(_M_ARM64)
+            if (n >= 2) {
+                float64x2_t acc = vdupq_n_f64(0);
+                for (; i + 2 <= n; i += 2) {
+                    acc = vaddq_f64(acc, vld1q_f64(x + i));
+                }
+                sum += vaddvq_f64(acc);
+            }
+        #elif defined(__AVX512F__)
+            if (n >= 8) {
+                __m512d acc = _mm512_setzero_pd();
+                for (; i + 8 <= n; i += 8) {
+                    acc = _mm512_add_pd(acc, _mm512_loadu_pd(x + i));
+                }
+                sum += _mm512_reduce_add_pd(acc);
+            }
+        #elif defined(__AVX2__)
+            if (n >= 4) {
+                __m256d acc = _mm256_setzero_pd();
+                for (; i + 4 <= n; i += 4) {
+                    acc = _mm256_add_pd(acc, _mm256_loadu_pd(x + i));
+                }
+
+                __m128d lo = _mm256_castpd256_pd128(acc);
+                __m128d hi = _mm256_extractf128_pd(acc, 1);
+                __m128d sum2 = _mm_add_pd(lo, hi);
+
+                sum += _mm_cvtsd_f64(_mm_hadd_pd(sum2, sum2));
+            }
+        #elif defined(__SSE2__)
+            if (n >= 2) {
+                __m128d acc = _mm_setzero_pd();
+                for (; i + 2 <= n; i += 2) {
+                    acc = _mm_add_pd(acc, _mm_loadu_pd(x + i));
+                }
+                sum += _mm_cvtsd_f64(_mm_add_sd(acc, _mm_unpackhi_pd(acc, acc)));
+            }
+        #endif
+
+        for (; i < n; i++) {
+            sum += x[i];
+        }
+
+        return sum;
+    }
+
+    void ema_step(double* state, const double* alpha, const double* oma, const double* x, size_t n) {
+        size_t i = 0;
+
+        #if defined(__aarch64__) || defined(_M_ARM64)
+            for (; i + 2 <= n; i += 2) {
+                float64x2_t s = vmulq_f64(vld1q_f64(oma + i), vld1q_f64(state + i));
+                s = vaddq_f64(vmulq_f64(vld1q_f64(alpha + i), vld1q_f64(x + i)), s);
+                vst1q_f64(state + i, s);
+            }
+        #elif defined(__AVX512F__)
+            for (; i + 8 <= n; i += 8) {
+                __m512d s = _mm512_mul_pd(_mm512_loadu_pd(oma + i), _mm512_loadu_pd(state + i));
+                s = _mm512_add_pd(_mm512_mul_pd(_mm512_loadu_pd(alpha + i), _mm512_loadu_pd(x + i)), s);
+                _mm512_storeu_pd(state + i, s);
+            }
+        #elif defined(__AVX2__)
+            for (; i + 4 <= n; i += 4) {
+                __m256d s = _mm256_mul_pd(_mm256_loadu_pd(oma + i), _mm256_loadu_pd(state + i));
+                s = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(alpha + i), _mm256_loadu_pd(x + i)), s);
+                _mm256_storeu_pd(state + i, s);
+            }
+        #elif defined(__SSE2__)
+            for (; i + 2 <= n; i += 2) {
+                __m128d s = _mm_mul_pd(_mm_loadu_pd(oma + i), _mm_loadu_pd(state + i));
+                s = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(alpha + i), _mm_loadu_pd(x + i)), s);
+                _mm_storeu_pd(state + i, s);
+            }
+        #endif
+
+        for (; i < n; i++) {
+            state[i] = alpha[i] * x[i] + oma[i] * state[i];
+        }
+    }
+
+    void md_step(double* state, const double* invPeriod, const double* x, size_t n) {
+        size_t i = 0;
+
+        #if defined(__aarch64__) || defined(_M_ARM64)
+            const float64x2_t one = vdupq_n_f64(1.0);
+            for (; i + 2 <= n; i += 2) {
+                const float64x2_t p = vld1q_f64(x + i);
+                const float64x2_t m = vld1q_f64(state + i);
+                const float64x2_t r = vmulq_f64(m, vdivq_f64(one, p));
+                const float64x2_t r2 = vmulq_f64(r, r);
+                const float64x2_t step = vmulq_f64(vmulq_f64(vsubq_f64(p, m), vld1q_f64(invPeriod + i)), vmulq_f64(r2, r2));
+                vst1q_f64(state + i, vaddq_f64(step, m));
+            }
+        #elif defined(__AVX512F__)
+            const __m512d one = _mm512_set1_pd(1.0);
+            for (; i + 8 <= n; i += 8) {
+                const __m512d p = _mm512_loadu_pd(x + i);
+                const __m512d m = _mm512_loadu_pd(state + i);
+                const __m512d r = _mm512_mul_pd(m, _mm512_div_pd(one, p));
+                const __m512d r2 = _mm512_mul_pd(r, r);
+                const __m512d step = _mm512_mul_pd(_mm512_mul_pd(_mm512_sub_pd(p, m), _mm512_loadu_pd(invPeriod + i)), _mm512_mul_pd(r2, r2));
+                _mm512_storeu_pd(state + i, _mm512_add_pd(step, m));
+            }
+        #elif defined(__AVX2__)
+            const __m256d one = _mm256_set1_pd(1.0);
+            for (; i + 4 <= n; i += 4) {
+                const __m256d p = _mm256_loadu_pd(x + i);
+                const __m256d m = _mm256_loadu_pd(state + i);
+                const __m256d r = _mm256_mul_pd(m, _mm256_div_pd(one, p));
+                const __m256d r2 = _mm256_mul_pd(r, r);
+                const __m256d step = _mm256_mul_pd(_mm256_mul_pd(_mm256_sub_pd(p, m), _mm256_loadu_pd(invPeriod + i)), _mm256_mul_pd(r2, r2));
+                _mm256_storeu_pd(state + i, _mm256_add_pd(step, m));
+            }
+        #elif defined(__SSE2__)
+            const __m128d one = _mm_set1_pd(1.0);
+            for (; i + 2 <= n; i += 2) {
+                const __m128d p = _mm_loadu_pd(x + i);
+                const __m128d m = _mm_loadu_pd(state + i);
+                const __m128d r = _mm_mul_pd(m, _mm_div_pd(one, p));
+                const __m128d r2 = _mm_mul_pd(r, r);
+                const __m128d step = _mm_mul_pd(_mm_mul_pd(_mm_sub_pd(p, m), _mm_loadu_pd(invPeriod + i)), _mm_mul_pd(r2, r2));
+                _mm_storeu_pd(state + i, _mm_add_pd(step, m));
+            }
+        #endif
+
+        for (; i < n; i++) {
+            const double r = state[i] * (1.0 / x[i]);
+            const double r2 = r * r;
+            state[i] = (x[i] - state[i]) * invPeriod[i] * (r2 * r2) + state[i];
+        }
+    }
+
+    template <size_t Depth>
+    void ema_cascade_lane(const double* prices, size_t n, double alpha, double oma, const double* c, double* out, size_t timeStride, double* last, size_t lastStride, const double* init) {
+        const bool resumed = init != nullptr;
+        double e1 = resumed ? init[0] : prices[0];
+        double e2 = resumed && Depth > 1 ? init[lastStride] : prices[0];
+        double e3 = resumed && Depth > 2 ? init[2 * lastStride] : prices[0];
+
+        for (size_t t = 0; t < n; t++) {
+            if (t > 0 || resumed) {
+                e1 = alpha * prices[t] + oma * e1;
+                if constexpr (Depth > 1) {
+                    e2 = alpha * e1 + oma * e2;
+                }
+                if constexpr (Depth > 2) {
+                    e3 = alpha * e2 + oma * e3;
+                }
+            }
+
+            double value = c[0] * e1;
+            if constexpr (Depth > 1) {
+                value += c[1] * e2;
+            }
+            if constexpr (Depth > 2) {
+                value += c[2] * e3;
+            }
+            out[t * timeStride] = value;
+        }
+
+        if (last != nullptr) {
+            last[0] = e1;
+            if constexpr (Depth > 1) {
+                last[lastStride] = e2;
+            }
+            if constexpr (Depth > 2) {
+                last[2 * lastStride] = e3;
+            }
+        }
+    }
+
+    template <size_t Depth>
+    void ema_cascade(const double* prices, size_t n, const double* alpha, const double* oma, const double* coefficients, size_t lanes, double* output, size_t timeStride, size_t laneStride, double* lastStates, const double* initialStates) {
+        const bool resumed = initialStates != nullptr;
+        size_t l = 0;
+
+        #if defined(__aarch64__) || defined(_M_ARM64)
+            for (; l + 2 <= lanes; l += 2) {
+                const float64x2_t a = vld1q_f64(alpha + l);
+                const float64x2_t o = vld1q_f64(oma + l);
+                const float64x2_t c1 = vld1q_f64(coefficients + l);
+                const float64x2_t c2 = Depth > 1 ? vld1q_f64(coefficients + lanes + l) : vdupq_n_f64(0);
+                const float64x2_t c3 = Depth > 2 ? vld1q_f64(coefficients + 2 * lanes + l) : vdupq_n_f64(0);
+
+                float64x2_t e1 = resumed ? vld1q_f64(initialStates + l) : vdupq_n_f64(prices[0]);
+                float64x2_t e2 = resumed && Depth > 1 ? vld1q_f64(initialStates + lanes + l) : e1;
+                float64x2_t e3 = resumed && Depth > 2 ? vld1q_f64(initialStates + 2 * lanes + l) : e1;
+
+                for (size_t t = 0; t < n; t++) {
+                    if (t > 0 || resumed) {
+                        e1 = vaddq_f64(vmulq_f64(a, vdupq_n_f64(prices[t])), vmulq_f64(o, e1));
+                        if constexpr (Depth > 1) {
+                            e2 = vaddq_f64(vmulq_f64(a, e1), vmulq_f64(o, e2));
+                        }
+                        if constexpr (Depth > 2) {
+                            e3 = vaddq_f64(vmulq_f64(a, e2), vmulq_f64(o, e3));
+                        }
+                    }
+
+                    float64x2_t value = vmulq_f64(c1, e1);
+                    if constexpr (Depth > 1) {
+                        value = vaddq_f64(value, vmulq_f64(c2, e2));
+                    }
+                    if constexpr (Depth > 2) {
+                        value = vaddq_f64(value, vmulq_f64(c3, e3));
+                    }
+
+                    double* out = output + t * timeStride + l * laneStride;
+                    if (laneStride == 1) {
+                        vst1q_f64(out, value);
+                    } else {
+                        out[0] = vgetq_lane_f64(value, 0);
+                        out[laneStride] = vgetq_lane_f64(value, 1);
+                    }
+                }
+
+                if (lastStates != nullptr) {
+                    vst1q_f64(lastStates + l, e1);
+                    if constexpr (Depth > 1) {
+                        vst1q_f64(lastStates + lanes + l, e2);
+                    }
+                    if constexpr (Depth > 2) {
+                        vst1q_f64(lastStates + 2 * lanes + l, e3);
+                    }
+                }
+            }
+        #elif defined(__x86_64__) || defined(_M_X64)
+            #if defined(__AVX512F__)
+            for (; l + 8 <= lanes; l += 8) {
+                const __m512d a = _mm512_loadu_pd(alpha + l);
+                const __m512d o = _mm512_loadu_pd(oma + l);
+                const __m512d c1 = _mm512_loadu_pd(coefficients + l);
+                const __m512d c2 = Depth > 1 ? _mm512_loadu_pd(coefficients + lanes + l) : _mm512_setzero_pd();
+                const __m512d c3 = Depth > 2 ? _mm512_loadu_pd(coefficients + 2 * lanes + l) : _mm512_setzero_pd();
+
+                __m512d e1 = resumed ? _mm512_loadu_pd(initialStates + l) : _mm512_set1_pd(prices[0]);
+                __m512d e2 = resumed && Depth > 1 ? _mm512_loadu_pd(initialStates + lanes + l) : e1;
+                __m512d e3 = resumed && Depth > 2 ? _mm512_loadu_pd(initialStates + 2 * lanes + l) : e1;
+
+                for (size_t t = 0; t < n; t++) {
+                    if (t > 0 || resumed) {
+                        e1 = _mm512_add_pd(_mm512_mul_pd(a, _mm512_set1_pd(prices[t])), _mm512_mul_pd(o, e1));
+                        if constexpr (Depth > 1) {
+                            e2 = _mm512_add_pd(_mm512_mul_pd(a, e1), _mm512_mul_pd(o, e2));
+                        }
+                        if constexpr (Depth > 2) {
+                            e3 = _mm512_add_pd(_mm512_mul_pd(a, e2), _mm512_mul_pd(o, e3));
+                        }
+                    }
+
+                    __m512d value = _mm512_mul_pd(c1, e1);
+                    if constexpr (Depth > 1) {
+                        value = _mm512_add_pd(value, _mm512_mul_pd(c2, e2));
+                    }
+                    if constexpr (Depth > 2) {
+                        value = _mm512_add_pd(value, _mm512_mul_pd(c3, e3));
+                    }
+
+                    double* out = output + t * timeStride + l * laneStride;
+                    if (laneStride == 1) {
+                        _mm512_storeu_pd(out, value);
+                    } else {
+                        alignas(64) double lanesOut[8];
+                        _mm512_store_pd(lanesOut, value);
+                        for (size_t k = 0; k < 8; k++) {
+                            out[k * laneStride] = lanesOut[k];
+                        }
+                    }
+                }
+
+                if (lastStates != nullptr) {
+                    _mm512_storeu_pd(lastStates + l, e1);
+                    if constexpr (Depth > 1) {
+                        _mm512_storeu_pd(lastStates + lanes + l, e2);
+                    }
+                    if constexpr (Depth > 2) {
+                        _mm512_storeu_pd(lastStates + 2 * lanes + l, e3);
+                    }
+                }
+            }
+            #endif
+
+            #if defined(__AVX2__)
+            for (; l + 4 <= lanes; l += 4) {
+                const __m256d a = _mm256_loadu_pd(alpha + l);
+                const __m256d o = _mm256_loadu_pd(oma + l);
+                const __m256d c1 = _mm256_loadu_pd(coefficients + l);
+                const __m256d c2 = Depth > 1 ? _mm256_loadu_pd(coefficients + lanes + l) : _mm256_setzero_pd();
+                const __m256d c3 = Depth > 2 ? _mm256_loadu_pd(coefficients + 2 * lanes + l) : _mm256_setzero_pd();
+
+                __m256d e1 = resumed ? _mm256_loadu_pd(initialStates + l) : _mm256_set1_pd(prices[0]);
+                __m256d e2 = resumed && Depth > 1 ? _mm256_loadu_pd(initialStates + lanes + l) : e1;
+                __m256d e3 = resumed && Depth > 2 ? _mm256_loadu_pd(initialStates + 2 * lanes + l) : e1;
+
+                for (size_t t = 0; t < n; t++) {
+                    if (t > 0 || resumed) {
+                        e1 = _mm256_add_pd(_mm256_mul_pd(a, _mm256_set1_pd(prices[t])), _mm256_mul_pd(o, e1));
+                        if constexpr (Depth > 1) {
+                            e2 = _mm256_add_pd(_mm256_mul_pd(a, e1), _mm256_mul_pd(o, e2));
+                        }
+                        if constexpr (Depth > 2) {
+                            e3 = _mm256_add_pd(_mm256_mul_pd(a, e2), _mm256_mul_pd(o, e3));
+                        }
+                    }
+
+                    __m256d value = _mm256_mul_pd(c1, e1);
+                    if constexpr (Depth > 1) {
+                        value = _mm256_add_pd(value, _mm256_mul_pd(c2, e2));
+                    }
+                    if constexpr (Depth > 2) {
+                        value = _mm256_add_pd(value, _mm256_mul_pd(c3, e3));
+                    }
+
+                    double* out = output + t * timeStride + l * laneStride;
+                    if (laneStride == 1) {
+                        _mm256_storeu_pd(out, value);
+                    } else {
+                        alignas(32) double lanesOut[4];
+                        _mm256_store_pd(lanesOut, value);
+                        out[0] = lanesOut[0];
+                        out[laneStride] = lanesOut[1];
+                        out[2 * laneStride] = lanesOut[2];
+                        out[3 * laneStride] = lanesOut[3];
+                    }
+                }
+
+                if (lastStates != nullptr) {
+                    _mm256_storeu_pd(lastStates + l, e1);
+                    if constexpr (Depth > 1) {
+                        _mm256_storeu_pd(lastStates + lanes + l, e2);
+                    }
+                    if constexpr (Depth > 2) {
+                        _mm256_storeu_pd(lastStates + 2 * lanes + l, e3);
+                    }
+                }
+            }
+            #endif
+
+            for (; l + 2 <= lanes; l += 2) {
+                const __m128d a = _mm_loadu_pd(alpha + l);
+                const __m128d o = _mm_loadu_pd(oma + l);
+                const __m128d c1 = _mm_loadu_pd(coefficients + l);
+                const __m128d c2 = Depth > 1 ? _mm_loadu_pd(coefficients + lanes + l) : _mm_setzero_pd();
+                const __m128d c3 = Depth > 2 ? _mm_loadu_pd(coefficients + 2 * lanes + l) : _mm_setzero_pd();
+
+                __m128d e1 = resumed ? _mm_loadu_pd(initialStates + l) : _mm_set1_pd(prices[0]);
+                __m128d e2 = resumed && Depth > 1 ? _mm_loadu_pd(initialStates + lanes + l) : e1;
+                __m128d e3 = resumed && Depth > 2 ? _mm_loadu_pd(initialStates + 2 * lanes + l) : e1;
+
+                for (size_t t = 0; t < n; t++) {
+                    if (t > 0 || resumed) {
+                        e1 = _mm_add_pd(_mm_mul_pd(a, _mm_set1_pd(prices[t])), _mm_mul_pd(o, e1));
+                        if constexpr (Depth > 1) {
+                            e2 = _mm_add_pd(_mm_mul_pd(a, e1), _mm_mul_pd(o, e2));
+                        }
+                        if constexpr (Depth > 2) {
+                            e3 = _mm_add_pd(_mm_mul_pd(a, e2), _mm_mul_pd(o, e3));
+                        }
+                    }
+
+                    __m128d value = _mm_mul_pd(c1, e1);
+                    if constexpr (Depth > 1) {
+                        value = _mm_add_pd(value, _mm_mul_pd(c2, e2));
+                    }
+                    if constexpr (Depth > 2) {
+                        value = _mm_add_pd(value, _mm_mul_pd(c3, e3));
+                    }
+
+                    double* out = output + t * timeStride + l * laneStride;
+                    if (laneStride == 1) {
+                        _mm_storeu_pd(out, value);
+                    } else {
+                        _mm_storel_pd(out, value);
+                        _mm_storeh_pd(out + laneStride, value);
+                    }
+                }
+
+                if (lastStates != nullptr) {
+                    _mm_storeu_pd(lastStates + l, e1);
+                    if constexpr (Depth > 1) {
+                        _mm_storeu_pd(lastStates + lanes + l, e2);
+                    }
+                    if constexpr (Depth > 2) {
+                        _mm_storeu_pd(lastStates + 2 * lanes + l, e3);
+                    }
+                }
+            }
+        #endif
+
+        for (; l < lanes; l++) {
+            const double c[3] = {
+                coefficients[l],
+                Depth > 1 ? coefficients[lanes + l] : 0.0,
+                Depth > 2 ? coefficients[2 * lanes + l] : 0.0
+            };
+            double* last = lastStates == nullptr ? nullptr : lastStates + l;
+            ema_cascade_lane<Depth>(prices, n, alpha[l], oma[l], c, output + l * laneStride, timeStride, last, lanes, resumed ? initialStates + l : nullptr);
+        }
+    }
+
+    double ema_scan(const double* x, size_t n, double alpha, double oma, double carry, double* out) {
+        size_t i = 0;
+
+        #if defined(__aarch64__) || defined(_M_ARM64)
+            const float64x2_t a = vdupq_n_f64(alpha);
+            const float64x2_t o = vdupq_n_f64(oma);
+            const double omaPowers[2] = {oma, oma * oma};
+            const float64x2_t carryScale = vld1q_f64(omaPowers);
+            const float64x2_t zero = vdupq_n_f64(0);
+
+            for (; i + 2 <= n; i += 2) {
+                float64x2_t v = vmulq_f64(a, vld1q_f64(x + i));
+                v = vaddq_f64(v, vmulq_f64(o, vextq_f64(zero, v, 1)));
+                v = vaddq_f64(v, vmulq_f64(carryScale, vdupq_n_f64(carry)));
+                vst1q_f64(out + i, v);
+                carry = vgetq_lane_f64(v, 1);
+            }
+        #elif defined(__AVX2__)
+            const __m256d a = _mm256_set1_pd(alpha);
+            const __m256d o = _mm256_set1_pd(oma);
+            const __m256d o2 = _mm256_set1_pd(oma * oma);
+            const __m256d carryScale = _mm256_setr_pd(oma, oma * oma, oma * oma * oma, oma * oma * oma * oma);
+            const __m256d zero = _mm256_setzero_pd();
+
+            for (; i + 4 <= n; i += 4) {
+                // Local scan of four samples from a zero carry: shift by one, then by two.
+                __m256d v = _mm256_mul_pd(a, _mm256_loadu_pd(x + i));
+                __m256d shifted = _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0b0001);
+                v = _mm256_add_pd(v, _mm256_mul_pd(o, shifted));
+                shifted = _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0b0011);
+                v = _mm256_add_pd(v, _mm256_mul_pd(o2, shifted));
+
+                v = _mm256_add_pd(v, _mm256_mul_pd(carryScale, _mm256_set1_pd(carry)));
+                _mm256_storeu_pd(out + i, v);
+                carry = _mm256_cvtsd_f64(_mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 3, 3, 3)));
+            }
+        #elif defined(__SSE2__)
+            const __m128d a = _mm_set1_pd(alpha);
+            const __m128d o = _mm_set1_pd(oma);
+            const __m128d carryScale = _mm_setr_pd(oma, oma * oma);
+            const __m128d zero = _mm_setzero_pd();
+
+            for (; i + 2 <= n; i += 2) {
+                __m128d v = _mm_mul_pd(a, _mm_loadu_pd(x + i));
+                v = _mm_add_pd(v, _mm_mul_pd(o, _mm_unpacklo_pd(zero, v)));
+                v = _mm_add_pd(v, _mm_mul_pd(carryScale, _mm_set1_pd(carry)));
+                _mm_storeu_pd(out + i, v);
+                carry = _mm_cvtsd_f64(_mm_unpackhi_pd(v, v));
+            }
+        #endif
+
+        for (; i < n; i++) {
+            carry = alpha * x[i] + oma * carry;
+            out[i] = carry;
+        }
+
+        return carry;
+    }
+
+    // Inclusive prefix sums within one register: shift by one lane and add, then by two.
+    #if defined(__aarch64__) || defined(_M_ARM64)
+    float64x2_t prefix_sum(float64x2_t v) {
+        return vaddq_f64(v, vextq_f64(vdupq_n_f64(0), v, 1));
+    }
+    #elif defined(__AVX2__)
+    __m256d prefix_sum(__m256d v) {
+        const __m256d zero = _mm256_setzero_pd();
+        v = _mm256_add_pd(v, _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0b0001));
+        return _mm256_add_pd(v, _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0b0011));
+    }
+    #elif defined(__SSE2__)
+    __m128d prefix_sum(__m128d v) {
+        return _mm_add_pd(v, _mm_unpacklo_pd(_mm_setzero_pd(), v));
+    }
+    #endif
+
+    double window_scan(const double* x, const double* old, size_t n, double scale, double carry, double* out) {
+        size_t i = 0;
+
+        // The carry stays broadcast in a register; each vector adds it once.
+        #if defined(__aarch64__) || defined(_M_ARM64)
+            const float64x2_t k = vdupq_n_f64(scale);
+            float64x2_t c = vdupq_n_f64(carry);
+            for (; i + 2 <= n; i += 2) {
+                const float64x2_t sums = vaddq_f64(prefix_sum(vsubq_f64(vld1q_f64(x + i), vld1q_f64(old + i))), c);
+                vst1q_f64(out + i, vmulq_f64(k, sums));
+                c = vdupq_laneq_f64(sums, 1);
+            }
+            carry = vgetq_lane_f64(c, 0);
+        #elif defined(__AVX2__)
+            const __m256d k = _mm256_set1_pd(scale);
+            __m256d c = _mm256_set1_pd(carry);
+            for (; i + 4 <= n; i += 4) {
+                const __m256d sums = _mm256_add_pd(prefix_sum(_mm256_sub_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(old + i))), c);
+                _mm256_storeu_pd(out + i, _mm256_mul_pd(k, sums));
+                c = _mm256_permute4x64_pd(sums, _MM_SHUFFLE(3, 3, 3, 3));
+            }
+            carry = _mm256_cvtsd_f64(c);
+        #elif defined(__SSE2__)
+            const __m128d k = _mm_set1_pd(scale);
+            __m128d c = _mm_set1_pd(carry);
+            for (; i + 2 <= n; i += 2) {
+                const __m128d sums = _mm_add_pd(prefix_sum(_mm_sub_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(old + i))), c);
+                _mm_storeu_pd(out + i, _mm_mul_pd(k, sums));
+                c = _mm_unpackhi_pd(sums, sums);
+            }
+            carry = _mm_cvtsd_f64(c);
+        #endif
+
+        for (; i < n; i++) {
+            carry += x[i] - old[i];
+            out[i] = scale * carry;
+        }
+
+        return carry;
+    }
+
+    // weightedSum[t] = weightedSum[t - 1] + period * x[t] - sum[t - 1]: the second scan
+    // takes the first one's sums shifted down a lane, with the previous carry in front.
+    void weighted_window_scan(const double* x, const double* old, size_t n, double period, double denominator, double* sums, double* out) {
+        double sum = sums[0];
+        double weightedSum = sums[1];
+        size_t i = 0;
+
+        #if defined(__aarch64__) || defined(_M_ARM64)
+            const float64x2_t p = vdupq_n_f64(period);
+            const float64x2_t d = vdupq_n_f64(denominator);
+            float64x2_t s = vdupq_n_f64(sum);
+            float64x2_t w = vdupq_n_f64(weightedSum);
+            for (; i + 2 <= n; i += 2) {
+                const float64x2_t v = vld1q_f64(x + i);
+                const float64x2_t next = vaddq_f64(prefix_sum(vsubq_f64(v, vld1q_f64(old + i))), s);
+                const float64x2_t weighted = vaddq_f64(prefix_sum(vsubq_f64(vmulq_f64(p, v), vextq_f64(s, next, 1))), w);
+                vst1q_f64(out + i, vdivq_f64(weighted, d));
+                s = vdupq_laneq_f64(next, 1);
+                w = vdupq_laneq_f64(weighted, 1);
+            }
+            sum = vgetq_lane_f64(s, 0);
+            weightedSum = vgetq_lane_f64(w, 0);
+        #elif defined(__AVX2__)
+            const __m256d p = _mm256_set1_pd(period);
+            const __m256d d = _mm256_set1_pd(denominator);
+            __m256d s = _mm256_set1_pd(sum);
+            __m256d w = _mm256_set1_pd(weightedSum);
+            for (; i + 4 <= n; i += 4) {
+                const __m256d v = _mm256_loadu_pd(x + i);
+                const __m256d next = _mm256_add_pd(prefix_sum(_mm256_sub_pd(v, _mm256_loadu_pd(old + i))), s);
+                const __m256d previous = _mm256_blend_pd(_mm256_permute4x64_pd(next, _MM_SHUFFLE(2, 1, 0, 0)), s, 0b0001);
+                const __m256d weighted = _mm256_add_pd(prefix_sum(_mm256_sub_pd(_mm256_mul_pd(p, v), previous)), w);
+                _mm256_storeu_pd(out + i, _mm256_div_pd(weighted, d));
+                s = _mm256_permute4x64_pd(next, _MM_SHUFFLE(3, 3, 3, 3));
+                w = _mm256_permute4x64_pd(weighted, _MM_SHUFFLE(3, 3, 3, 3));
+            }
+            sum = _mm256_cvtsd_f64(s);
+            weightedSum = _mm256_cvtsd_f64(w);
+        #elif defined(__SSE2__)
+            const __m128d p = _mm_set1_pd(period);
+            const __m128d d = _mm_set1_pd(denominator);
+            __m128d s = _mm_set1_pd(sum);
+            __m128d w = _mm_set1_pd(weightedSum);
+            for (; i + 2 <= n; i += 2) {
+                const __m128d v = _mm_loadu_pd(x + i);
+                const __m128d next = _mm_add_pd(prefix_sum(_mm_sub_pd(v, _mm_loadu_pd(old + i))), s);
+                const __m128d weighted = _mm_add_pd(prefix_sum(_mm_sub_pd(_mm_mul_pd(p, v), _mm_shuffle_pd(s, next, 0b00))), w);
+                _mm_storeu_pd(out + i, _mm_div_pd(weighted, d));
+                s = _mm_unpackhi_pd(next, next);
+                w = _mm_unpackhi_pd(weighted, weighted);
+            }
+            sum = _mm_cvtsd_f64(s);
+            weightedSum = _mm_cvtsd_f64(w);
+        #endif
+
+        for (; i < n; i++) {
+            weightedSum += period * x[i] - sum;
+            sum += x[i] - old[i];
+            out[i] = weightedSum / denominator;
+        }
+
+        sums[0] = sum;
+        sums[1] = weightedSum;
+    }
+
+    constexpr helpers::kernels::Table table{
+        .sum = &simd_sum,
+        .emaStep = &ema_step,
+        .mdStep = &md_step,
+        .emaCascade = {&ema_cascade<1>, &ema_cascade<2>, &ema_cascade<3>},
+        .emaScan = &ema_scan,
+        .windowScan = &window_scan,
+        .weightedWindowScan = &weighted_window_scan
+    };
+}
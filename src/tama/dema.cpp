@@ -14,28 +14,15 @@ namespace {
 tama::DoubleExponentialMovingAverage::DoubleExponentialMovingAverage(uint16_t period, std::vector<double> prevCalc)
 	: period(static_cast<size_t>(require_period(period))),
 	  initialized(false),
-	  lastDema(0.0),
 	  ema1(period),
-	  ema2(period) {
+	  ema2(period),
+	  lastDema(0.0) {
 	if (!prevCalc.empty()) {
 		if (prevCalc.size() != this->period) {
 			throw std::invalid_argument("prevCalc buffer doesn't match period");
 		}
 
-		std::vector<double> emaAOut(prevCalc.size());
-		std::vector<double> emaBOut(prevCalc.size());
-
-		status res = this->ema1.compute(prevCalc, emaAOut);
-		if (res != status::ok) {
-			return;
-		}
-
-		res = this->ema2.compute(emaAOut, emaBOut);
-		if (res != status::ok) {
-			return;
-		}
-
-		this->lastDema = 2.0 * emaAOut.back() - emaBOut.back();
+		this->fusedCompute(prevCalc, std::span<double>(&this->lastDema, 1), 0);
 		this->initialized = true;
 	}
 }
@@ -43,63 +30,112 @@ tama::DoubleExponentialMovingAverage::DoubleExponentialMovingAverage(uint16_t pe
 tama::DoubleExponentialMovingAverage::DoubleExponentialMovingAverage(DoubleExponentialMovingAverageState prevCalculation)
 	: period(prevCalculation.period),
 	  initialized(prevCalculation.initialized),
-	  lastDema(prevCalculation.lastDema),
 	  ema1(prevCalculation.ema1),
-	  ema2(prevCalculation.ema2) {
+	  ema2(prevCalculation.ema2),
+	  lastDema(prevCalculation.lastDema) {
 	if (this->period == 0) {
 		throw std::invalid_argument("invalid period");
 	}
+
+	const ExponentialMovingAverageState stages[] = {prevCalculation.ema1, prevCalculation.ema2};
+	detail::requireCascadeStages(static_cast<double>(this->period), stages);
 }
 
-status tama::DoubleExponentialMovingAverage::compute(std::span<const double> prices, std::vector<double>& output) {
+status tama::DoubleExponentialMovingAverage::compute(std::span<const double> prices, std::vector<double>& output, computeMode mode) {
+	if (output.size() < prices.size()) {
+		output.resize(prices.size());
+	}
+	return this->compute(prices, std::span<double>(output), mode);
+}
+
+status tama::DoubleExponentialMovingAverage::compute(std::span<const double> prices, std::span<double> output, computeMode mode) {
 	if (prices.empty()) {
 		return status::emptyParams;
 	}
 
 	const size_t pricesLen = prices.size();
 	if (output.size() < pricesLen) {
-		output.resize(pricesLen);
+		return status::invalidParam;
 	}
 
-	std::vector<double> emaAOut(pricesLen);
-	std::vector<double> emaBOut(pricesLen);
+	this->fusedCompute(prices, output, 1, mode == computeMode::resume && this->initialized);
 
-	status res = this->ema1.compute(prices, emaAOut);
-	if (res != status::ok) {
-		return res;
-	}
+	this->lastDema = output[pricesLen - 1];
+	this->initialized = true;
 
-	res = this->ema2.compute(emaAOut, emaBOut);
-	if (res != status::ok) {
-		return res;
-	}
+	return status::ok;
+}
 
-	// simd
-	for (size_t i = 0; i < pricesLen; i++) {
-		output[i] = 2.0 * emaAOut[i] - emaBOut[i];
+status tama::DoubleExponentialMovingAverage::update(std::span<const double> prices, std::span<double> output) {
+	if (prices.empty()) {
+		return status::emptyParams;
+	}
+	if (output.size() < prices.size()) {
+		return status::invalidParam;
+	}
+	if (!this->initialized) {
+		detail::throwNotInitialized("dema");
 	}
 
-	this->lastDema = output.back();
-	this->initialized = true;
+	// The stage states stay in registers for the batch.
+	const double alpha1 = this->ema1.alpha;
+	const double oma1 = this->ema1.oma;
+	const double alpha2 = this->ema2.alpha;
+	const double oma2 = this->ema2.oma;
+	double e1 = this->ema1.lastEma;
+	double e2 = this->ema2.lastEma;
+	double before1 = e1;
+	double before2 = e2;
+	for (size_t t = 0; t < prices.size(); t++) {
+		before1 = e1;
+		before2 = e2;
+		e1 = alpha1 * prices[t] + oma1 * e1;
+		e2 = alpha2 * e1 + oma2 * e2;
+		output[t] = 2.0 * e1 - e2;
+	}
 
+	this->ema1.markStepped(before1);
+	this->ema2.markStepped(before2);
+	this->ema1.lastEma = e1;
+	this->ema2.lastEma = e2;
+	this->lastDema = output[prices.size() - 1];
 	return status::ok;
 }
 
-double tama::DoubleExponentialMovingAverage::update(double price) {
+status tama::DoubleExponentialMovingAverage::peek(std::span<const double> candidates, std::span<double> output) const {
+	if (candidates.empty()) {
+		return status::emptyParams;
+	}
+	if (output.size() < candidates.size()) {
+		return status::invalidParam;
+	}
 	if (!this->initialized) {
-		throw std::runtime_error("dema not initialized");
+		detail::throwNotInitialized("dema");
 	}
 
-	const double ema1Value = this->ema1.update(price);
-	const double ema2Value = this->ema2.update(ema1Value);
+	const double alpha1 = this->ema1.alpha;
+	const double oma1 = this->ema1.oma;
+	const double alpha2 = this->ema2.alpha;
+	const double oma2 = this->ema2.oma;
+	const double e1 = this->ema1.lastEma;
+	const double e2 = this->ema2.lastEma;
+	for (size_t i = 0; i < candidates.size(); i++) {
+		const double next1 = alpha1 * candidates[i] + oma1 * e1;
+		const double next2 = alpha2 * next1 + oma2 * e2;
+		output[i] = 2.0 * next1 - next2;
+	}
+	return status::ok;
+}
 
-	const double dema = 2.0 * ema1Value - ema2Value;
-	this->lastDema = dema;
-	return dema;
+tama::DoubleExponentialMovingAverage tama::DoubleExponentialMovingAverage::fork() const {
+	return *this;
 }
 
-double tama::DoubleExponentialMovingAverage::latest() {
-	return this->lastDema;
+void tama::DoubleExponentialMovingAverage::fusedCompute(std::span<const double> prices, std::span<double> output, size_t timeStride, bool resume) {
+	ExponentialMovingAverage* const stages[2] = {&this->ema1, &this->ema2};
+	const double coefficients[2] = {2.0, -1.0};
+
+	ExponentialMovingAverage::cascade(stages, coefficients, prices, output, timeStride, resume);
 }
 
 DoubleExponentialMovingAverageState tama::DoubleExponentialMovingAverage::getState() {
@@ -111,3 +147,39 @@ DoubleExponentialMovingAverageState tama::DoubleExponentialMovingAverage::getSta
 		.ema2 = this->ema2.getState()
 	};
 }
+
+status tama::DoubleExponentialMovingAverage::sweep(std::span<const double> prices, std::span<const uint16_t> periods, std::vector<double>& output, sweepLayout layout) {
+	output.resize(periods.size() * prices.size());
+	return DoubleExponentialMovingAverage::sweep(prices, periods, std::span<double>(output), layout);
+}
+
+status tama::DoubleExponentialMovingAverage::sweep(std::span<const double> prices, std::span<const uint16_t> periods, std::span<double> output, sweepLayout layout, std::pmr::memory_resource* scratch) {
+	if (prices.empty() || periods.empty()) {
+		return status::emptyParams;
+	}
+
+	const size_t pricesLen = prices.size();
+	const size_t periodsLen = periods.size();
+
+	if (output.size() < periodsLen * pricesLen) {
+		return status::invalidParam;
+	}
+
+	std::pmr::vector<double> alpha(periodsLen, scratch);
+	std::pmr::vector<double> oma(periodsLen, scratch);
+	std::pmr::vector<double> coefficients(2 * periodsLen, scratch);
+	for (size_t k = 0; k < periodsLen; k++) {
+		if (periods[k] == 0) {
+			return status::invalidParam;
+		}
+		alpha[k] = 2.0 / (static_cast<double>(periods[k]) + 1.0);
+		oma[k] = 1.0 - alpha[k];
+		coefficients[k] = 2.0;
+		coefficients[periodsLen + k] = -1.0;
+	}
+
+	const bool periodMajor = layout == sweepLayout::periodMajor;
+	helpers::simdEmaCascade(prices, alpha, oma, coefficients, 2, output, periodMajor ? 1 : periodsLen, periodMajor ? pricesLen : 1);
+
+	return status::ok;
+}
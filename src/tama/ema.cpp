@@ -1,9 +1,29 @@
+#include <algorithm>
 #include <vector>
 #include <cmath>
+#include <limits>
+#include <thread>
 #include <stdexcept>
 #include <stdexcept>
 #include <tama/tama.hpp>
 
+namespace {
+    // Chunks shorter than this are not worth a thread.
+    constexpr size_t minScanChunk = size_t{1} << 16;
+
+    template <typename F>
+    void run_chunks(size_t workers, F&& fn) {
+        std::vector<std::thread> pool;
+        pool.reserve(workers);
+        for (size_t w = 0; w < workers; w++) {
+            pool.emplace_back(fn, w);
+        }
+        for (std::thread& worker : pool) {
+            worker.join();
+        }
+    }
+}
+
 
 tama::ExponentialMovingAverage::ExponentialMovingAverage(uint16_t period)
     : lastEma(0.0),
@@ -25,7 +45,10 @@ tama::ExponentialMovingAverage::ExponentialMovingAverage(ExponentialMovingAverag
         period(prevCalculation.period),
         alpha(prevCalculation.alpha),
         oma(prevCalculation.oma),
-        initalized(true) {
+        initalized(true),
+        prevEma(prevCalculation.prevEma),
+        hasPrevEma(prevCalculation.hasPrevEma),
+        newestSeeded(prevCalculation.newestSeeded) {
 
 
     if (period <= 0) {
@@ -46,7 +69,14 @@ tama::ExponentialMovingAverage::ExponentialMovingAverage(ExponentialMovingAverag
 }
 
 
-status tama::ExponentialMovingAverage::compute(std::span<const double> prices, std::vector<double>& output) {
+status tama::ExponentialMovingAverage::compute(std::span<const double> prices, std::vector<double>& output, computeMode mode) {
+    if (output.size() < prices.size()) {
+        output.resize(prices.size());
+    }
+    return this->compute(prices, std::span<double>(output), mode);
+}
+
+status tama::ExponentialMovingAverage::compute(std::span<const double> prices, std::span<double> output, computeMode mode) {
     if (prices.empty()) {
         return status::emptyParams;
     }
@@ -54,40 +84,375 @@ status tama::ExponentialMovingAverage::compute(std::span<const double> prices, s
     const size_t pricesLen = prices.size();
 
     if (output.size() < pricesLen) {
-        output.resize(pricesLen);
+        return status::invalidParam;
+    }
+    // A resumed pass continues from the previous value; a restart seeds from the
+    // first sample. Both share one recurrence so chunked output rounds alike.
+    const bool resumed = mode == computeMode::resume && this->initalized;
+    double prev = resumed ? this->lastEma : prices[0];
+    size_t first = 0;
+    if (!resumed) {
+        output[0] = prev;
+        first = 1;
     }
-    output[0] = prices[0];
 
-    for (size_t t = 1; t < pricesLen; t++) {
-        output[t] = this->alpha * prices[t] + this->oma * output[t - 1];
+    for (size_t t = first; t < pricesLen; t++) {
+        prev = this->alpha * prices[t] + this->oma * prev;
+        output[t] = prev;
     }
 
+    if (pricesLen > 1) {
+        this->markStepped(output[pricesLen - 2]);
+    } else if (!resumed) {
+        this->markSeeded();
+    } else {
+        this->markStepped(this->lastEma);
+    }
     this->initalized = true;
-    this->lastEma = output.back();
+    this->lastEma = output[pricesLen - 1];
 
     return status::ok;
 }
 
-double tama::ExponentialMovingAverage::update(double price) {
+status tama::ExponentialMovingAverage::computePaths(std::span<const double> paths, size_t pathCount, std::vector<double>& output, pathLayout layout, computeMode mode, std::span<ExponentialMovingAverageState> finalStates) const {
+    if (output.size() < paths.size()) {
+        output.resize(paths.size());
+    }
+    return this->computePaths(paths, pathCount, std::span<double>(output), layout, mode, finalStates);
+}
+
+status tama::ExponentialMovingAverage::computePaths(std::span<const double> paths, size_t pathCount, std::span<double> output, pathLayout layout, computeMode mode, std::span<ExponentialMovingAverageState> finalStates) const {
+    detail::PathStrides s{};
+    const status checked = detail::checkPaths(paths.size(), pathCount, output.size(), finalStates.size(), layout, s);
+    if (checked != status::ok) {
+        return checked;
+    }
+
+    constexpr size_t W = detail::pathLanes;
+    const bool resumed = mode == computeMode::resume && this->initalized;
+    const double alpha = this->alpha;
+    const double oma = this->oma;
+
+    // Each tile runs compute()'s recurrence on W paths side by side.
+    const size_t group = detail::pathsPerGroup(layout);
+    for (size_t p0 = 0; p0 < pathCount; p0 += group) {
+        const size_t count = std::min(group, pathCount - p0);
+        double prev[detail::pathGroup][W];
+        for (auto& tile : prev) {
+            std::fill_n(tile, W, this->lastEma);
+        }
+
+        helpers::forEachLaneBlock<W, detail::pathBlock>(paths.data() + p0 * s.path, output.data() + p0 * s.path, s.steps, s.time, s.path, count,
+            [&](size_t tile, const double* x, double* y, size_t t0, size_t rows) {
+                // A local copy the tile pointers cannot alias stays in registers.
+                double ema[W];
+                std::copy_n(prev[tile], W, ema);
+                for (size_t k = 0; k < rows; k++, x += W, y += W) {
+                    if (t0 + k == 0 && !resumed) {
+                        std::copy_n(x, W, ema);
+                    } else {
+                        for (size_t l = 0; l < W; l++) {
+                            ema[l] = alpha * x[l] + oma * ema[l];
+                        }
+                    }
+                    std::copy_n(ema, W, y);
+                }
+                std::copy_n(ema, W, prev[tile]);
+            });
+
+        if (!finalStates.empty()) {
+            // The value before each path's newest sample is its second-to-last output.
+            const bool stepped = s.steps > 1 || resumed;
+            for (size_t i = 0; i < count; i++) {
+                const size_t p = p0 + i;
+                finalStates[p] = {
+                    .lastEma = prev[i / W][i % W],
+                    .period = this->period,
+                    .alpha = alpha,
+                    .oma = oma,
+                    .prevEma = s.steps > 1 ? output[(s.steps - 2) * s.time + p * s.path] : this->lastEma,
+                    .hasPrevEma = stepped,
+                    .newestSeeded = !stepped
+                };
+            }
+        }
+    }
+
+    return status::ok;
+}
+
+status tama::ExponentialMovingAverage::update(std::span<const double> prices, std::span<double> output) {
+    if (prices.empty()) {
+        return status::emptyParams;
+    }
+    if (output.size() < prices.size()) {
+        return status::invalidParam;
+    }
     if (!this->initalized) {
-        throw std::runtime_error("ema not initialized");
+        detail::throwNotInitialized("ema");
+    }
+
+    // Same recurrence as step(), with the state held in a register.
+    const double alpha = this->alpha;
+    const double oma = this->oma;
+    double ema = this->lastEma;
+    double before = ema;
+    for (size_t t = 0; t < prices.size(); t++) {
+        before = ema;
+        ema = alpha * prices[t] + oma * ema;
+        output[t] = ema;
     }
 
-    double ema = this->alpha * price + this->oma * this->lastEma;
+    this->markStepped(before);
     this->lastEma = ema;
-    return ema;
+    return status::ok;
+}
+
+status tama::ExponentialMovingAverage::peek(std::span<const double> candidates, std::span<double> output) const {
+    if (candidates.empty()) {
+        return status::emptyParams;
+    }
+    if (output.size() < candidates.size()) {
+        return status::invalidParam;
+    }
+    if (!this->initalized) {
+        detail::throwNotInitialized("ema");
+    }
+
+    const double alpha = this->alpha;
+    const double oma = this->oma;
+    const double last = this->lastEma;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        output[i] = alpha * candidates[i] + oma * last;
+    }
+    return status::ok;
+}
+
+tama::ExponentialMovingAverage tama::ExponentialMovingAverage::fork() const {
+    return *this;
+}
+
+status tama::ExponentialMovingAverage::computeScan(std::span<const double> prices, std::vector<double>& output, scanMode mode, size_t threads) {
+    if (prices.empty()) {
+        return status::emptyParams;
+    }
+
+    const size_t pricesLen = prices.size();
+
+    if (output.size() < pricesLen) {
+        output.resize(pricesLen);
+    }
+    std::span<double> out(output.data(), pricesLen);
+    out[0] = prices[0];
+
+    size_t workers = threads == 0 ? std::max<size_t>(1, std::thread::hardware_concurrency()) : threads;
+    workers = std::min(workers, std::max<size_t>(1, pricesLen / minScanChunk));
+
+    if (mode == scanMode::simd || workers == 1) {
+        helpers::simdEmaScan(prices.subspan(1), this->alpha, this->oma, prices[0], out.subspan(1));
+    } else {
+        const size_t chunk = (pricesLen + workers - 1) / workers;
+        std::vector<double> localLast(workers);
+        std::vector<double> carryIn(workers, 0.0);
+
+        // Every chunk but the first is scanned from a zero carry.
+        run_chunks(workers, [&](size_t w) {
+            const size_t start = std::max<size_t>(1, w * chunk);
+            const size_t len = std::min(pricesLen, (w + 1) * chunk) - start;
+            const double carry = w == 0 ? prices[0] : 0.0;
+            localLast[w] = helpers::simdEmaScan(prices.subspan(start, len), this->alpha, this->oma, carry, out.subspan(start, len));
+        });
+
+        // Composing the chunk maps gives the true value entering each chunk.
+        double last = localLast[0];
+        for (size_t w = 1; w < workers; w++) {
+            const size_t len = std::min(pricesLen, (w + 1) * chunk) - w * chunk;
+            carryIn[w] = last;
+            last = localLast[w] + std::pow(this->oma, static_cast<double>(len)) * last;
+        }
+
+        // Fix-up: y[t] += oma^(t - start + 1) * carry, until the factor underflows.
+        run_chunks(workers, [&](size_t w) {
+            if (w == 0) {
+                return;
+            }
+
+            const size_t end = std::min(pricesLen, (w + 1) * chunk);
+            double scale = this->oma;
+            for (size_t t = w * chunk; t < end && scale >= std::numeric_limits<double>::min(); t++) {
+                out[t] += scale * carryIn[w];
+                scale *= this->oma;
+            }
+        });
+    }
+
+    this->initalized = true;
+    if (pricesLen > 1) {
+        this->markStepped(out[pricesLen - 2]);
+    } else {
+        this->markSeeded();
+    }
+    this->lastEma = out.back();
+
+    return status::ok;
 }
 
-double tama::ExponentialMovingAverage::latest() {
-    return this->lastEma;
+void tama::detail::requireCascadeStages(double period, std::span<const ExponentialMovingAverageState> stages) {
+    for (const ExponentialMovingAverageState& stage : stages) {
+        if (stage.period != period || stage.alpha != stages[0].alpha || stage.oma != stages[0].oma) {
+            throw std::invalid_argument("EMA stages must share the indicator's period");
+        }
+    }
 }
 
+void tama::ExponentialMovingAverage::cascade(std::span<ExponentialMovingAverage* const> stages, std::span<const double> coefficients, std::span<const double> prices, std::span<double> output, size_t timeStride, bool resume) {
+    const size_t depth = stages.size();
+    const double alpha = stages[0]->alpha;
+    const double oma = stages[0]->oma;
+    std::array<double, 3> initial{};
+    std::array<double, 3> states{};
+    for (size_t k = 0; k < depth; k++) {
+        states[k] = stages[k]->lastEma;
+    }
+
+    auto run = [&](std::span<const double> chunk, std::span<double> out, bool resumed) {
+        initial = states;
+        helpers::simdEmaCascade(chunk, std::span<const double>(&alpha, 1), std::span<const double>(&oma, 1), coefficients, depth, out, timeStride, 1,
+            std::span<double>(states.data(), depth), resumed ? std::span<const double>(initial.data(), depth) : std::span<const double>());
+    };
+
+    // The kernel's resumed step rounds like its inner loop, so splitting off the
+    // newest sample leaves the output unchanged.
+    const size_t head = prices.size() - 1;
+    if (head > 0) {
+        run(prices.first(head), output, resume);
+        resume = true;
+    }
+    for (size_t k = 0; k < depth; k++) {
+        if (resume) {
+            stages[k]->markStepped(states[k]);
+        } else {
+            stages[k]->markSeeded();
+        }
+    }
+    run(prices.subspan(head), output.subspan(head * timeStride), resume);
+
+    for (size_t k = 0; k < depth; k++) {
+        stages[k]->lastEma = states[k];
+        stages[k]->initalized = true;
+    }
+}
+
+void tama::ExponentialMovingAverage::markStepped(double before) noexcept {
+    this->prevEma = before;
+    this->hasPrevEma = true;
+    this->newestSeeded = false;
+}
+
+void tama::ExponentialMovingAverage::markSeeded() noexcept {
+    this->hasPrevEma = false;
+    this->newestSeeded = true;
+}
 
 ExponentialMovingAverageState tama::ExponentialMovingAverage::getState() {
     return {
         .lastEma = this->lastEma,
         .period = this->period,
         .alpha = this->alpha,
-        .oma = this->oma
+        .oma = this->oma,
+        .prevEma = this->prevEma,
+        .hasPrevEma = this->hasPrevEma,
+        .newestSeeded = this->newestSeeded
     };
-}
\ No newline at end of file
+}
+
+status tama::ExponentialMovingAverage::sweep(std::span<const double> prices, std::span<const uint16_t> periods, std::vector<double>& output, sweepLayout layout) {
+    output.resize(periods.size() * prices.size());
+    return ExponentialMovingAverage::sweep(prices, periods, std::span<double>(output), layout);
+}
+
+status tama::ExponentialMovingAverage::sweep(std::span<const double> prices, std::span<const uint16_t> periods, std::span<double> output, sweepLayout layout, std::pmr::memory_resource* scratch) {
+    if (prices.empty() || periods.empty()) {
+        return status::emptyParams;
+    }
+
+    const size_t pricesLen = prices.size();
+    const size_t periodsLen = periods.size();
+
+    if (output.size() < periodsLen * pricesLen) {
+        return status::invalidParam;
+    }
+
+    std::pmr::vector<double> alpha(periodsLen, scratch);
+    std::pmr::vector<double> oma(periodsLen, scratch);
+    std::pmr::vector<double> coefficients(periodsLen, 1.0, scratch);
+    for (size_t k = 0; k < periodsLen; k++) {
+        if (periods[k] == 0) {
+            return status::invalidParam;
+        }
+        alpha[k] = 2.0 / (static_cast<double>(periods[k]) + 1.0);
+        oma[k] = 1.0 - alpha[k];
+    }
+
+    const bool periodMajor = layout == sweepLayout::periodMajor;
+    helpers::simdEmaCascade(prices, alpha, oma, coefficients, 1, output, periodMajor ? 1 : periodsLen, periodMajor ? pricesLen : 1);
+
+    return status::ok;
+}
+
+template <typename Sample, typename Accum>
+tama::BasicExponentialMovingAverage<Sample, Accum>::BasicExponentialMovingAverage(uint16_t period)
+    : alpha(0),
+      oma(0) {
+    if (period == 0) {
+        throw std::invalid_argument("invalid period");
+    }
+
+    this->alpha = Accum(2) / (static_cast<Accum>(period) + Accum(1));
+    this->oma = Accum(1) - this->alpha;
+}
+
+template <typename Sample, typename Accum>
+status tama::BasicExponentialMovingAverage<Sample, Accum>::compute(std::span<const Sample> prices, std::vector<Sample>& output) {
+    if (prices.empty()) {
+        return status::emptyParams;
+    }
+
+    const size_t pricesLen = prices.size();
+
+    if (output.size() < pricesLen) {
+        output.resize(pricesLen);
+    }
+
+    // The recurrence runs in Accum; only the stored outputs are rounded to Sample.
+    Accum ema = prices[0];
+    output[0] = prices[0];
+
+    for (size_t t = 1; t < pricesLen; t++) {
+        ema = this->alpha * prices[t] + this->oma * ema;
+        output[t] = static_cast<Sample>(ema);
+    }
+
+    this->initialized = true;
+    this->lastEma = ema;
+
+    return status::ok;
+}
+
+template <typename Sample, typename Accum>
+Sample tama::BasicExponentialMovingAverage<Sample, Accum>::update(Sample price) {
+    if (!this->initialized) {
+        throw std::runtime_error("ema not initialized");
+    }
+
+    this->lastEma = this->alpha * price + this->oma * this->lastEma;
+    return static_cast<Sample>(this->lastEma);
+}
+
+template <typename Sample, typename Accum>
+Sample tama::BasicExponentialMovingAverage<Sample, Accum>::latest() {
+    return static_cast<Sample>(this->lastEma);
+}
+
+template class tama::BasicExponentialMovingAverage<float, float>;
+template class tama::BasicExponentialMovingAverage<float, double>;
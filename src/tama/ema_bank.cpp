@@ -0,0 +1,456 @@
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+#include <tama/tama.hpp>
+#include <helpers/helpers.hpp>
+
+namespace {
+    template <typename State>
+    bool require_uniform_initialized(std::span<const State> states) {
+        if (states.empty()) {
+            throw std::invalid_argument("empty bank");
+        }
+
+        const bool initialized = states.front().initialized;
+        for (const State& state : states) {
+            if (state.initialized != initialized) {
+                throw std::invalid_argument("bank states must all be initialized or all uninitialized");
+            }
+        }
+        return initialized;
+    }
+
+    template <typename State>
+    std::vector<uint16_t> periods_of(std::span<const State> states) {
+        std::vector<uint16_t> periods;
+        periods.reserve(states.size());
+        for (const State& state : states) {
+            periods.push_back(static_cast<uint16_t>(state.period));
+        }
+        return periods;
+    }
+
+    template <typename State, typename Member>
+    std::vector<ExponentialMovingAverageState> ema_states_of(std::span<const State> states, Member member) {
+        std::vector<ExponentialMovingAverageState> emaStates;
+        emaStates.reserve(states.size());
+        for (const State& state : states) {
+            emaStates.push_back(state.*member);
+        }
+        return emaStates;
+    }
+}
+
+namespace tama {
+    ExponentialMovingAverageBank::ExponentialMovingAverageBank(std::span<const uint16_t> periods)
+        : instruments(periods.size()),
+          initialized(false),
+          lastEma(periods.size(), 0.0),
+          period(periods.size()),
+          alpha(periods.size()),
+          oma(periods.size()) {
+        if (periods.empty()) {
+            throw std::invalid_argument("empty bank");
+        }
+
+        for (size_t i = 0; i < this->instruments; i++) {
+            if (periods[i] == 0) {
+                throw std::invalid_argument("invalid period");
+            }
+
+            this->period[i] = static_cast<double>(periods[i]);
+            this->alpha[i] = 2.0 / (this->period[i] + 1.0);
+            this->oma[i] = 1.0 - this->alpha[i];
+        }
+    }
+
+    ExponentialMovingAverageBank::ExponentialMovingAverageBank(std::span<const ExponentialMovingAverageState> prevCalculations)
+        : instruments(prevCalculations.size()),
+          initialized(true),
+          lastEma(prevCalculations.size()),
+          period(prevCalculations.size()),
+          alpha(prevCalculations.size()),
+          oma(prevCalculations.size()) {
+        if (prevCalculations.empty()) {
+            throw std::invalid_argument("empty bank");
+        }
+
+        for (size_t i = 0; i < this->instruments; i++) {
+            const ExponentialMovingAverageState& state = prevCalculations[i];
+
+            if (state.period <= 0) {
+                throw std::invalid_argument("Invalid period: must be > 0");
+            }
+
+            if (state.alpha <= 0.0 || state.alpha > 1.0) {
+                throw std::invalid_argument("Invalid alpha: must be in (0, 1]");
+            }
+
+            if (state.oma < 0.0) {
+                throw std::invalid_argument("Invalid OMA: cannot be negative");
+            }
+
+            if (std::isnan(state.lastEma)) {
+                throw std::invalid_argument("Invalid lastEma: cannot be NaN");
+            }
+
+            this->lastEma[i] = state.lastEma;
+            this->period[i] = state.period;
+            this->alpha[i] = state.alpha;
+            this->oma[i] = state.oma;
+        }
+    }
+
+    status ExponentialMovingAverageBank::update(std::span<const double> prices) {
+        if (prices.empty()) {
+            return status::emptyParams;
+        }
+
+        if (prices.size() != this->instruments) {
+            return status::invalidParam;
+        }
+
+        if (!this->initialized) {
+            std::copy(prices.begin(), prices.end(), this->lastEma.begin());
+            this->initialized = true;
+            return status::ok;
+        }
+
+        helpers::simdEmaStep(this->lastEma, this->alpha, this->oma, prices);
+        return status::ok;
+    }
+
+    std::span<const double> ExponentialMovingAverageBank::latest() {
+        return this->lastEma;
+    }
+
+    size_t ExponentialMovingAverageBank::size() {
+        return this->instruments;
+    }
+
+    ExponentialMovingAverageState ExponentialMovingAverageBank::getState(size_t instrument) {
+        if (instrument >= this->instruments) {
+            throw std::out_of_range("instrument out of range");
+        }
+
+        return {
+            .lastEma = this->lastEma[instrument],
+            .period = this->period[instrument],
+            .alpha = this->alpha[instrument],
+            .oma = this->oma[instrument]
+        };
+    }
+
+
+    DoubleExponentialMovingAverageBank::DoubleExponentialMovingAverageBank(std::span<const uint16_t> periods)
+        : initialized(false),
+          lastDema(periods.size(), 0.0),
+          ema1(periods),
+          ema2(periods) {}
+
+    DoubleExponentialMovingAverageBank::DoubleExponentialMovingAverageBank(std::span<const DoubleExponentialMovingAverageState> prevCalculations)
+        : initialized(require_uniform_initialized(prevCalculations)),
+          lastDema(prevCalculations.size(), 0.0),
+          ema1(this->initialized
+              ? ExponentialMovingAverageBank(ema_states_of(prevCalculations, &DoubleExponentialMovingAverageState::ema1))
+              : ExponentialMovingAverageBank(periods_of(prevCalculations))),
+          ema2(this->initialized
+              ? ExponentialMovingAverageBank(ema_states_of(prevCalculations, &DoubleExponentialMovingAverageState::ema2))
+              : ExponentialMovingAverageBank(periods_of(prevCalculations))) {
+        for (size_t i = 0; i < prevCalculations.size(); i++) {
+            this->lastDema[i] = prevCalculations[i].lastDema;
+        }
+    }
+
+    status DoubleExponentialMovingAverageBank::update(std::span<const double> prices) {
+        status res = this->ema1.update(prices);
+        if (res != status::ok) {
+            return res;
+        }
+
+        res = this->ema2.update(this->ema1.latest());
+        if (res != status::ok) {
+            return res;
+        }
+
+        const std::span<const double> ema1Values = this->ema1.latest();
+        const std::span<const double> ema2Values = this->ema2.latest();
+        for (size_t i = 0; i < this->lastDema.size(); i++) {
+            this->lastDema[i] = 2.0 * ema1Values[i] - ema2Values[i];
+        }
+
+        this->initialized = true;
+        return status::ok;
+    }
+
+    std::span<const double> DoubleExponentialMovingAverageBank::latest() {
+        return this->lastDema;
+    }
+
+    size_t DoubleExponentialMovingAverageBank::size() {
+        return this->lastDema.size();
+    }
+
+    DoubleExponentialMovingAverageState DoubleExponentialMovingAverageBank::getState(size_t instrument) {
+        const ExponentialMovingAverageState ema1State = this->ema1.getState(instrument);
+
+        return {
+            .period = static_cast<size_t>(ema1State.period),
+            .initialized = this->initialized,
+            .lastDema = this->lastDema[instrument],
+            .ema1 = ema1State,
+            .ema2 = this->ema2.getState(instrument)
+        };
+    }
+
+
+    TripleExponentialMovingAverageBank::TripleExponentialMovingAverageBank(std::span<const uint16_t> periods)
+        : initialized(false),
+          lastTema(periods.size(), 0.0),
+          ema1(periods),
+          ema2(periods),
+          ema3(periods) {}
+
+    TripleExponentialMovingAverageBank::TripleExponentialMovingAverageBank(std::span<const TripleExponentialMovingAverageState> prevCalculations)
+        : initialized(require_uniform_initialized(prevCalculations)),
+          lastTema(prevCalculations.size(), 0.0),
+          ema1(this->initialized
+              ? ExponentialMovingAverageBank(ema_states_of(prevCalculations, &TripleExponentialMovingAverageState::ema1))
+              : ExponentialMovingAverageBank(periods_of(prevCalculations))),
+          ema2(this->initialized
+              ? ExponentialMovingAverageBank(ema_states_of(prevCalculations, &TripleExponentialMovingAverageState::ema2))
+              : ExponentialMovingAverageBank(periods_of(prevCalculations))),
+          ema3(this->initialized
+              ? ExponentialMovingAverageBank(ema_states_of(prevCalculations, &TripleExponentialMovingAverageState::ema3))
+              : ExponentialMovingAverageBank(periods_of(prevCalculations))) {
+        for (size_t i = 0; i < prevCalculations.size(); i++) {
+            this->lastTema[i] = prevCalculations[i].lastTema;
+        }
+    }
+
+    status TripleExponentialMovingAverageBank::update(std::span<const double> prices) {
+        status res = this->ema1.update(prices);
+        if (res != status::ok) {
+            return res;
+        }
+
+        res = this->ema2.update(this->ema1.latest());
+        if (res != status::ok) {
+            return res;
+        }
+
+        res = this->ema3.update(this->ema2.latest());
+        if (res != status::ok) {
+            return res;
+        }
+
+        const std::span<const double> ema1Values = this->ema1.latest();
+        const std::span<const double> ema2Values = this->ema2.latest();
+        const std::span<const double> ema3Values = this->ema3.latest();
+        for (size_t i = 0; i < this->lastTema.size(); i++) {
+            this->lastTema[i] = 3.0 * ema1Values[i] - 3.0 * ema2Values[i] + ema3Values[i];
+        }
+
+        this->initialized = true;
+        return status::ok;
+    }
+
+    std::span<const double> TripleExponentialMovingAverageBank::latest() {
+        return this->lastTema;
+    }
+
+    size_t TripleExponentialMovingAverageBank::size() {
+        return this->lastTema.size();
+    }
+
+    TripleExponentialMovingAverageState TripleExponentialMovingAverageBank::getState(size_t instrument) {
+        const ExponentialMovingAverageState ema1State = this->ema1.getState(instrument);
+
+        return {
+            .period = static_cast<size_t>(ema1State.period),
+            .initialized = this->initialized,
+            .lastTema = this->lastTema[instrument],
+            .ema1 = ema1State,
+            .ema2 = this->ema2.getState(instrument),
+            .ema3 = this->ema3.getState(instrument)
+        };
+    }
+
+
+    GeneralizedDoubleExponentialMovingAverageBank::GeneralizedDoubleExponentialMovingAverageBank(std::span<const double> periods, std::span<const uint16_t> emaPeriods)
+        : period(periods.begin(), periods.end()),
+          onePlusPeriod(periods.size()),
+          lastGd(periods.size(), 0.0),
+          emaBuf1(emaPeriods),
+          emaBuf2(emaPeriods) {
+        if (periods.size() != emaPeriods.size()) {
+            throw std::invalid_argument("periods and emaPeriods must match in size");
+        }
+
+        for (size_t i = 0; i < this->period.size(); i++) {
+            if (this->period[i] == 0) {
+                throw std::invalid_argument("invalid period");
+            }
+            this->onePlusPeriod[i] = 1 + this->period[i];
+        }
+    }
+
+    GeneralizedDoubleExponentialMovingAverageBank::GeneralizedDoubleExponentialMovingAverageBank(std::span<const GeneralizedDoubleExponentialMovingAverageState> prevCalculations)
+        : period(prevCalculations.size()),
+          onePlusPeriod(prevCalculations.size()),
+          lastGd(prevCalculations.size()),
+          emaBuf1(ema_states_of(prevCalculations, &GeneralizedDoubleExponentialMovingAverageState::ema1)),
+          emaBuf2(ema_states_of(prevCalculations, &GeneralizedDoubleExponentialMovingAverageState::ema2)) {
+        for (size_t i = 0; i < prevCalculations.size(); i++) {
+            const GeneralizedDoubleExponentialMovingAverageState& state = prevCalculations[i];
+
+            if (state.period == 0) {
+                throw std::invalid_argument("invalid period");
+            }
+            if (state.emaPeriod == 0) {
+                throw std::invalid_argument("invalid emaPeriod");
+            }
+
+            this->period[i] = state.period;
+            this->onePlusPeriod[i] = state.onePlusPeriod;
+            this->lastGd[i] = state.lastGd;
+        }
+    }
+
+    status GeneralizedDoubleExponentialMovingAverageBank::update(std::span<const double> prices) {
+        status res = this->emaBuf1.update(prices);
+        if (res != status::ok) {
+            return res;
+        }
+
+        res = this->emaBuf2.update(this->emaBuf1.latest());
+        if (res != status::ok) {
+            return res;
+        }
+
+        const std::span<const double> ema1Values = this->emaBuf1.latest();
+        const std::span<const double> ema2Values = this->emaBuf2.latest();
+        for (size_t i = 0; i < this->lastGd.size(); i++) {
+            this->lastGd[i] = this->onePlusPeriod[i] * ema1Values[i] - this->period[i] * ema2Values[i];
+        }
+
+        return status::ok;
+    }
+
+    std::span<const double> GeneralizedDoubleExponentialMovingAverageBank::latest() {
+        return this->lastGd;
+    }
+
+    size_t GeneralizedDoubleExponentialMovingAverageBank::size() {
+        return this->lastGd.size();
+    }
+
+    GeneralizedDoubleExponentialMovingAverageState GeneralizedDoubleExponentialMovingAverageBank::getState(size_t instrument) {
+        const ExponentialMovingAverageState ema1State = this->emaBuf1.getState(instrument);
+
+        return {
+            .period = this->period[instrument],
+            .emaPeriod = ema1State.period,
+            .onePlusPeriod = this->onePlusPeriod[instrument],
+            .lastGd = this->lastGd[instrument],
+            .ema1 = ema1State,
+            .ema2 = this->emaBuf2.getState(instrument)
+        };
+    }
+
+    McGinleyDynamicMovingAverageBank::McGinleyDynamicMovingAverageBank(std::span<const uint16_t> periods, mdArithmetic arithmetic)
+        : instruments(periods.size()),
+          initialized(false),
+          arithmetic(arithmetic),
+          lastMd(periods.size(), 0.0),
+          period(periods.size()),
+          invPeriod(periods.size()) {
+        if (periods.empty()) {
+            throw std::invalid_argument("empty bank");
+        }
+
+        for (size_t i = 0; i < this->instruments; i++) {
+            if (periods[i] == 0) {
+                throw std::invalid_argument("invalid period");
+            }
+
+            this->period[i] = static_cast<double>(periods[i]);
+            this->invPeriod[i] = 1.0 / this->period[i];
+        }
+    }
+
+    McGinleyDynamicMovingAverageBank::McGinleyDynamicMovingAverageBank(std::span<const McGinleyDynamicMovingAverageState> prevCalculations)
+        : instruments(prevCalculations.size()),
+          initialized(require_uniform_initialized(prevCalculations)),
+          arithmetic(prevCalculations.front().arithmetic),
+          lastMd(prevCalculations.size()),
+          period(prevCalculations.size()),
+          invPeriod(prevCalculations.size()) {
+        for (size_t i = 0; i < this->instruments; i++) {
+            const McGinleyDynamicMovingAverageState& state = prevCalculations[i];
+
+            if (state.period == 0) {
+                throw std::invalid_argument("invalid period");
+            }
+
+            if (state.arithmetic != this->arithmetic) {
+                throw std::invalid_argument("bank states must share one arithmetic");
+            }
+
+            if (std::isnan(state.lastMd)) {
+                throw std::invalid_argument("invalid previous calculation");
+            }
+
+            this->lastMd[i] = state.lastMd;
+            this->period[i] = static_cast<double>(state.period);
+            this->invPeriod[i] = 1.0 / this->period[i];
+        }
+    }
+
+    status McGinleyDynamicMovingAverageBank::update(std::span<const double> prices) {
+        if (prices.empty()) {
+            return status::emptyParams;
+        }
+
+        if (prices.size() != this->instruments) {
+            return status::invalidParam;
+        }
+
+        if (!this->initialized) {
+            std::copy(prices.begin(), prices.end(), this->lastMd.begin());
+            this->initialized = true;
+            return status::ok;
+        }
+
+        if (this->arithmetic == mdArithmetic::fast) {
+            helpers::simdMdStep(this->lastMd, this->invPeriod, prices);
+            return status::ok;
+        }
+
+        for (size_t i = 0; i < this->instruments; i++) {
+            this->lastMd[i] = detail::mdStep<mdArithmetic::exact>(this->lastMd[i], prices[i], this->period[i], this->invPeriod[i]);
+        }
+        return status::ok;
+    }
+
+    std::span<const double> McGinleyDynamicMovingAverageBank::latest() {
+        return this->lastMd;
+    }
+
+    size_t McGinleyDynamicMovingAverageBank::size() {
+        return this->instruments;
+    }
+
+    McGinleyDynamicMovingAverageState McGinleyDynamicMovingAverageBank::getState(size_t instrument) {
+        if (instrument >= this->instruments) {
+            throw std::out_of_range("instrument out of range");
+        }
+
+        return {
+            .period = static_cast<uint16_t>(this->period[instrument]),
+            .lastMd = this->lastMd[instrument],
+            .initialized = this->initialized,
+            .arithmetic = this->arithmetic
+        };
+    }
+}
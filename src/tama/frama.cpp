@@ -1,29 +1,52 @@
 #include "tama/tama.hpp"
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 
 namespace {
-std::vector<double> ring_to_vector(const helpers::RingBuffer<double>& buffer) {
-    std::vector<double> values;
-    values.reserve(buffer.len());
-    for (size_t i = 0; i < buffer.len(); ++i) {
-        values.push_back(buffer[i]);
-    }
-    return values;
+FractalAdaptiveMovingAverageState unpack_state(std::span<const std::byte> packed) {
+    const auto header = helpers::unpackHeader<FractalAdaptiveMovingAverageSnapshot>(packed);
+    size_t offset = sizeof(header);
+    return {
+        .initialized = header.initialized != 0,
+        .period = header.period,
+        .eulerNumber = header.eulerNumber,
+        .halfPeriod = header.halfPeriod,
+        .logTwo = header.logTwo,
+        .highBuf1Max = header.highBuf1Max,
+        .highBuf2Max = header.highBuf2Max,
+        .lowBuf1min = header.lowBuf1min,
+        .lowBuf2min = header.lowBuf2min,
+        .lastFrama = header.lastFrama,
+        .arithmetic = static_cast<framaArithmetic>(header.arithmetic),
+        .prevFrama = header.prevFrama,
+        .lastAlpha = header.lastAlpha,
+        .hasPrevFrama = header.hasPrevFrama != 0,
+        // Braced initializers run in order, so the windows are read back to back.
+        .highBuf1 = helpers::unpackValues(packed, offset, header.highBuf1Count),
+        .highBuf2 = helpers::unpackValues(packed, offset, header.highBuf2Count),
+        .lowBuf1 = helpers::unpackValues(packed, offset, header.lowBuf1Count),
+        .lowBuf2 = helpers::unpackValues(packed, offset, header.lowBuf2Count)
+    };
 }
 }
 
 
 namespace tama {
-    FractalAdaptiveMovingAverage::FractalAdaptiveMovingAverage(uint16_t period, double eulerNumber)
+    FractalAdaptiveMovingAverage::FractalAdaptiveMovingAverage(uint16_t period, double eulerNumber, framaArithmetic arithmetic)
     : period(period), 
     eulerNumber(eulerNumber),  
     halfPeriod(period/2), 
     logTwo(log(2)), 
+    arithmetic(arithmetic),
     highBuf1(period/2), 
     highBuf2(period/2), 
     lowBuf1(period/2), 
-    lowBuf2(period/2) {
+    lowBuf2(period/2),
+    highMax1(period/2),
+    highMax2(period/2),
+    lowMin1(period/2),
+    lowMin2(period/2) {
         if (period < 2) {
             throw std::invalid_argument("invalid period");
         }
@@ -40,10 +63,18 @@ namespace tama {
     lowBuf1min(prevCalculation.lowBuf1min),
     lowBuf2min(prevCalculation.lowBuf2min),
     lastFrama(prevCalculation.lastFrama),
+    arithmetic(prevCalculation.arithmetic),
+    prevFrama(prevCalculation.prevFrama),
+    lastAlpha(prevCalculation.lastAlpha),
+    hasPrevFrama(prevCalculation.hasPrevFrama),
     highBuf1(prevCalculation.period / 2),
     highBuf2(prevCalculation.period / 2),
     lowBuf1(prevCalculation.period / 2),
-    lowBuf2(prevCalculation.period / 2) {
+    lowBuf2(prevCalculation.period / 2),
+    highMax1(prevCalculation.period / 2),
+    highMax2(prevCalculation.period / 2),
+    lowMin1(prevCalculation.period / 2),
+    lowMin2(prevCalculation.period / 2) {
         if (this->period < 2) {
             throw std::invalid_argument("invalid period");
         }
@@ -68,15 +99,26 @@ namespace tama {
         this->highBuf2.insert(prevCalculation.highBuf2);
         this->lowBuf1.insert(prevCalculation.lowBuf1);
         this->lowBuf2.insert(prevCalculation.lowBuf2);
-    }
 
-    double FractalAdaptiveMovingAverage::latest() {
-        return this->lastFrama;
+        this->highMax1.insert(prevCalculation.highBuf1);
+        this->highMax2.insert(prevCalculation.highBuf2);
+        this->lowMin1.insert(prevCalculation.lowBuf1);
+        this->lowMin2.insert(prevCalculation.lowBuf2);
+        this->highBuf1Max = this->highMax1.front();
+        this->highBuf2Max = this->highMax2.front();
+        this->lowBuf1min = this->lowMin1.front();
+        this->lowBuf2min = this->lowMin2.front();
     }
 
-
     // edge case: what if period is uneven? how wil window splitting be handled
-    status FractalAdaptiveMovingAverage::compute(std::span<const double> close, std::span<const double> low, std::span<const double> high, std::vector<double>& output) {
+    status FractalAdaptiveMovingAverage::compute(std::span<const double> close, std::span<const double> low, std::span<const double> high, std::vector<double>& output, computeMode mode) {
+        if (output.size() < close.size()) {
+            output.resize(close.size());
+        }
+        return this->compute(close, low, high, std::span<double>(output), mode);
+    }
+
+    status FractalAdaptiveMovingAverage::compute(std::span<const double> close, std::span<const double> low, std::span<const double> high, std::span<double> output, computeMode mode) {
         size_t lowLen = low.size();
         size_t highLen = high.size();
         size_t closeLen = close.size();
@@ -88,161 +130,238 @@ namespace tama {
         if (lowLen != highLen || closeLen != lowLen)
             return status::invalidParam;
 
-        if (closeLen < this->period)
-            return status::invalidParam;
-
         if (output.size() < closeLen) {
-            output.resize(closeLen);
+            return status::invalidParam;
         }
 
-        for (size_t i = 0; i < this->period; i ++) {
-            output[i] = close[i];
-        }
+        // A resumed series skips the warm-up and starts stepping at its first sample.
+        const bool resumed = mode == computeMode::resume && this->initialized;
 
-        std::span<const double> windowOneHigh =  high.subspan(this->period - this->period, this->halfPeriod);
-        this->highBuf1Max = *std::max_element(windowOneHigh.begin(), windowOneHigh.end());
-        this->highBuf1.insert(windowOneHigh);
-        
-        std::span<const double> windowTwoHigh = high.subspan(this->period - this->halfPeriod, this->halfPeriod);
-        this->highBuf2Max = *std::max_element(windowTwoHigh.begin(), windowTwoHigh.end());
-        this->highBuf2.insert(windowTwoHigh);
+        if (!resumed) {
+            if (closeLen < this->period)
+                return status::invalidParam;
 
-
-        std::span<const double> windowOneLow =  low.subspan(this->period - this->period, this->halfPeriod);
-        this->lowBuf1min = *std::min_element(windowOneLow.begin(), windowOneLow.end());
-        this->lowBuf1.insert(windowOneLow);
-
-        std::span<const double> windowTwoLow = low.subspan(this->period - this->halfPeriod, this->halfPeriod);
-        this->lowBuf2min = *std::min_element(windowTwoLow.begin(), windowTwoLow.end());
-        this->lowBuf2.insert(windowTwoLow);
-
-        for (size_t i = this->period; i <  closeLen; i++) {
-            double fullWindowHigh =  this->highBuf1Max > this->highBuf2Max ? this->highBuf1Max : this->highBuf2Max;
-            double fullWindowLow =  this->lowBuf1min < this->lowBuf2min ? this->lowBuf1min : this->lowBuf2min;
-
-            double l1 = (this->highBuf1Max - this->lowBuf1min) / this->halfPeriod;
-            double l2 = (this->highBuf2Max - this->lowBuf2min) / this->halfPeriod;
-            double l3 = (fullWindowHigh - fullWindowLow) / this->period;
-            double D = log((l1 + l2) / l3) / this->logTwo;
-            if (D <= 0) D = 1;
-            
-            double alpha = exp(this->eulerNumber * (D - 1));
-
-            output[i] = alpha * close[i] + (1-alpha) * output[i-1];
-
-            const double hb1_head = highBuf1.head();
-            const double hb2_head = highBuf2.head();
-
-            const bool recalchb1 = (hb1_head == highBuf1Max);
-            highBuf1.insert(hb2_head);
-
-            if (recalchb1) {
-                highBuf1Max = highBuf1.max();
-            } else if (hb2_head > highBuf1Max) {
-                highBuf1Max = hb2_head;
+            for (size_t i = 0; i < this->period; i ++) {
+                output[i] = close[i];
             }
 
-            const bool recalchb2 = (hb2_head == highBuf2Max);
-            highBuf2.insert(high[i]);
+            std::span<const double> windowOneHigh =  high.subspan(this->period - this->period, this->halfPeriod);
+            this->highBuf1.insert(windowOneHigh);
+            this->highMax1.clear();
+            this->highMax1.insert(windowOneHigh);
+            this->highBuf1Max = this->highMax1.front();
+
+            std::span<const double> windowTwoHigh = high.subspan(this->period - this->halfPeriod, this->halfPeriod);
+            this->highBuf2.insert(windowTwoHigh);
+            this->highMax2.clear();
+            this->highMax2.insert(windowTwoHigh);
+            this->highBuf2Max = this->highMax2.front();
+
+
+            std::span<const double> windowOneLow =  low.subspan(this->period - this->period, this->halfPeriod);
+            this->lowBuf1.insert(windowOneLow);
+            this->lowMin1.clear();
+            this->lowMin1.insert(windowOneLow);
+            this->lowBuf1min = this->lowMin1.front();
+
+            std::span<const double> windowTwoLow = low.subspan(this->period - this->halfPeriod, this->halfPeriod);
+            this->lowBuf2.insert(windowTwoLow);
+            this->lowMin2.clear();
+            this->lowMin2.insert(windowTwoLow);
+            this->lowBuf2min = this->lowMin2.front();
+        }
 
-            if (recalchb2) {
-                highBuf2Max = highBuf2.max();
-            } else if (high[i] > highBuf2Max) {
-                highBuf2Max = high[i];
+        const size_t first = resumed ? 0 : this->period;
+        double prev = resumed ? this->lastFrama : output[this->period - 1];
+        // Blend of the newest step for amend(); a warm-up sample is its own close.
+        double before = 0.0;
+        double lastAlpha = 1.0;
+        if (this->arithmetic == framaArithmetic::approximate) {
+            // Only the window ratios depend on the running extrema. They are staged in
+            // `output`, turned into alphas in one vectorizable pass, then blended.
+            for (size_t i = first; i < closeLen; i++) {
+                output[i] = this->windowRatio();
+                this->slide(high[i], low[i]);
             }
-
-            const double lb1_head = lowBuf1.head();
-            const double lb2_head = lowBuf2.head();
-
-            const bool recalclb1 = (lb1_head == lowBuf1min);
-            lowBuf1.insert(lb2_head);
-
-            if (recalclb1) {
-                lowBuf1min = lowBuf1.min();
-            } else if (lb2_head < lowBuf1min) {
-                lowBuf1min = lb2_head;
+            // Locals, since `output` could alias the members as far as the compiler knows.
+            const double eulerNumber = this->eulerNumber;
+            const double logTwo = this->logTwo;
+            for (size_t i = first; i < closeLen; i++) {
+                output[i] = detail::framaAlpha<framaArithmetic::approximate>(output[i], eulerNumber, logTwo);
+            }
+            for (size_t i = first; i < closeLen; i++) {
+                const double alpha = output[i];
+                output[i] = alpha * close[i] + (1-alpha) * prev;
+                before = prev;
+                lastAlpha = alpha;
+                prev = output[i];
             }
+        } else {
+            for (size_t i = first; i < closeLen; i++) {
+                double alpha = detail::framaAlpha<framaArithmetic::exact>(this->windowRatio(), this->eulerNumber, this->logTwo);
 
-            const bool recalclb2 = (lb2_head == lowBuf2min);
-            lowBuf2.insert(low[i]);
+                output[i] = alpha * close[i] + (1-alpha) * prev;
+                before = prev;
+                lastAlpha = alpha;
+                prev = output[i];
 
-            if (recalclb2) {
-                lowBuf2min = lowBuf2.min();
-            } else if (low[i] < lowBuf2min) {
-                lowBuf2min = low[i];
+                this->slide(high[i], low[i]);
             }
         }
         
-        this->lastFrama = output.back();
+        this->prevFrama = before;
+        this->lastAlpha = lastAlpha;
+        this->hasPrevFrama = true;
+        this->lastFrama = output[closeLen - 1];
         this->initialized = true;
         return status::ok;
     }
 
-    double FractalAdaptiveMovingAverage::update(double close, double low, double high) {
-        if (!this->initialized) {
-            throw std::runtime_error("frama not initialized");
+    void FractalAdaptiveMovingAverage::replaceNewest(double high, double low) {
+        // The newest bar only sits in the second half-window. A higher high or a
+        // lower low simply takes its place in the extrema; moving the other way can
+        // expose an older extremum that the deque has dropped, so that side is
+        // rebuilt from the window.
+        const bool highRises = high >= this->highBuf2.back();
+        this->highBuf2.replaceBack(high);
+        if (highRises) {
+            this->highMax2.replaceBack(high);
+        } else {
+            this->highMax2.clear();
+            for (const std::span<const double> run : this->highBuf2.view().runs) {
+                this->highMax2.insert(run);
+            }
         }
-        
-        double fullWindowHigh =  this->highBuf1Max > this->highBuf2Max ? this->highBuf1Max : this->highBuf2Max;
-        double fullWindowLow =  this->lowBuf1min < this->lowBuf2min ? this->lowBuf1min : this->lowBuf2min;
-
-        double l1 = (this->highBuf1Max - this->lowBuf1min) / this->halfPeriod;
-        double l2 = (this->highBuf2Max - this->lowBuf2min) / this->halfPeriod;
-        double l3 = (fullWindowHigh - fullWindowLow) / this->period;
-        double D = log((l1 + l2) / l3) / this->logTwo;
-        if (D <= 0) D = 1;
-        
-        double alpha = exp(this->eulerNumber * (D - 1));
-
-        double out = alpha * close + (1-alpha) * this->lastFrama;
-
-        const double hb1_head = highBuf1.head();
-        const double hb2_head = highBuf2.head();
-
-        const bool recalchb1 = (hb1_head == highBuf1Max);
-        highBuf1.insert(hb2_head);
-
-        if (recalchb1) {
-            highBuf1Max = highBuf1.max();
-        } else if (hb2_head > highBuf1Max) {
-            highBuf1Max = hb2_head;
+        this->highBuf2Max = this->highMax2.front();
+
+        const bool lowFalls = low <= this->lowBuf2.back();
+        this->lowBuf2.replaceBack(low);
+        if (lowFalls) {
+            this->lowMin2.replaceBack(low);
+        } else {
+            this->lowMin2.clear();
+            for (const std::span<const double> run : this->lowBuf2.view().runs) {
+                this->lowMin2.insert(run);
+            }
         }
+        this->lowBuf2min = this->lowMin2.front();
+    }
 
-        const bool recalchb2 = (hb2_head == highBuf2Max);
-        highBuf2.insert(high);
-
-        if (recalchb2) {
-            highBuf2Max = highBuf2.max();
-        } else if (high > highBuf2Max) {
-            highBuf2Max = high;
+    status FractalAdaptiveMovingAverage::update(std::span<const double> close, std::span<const double> low, std::span<const double> high, std::span<double> output) {
+        const size_t n = close.size();
+        if (n == 0 || low.empty() || high.empty()) {
+            return status::emptyParams;
+        }
+        if (low.size() != n || high.size() != n || output.size() < n) {
+            return status::invalidParam;
+        }
+        if (!this->initialized) {
+            detail::throwNotInitialized("frama");
         }
 
-        const double lb1_head = lowBuf1.head();
-        const double lb2_head = lowBuf2.head();
+        // The fractal dimension depends on the running extrema, so the ticks are
+        // applied one at a time; only the argument checks are hoisted.
+        for (size_t t = 0; t < n; t++) {
+            output[t] = this->update(close[t], low[t], high[t]);
+        }
+        return status::ok;
+    }
 
-        const bool recalclb1 = (lb1_head == lowBuf1min);
-        lowBuf1.insert(lb2_head);
+    status FractalAdaptiveMovingAverage::peek(std::span<const double> candidates, std::span<double> output) const {
+        if (candidates.empty()) {
+            return status::emptyParams;
+        }
+        if (output.size() < candidates.size()) {
+            return status::invalidParam;
+        }
+        if (!this->initialized) {
+            detail::throwNotInitialized("frama");
+        }
 
-        if (recalclb1) {
-            lowBuf1min = lowBuf1.min();
-        } else if (lb2_head < lowBuf1min) {
-            lowBuf1min = lb2_head;
+        // The window, and so alpha, is the same for every candidate close.
+        const double alpha = this->nextAlpha();
+        const double last = this->lastFrama;
+        for (size_t i = 0; i < candidates.size(); i++) {
+            output[i] = alpha * candidates[i] + (1 - alpha) * last;
         }
+        return status::ok;
+    }
 
-        const bool recalclb2 = (lb2_head == lowBuf2min);
-        lowBuf2.insert(low);
+    status FractalAdaptiveMovingAverage::nextAlphas(std::span<const FractalAdaptiveMovingAverage> indicators, std::span<double> output) {
+        if (indicators.empty()) {
+            return status::emptyParams;
+        }
+        if (output.size() < indicators.size()) {
+            return status::invalidParam;
+        }
 
-        if (recalclb2) {
-            lowBuf2min = lowBuf2.min();
-        } else if (low < lowBuf2min) {
-            lowBuf2min = low;
+        // Gathered a block at a time so the approximate pass runs on contiguous lanes.
+        constexpr size_t block = 64;
+        double ratio[block];
+        double eulerNumber[block];
+        double approximate[block];
+        for (size_t i0 = 0; i0 < indicators.size(); i0 += block) {
+            const size_t count = std::min(block, indicators.size() - i0);
+            for (size_t k = 0; k < count; k++) {
+                const FractalAdaptiveMovingAverage& indicator = indicators[i0 + k];
+                if (!indicator.initialized) {
+                    detail::throwNotInitialized("frama");
+                }
+                ratio[k] = indicator.windowRatio();
+                eulerNumber[k] = indicator.eulerNumber;
+            }
+            for (size_t k = 0; k < count; k++) {
+                approximate[k] = detail::framaAlpha<framaArithmetic::approximate>(ratio[k], eulerNumber[k], 0.0);
+            }
+            for (size_t k = 0; k < count; k++) {
+                const FractalAdaptiveMovingAverage& indicator = indicators[i0 + k];
+                output[i0 + k] = indicator.arithmetic == framaArithmetic::approximate
+                    ? approximate[k]
+                    : detail::framaAlpha<framaArithmetic::exact>(ratio[k], eulerNumber[k], indicator.logTwo);
+            }
         }
+        return status::ok;
+    }
 
-        this->lastFrama = out;
-        return out;
+    FractalAdaptiveMovingAverage FractalAdaptiveMovingAverage::fork() {
+        this->highBuf1.share();
+        this->highBuf2.share();
+        this->lowBuf1.share();
+        this->lowBuf2.share();
+        return *this;
     }
 
+    FractalAdaptiveMovingAverage::FractalAdaptiveMovingAverage(std::span<const std::byte> packed)
+    : FractalAdaptiveMovingAverage(unpack_state(packed)) {}
+
     FractalAdaptiveMovingAverageState FractalAdaptiveMovingAverage::getState() {
+        FractalAdaptiveMovingAverageState state;
+        this->getState(state);
+        return state;
+    }
+
+    void FractalAdaptiveMovingAverage::getState(FractalAdaptiveMovingAverageState& out) const {
+        out.initialized = this->initialized;
+        out.period = this->period;
+        out.eulerNumber = this->eulerNumber;
+        out.halfPeriod = this->halfPeriod;
+        out.logTwo = this->logTwo;
+        out.highBuf1Max = this->highBuf1Max;
+        out.highBuf2Max = this->highBuf2Max;
+        out.lowBuf1min = this->lowBuf1min;
+        out.lowBuf2min = this->lowBuf2min;
+        out.lastFrama = this->lastFrama;
+        out.arithmetic = this->arithmetic;
+        out.prevFrama = this->prevFrama;
+        out.lastAlpha = this->lastAlpha;
+        out.hasPrevFrama = this->hasPrevFrama;
+        this->highBuf1.view().assignTo(out.highBuf1);
+        this->highBuf2.view().assignTo(out.highBuf2);
+        this->lowBuf1.view().assignTo(out.lowBuf1);
+        this->lowBuf2.view().assignTo(out.lowBuf2);
+    }
+
+    FractalAdaptiveMovingAverageStateView FractalAdaptiveMovingAverage::view() const noexcept {
         return {
             .initialized = this->initialized,
             .period = this->period,
@@ -254,10 +373,48 @@ namespace tama {
             .lowBuf1min = this->lowBuf1min,
             .lowBuf2min = this->lowBuf2min,
             .lastFrama = this->lastFrama,
-            .highBuf1 = ring_to_vector(this->highBuf1),
-            .highBuf2 = ring_to_vector(this->highBuf2),
-            .lowBuf1 = ring_to_vector(this->lowBuf1),
-            .lowBuf2 = ring_to_vector(this->lowBuf2)
+            .arithmetic = this->arithmetic,
+            .prevFrama = this->prevFrama,
+            .lastAlpha = this->lastAlpha,
+            .hasPrevFrama = this->hasPrevFrama,
+            .highBuf1 = this->highBuf1.view(),
+            .highBuf2 = this->highBuf2.view(),
+            .lowBuf1 = this->lowBuf1.view(),
+            .lowBuf2 = this->lowBuf2.view()
         };
     }
+
+    size_t FractalAdaptiveMovingAverage::packedSize() const noexcept {
+        return helpers::packedSize<FractalAdaptiveMovingAverageSnapshot>(
+            this->highBuf1.len() + this->highBuf2.len() + this->lowBuf1.len() + this->lowBuf2.len());
+    }
+
+    status FractalAdaptiveMovingAverage::pack(std::span<std::byte> out) const noexcept {
+        if (out.size() < this->packedSize()) {
+            return status::invalidParam;
+        }
+
+        const FractalAdaptiveMovingAverageSnapshot header{
+            .period = this->period,
+            .initialized = this->initialized,
+            .highBuf1Count = this->highBuf1.len(),
+            .highBuf2Count = this->highBuf2.len(),
+            .lowBuf1Count = this->lowBuf1.len(),
+            .lowBuf2Count = this->lowBuf2.len(),
+            .eulerNumber = this->eulerNumber,
+            .halfPeriod = this->halfPeriod,
+            .logTwo = this->logTwo,
+            .highBuf1Max = this->highBuf1Max,
+            .highBuf2Max = this->highBuf2Max,
+            .lowBuf1min = this->lowBuf1min,
+            .lowBuf2min = this->lowBuf2min,
+            .lastFrama = this->lastFrama,
+            .arithmetic = static_cast<uint64_t>(this->arithmetic),
+            .prevFrama = this->prevFrama,
+            .lastAlpha = this->lastAlpha,
+            .hasPrevFrama = this->hasPrevFrama
+        };
+        helpers::packSnapshot(out.data(), header, {this->highBuf1.view(), this->highBuf2.view(), this->lowBuf1.view(), this->lowBuf2.view()});
+        return status::ok;
+    }
 }
\ No newline at end of file
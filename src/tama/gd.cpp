@@ -15,7 +15,14 @@ namespace tama {
     };
 
 
-    status GeneralizedDoubleExponentialMovingAverage::compute(std::span<const double> prices, std::vector<double>& output) {
+    status GeneralizedDoubleExponentialMovingAverage::compute(std::span<const double> prices, std::vector<double>& output, computeMode mode) {
+        if (output.size() < prices.size()) {
+            output.resize(prices.size());
+        }
+        return this->compute(prices, std::span<double>(output), mode);
+    }
+
+    status GeneralizedDoubleExponentialMovingAverage::compute(std::span<const double> prices, std::span<double> output, computeMode mode) {
         if (prices.empty()) {
             return status::emptyParams;
         }
@@ -23,29 +30,87 @@ namespace tama {
         size_t priceLen = prices.size(); 
 
         if (output.size() < priceLen) {
-            output.resize(priceLen);
+            return status::invalidParam;
         }
 
-        std::vector<double> ema1Out(priceLen);
-        status res = this->emaBuf1.compute(prices, ema1Out);
-        if (res != status::ok) {
-            return  res;
+        // Both EMA stages run fused in one pass; only the final output is written.
+        ExponentialMovingAverage* const stages[2] = {&this->emaBuf1, &this->emaBuf2};
+        const double coefficients[2] = {this->onePlusPeriod, -this->period};
+        const bool resumed = mode == computeMode::resume && this->emaBuf1.initalized && this->emaBuf2.initalized;
+
+        ExponentialMovingAverage::cascade(stages, coefficients, prices, output, 1, resumed);
+
+        this->lastGd = output[priceLen - 1];
+        return status::ok;
+    }
+
+    status GeneralizedDoubleExponentialMovingAverage::update(std::span<const double> prices, std::span<double> output) {
+        if (prices.empty()) {
+            return status::emptyParams;
+        }
+        if (output.size() < prices.size()) {
+            return status::invalidParam;
+        }
+        if (!this->emaBuf1.initalized || !this->emaBuf2.initalized) {
+            detail::throwNotInitialized("ema");
         }
 
-        std::vector<double> ema2Out(priceLen);
-        res = this->emaBuf2.compute(ema1Out, ema2Out);
-        if (res != status::ok) {
-            return  res;
+        // The stage states stay in registers for the batch.
+        const double alpha1 = this->emaBuf1.alpha;
+        const double oma1 = this->emaBuf1.oma;
+        const double alpha2 = this->emaBuf2.alpha;
+        const double oma2 = this->emaBuf2.oma;
+        const double onePlusPeriod = this->onePlusPeriod;
+        const double period = this->period;
+        double e1 = this->emaBuf1.lastEma;
+        double e2 = this->emaBuf2.lastEma;
+        double before1 = e1;
+        double before2 = e2;
+        for (size_t t = 0; t < prices.size(); t++) {
+            before1 = e1;
+            before2 = e2;
+            e1 = alpha1 * prices[t] + oma1 * e1;
+            e2 = alpha2 * e1 + oma2 * e2;
+            output[t] = onePlusPeriod * e1 - period * e2;
         }
 
-        for (size_t i = 0; i < priceLen; i++) {
-            output[i] = this->onePlusPeriod * ema1Out[i] - this->period * ema2Out[i];
+        this->emaBuf1.markStepped(before1);
+        this->emaBuf2.markStepped(before2);
+        this->emaBuf1.lastEma = e1;
+        this->emaBuf2.lastEma = e2;
+        this->lastGd = output[prices.size() - 1];
+        return status::ok;
+    }
+
+    status GeneralizedDoubleExponentialMovingAverage::peek(std::span<const double> candidates, std::span<double> output) const {
+        if (candidates.empty()) {
+            return status::emptyParams;
+        }
+        if (output.size() < candidates.size()) {
+            return status::invalidParam;
+        }
+        if (!this->emaBuf1.initalized || !this->emaBuf2.initalized) {
+            detail::throwNotInitialized("ema");
         }
 
-        this->lastGd = output.back();
+        const double alpha1 = this->emaBuf1.alpha;
+        const double oma1 = this->emaBuf1.oma;
+        const double alpha2 = this->emaBuf2.alpha;
+        const double oma2 = this->emaBuf2.oma;
+        const double e1 = this->emaBuf1.lastEma;
+        const double e2 = this->emaBuf2.lastEma;
+        for (size_t i = 0; i < candidates.size(); i++) {
+            const double next1 = alpha1 * candidates[i] + oma1 * e1;
+            const double next2 = alpha2 * next1 + oma2 * e2;
+            output[i] = this->onePlusPeriod * next1 - this->period * next2;
+        }
         return status::ok;
     }
 
+    GeneralizedDoubleExponentialMovingAverage GeneralizedDoubleExponentialMovingAverage::fork() const {
+        return *this;
+    }
+
 
     GeneralizedDoubleExponentialMovingAverage::GeneralizedDoubleExponentialMovingAverage(GeneralizedDoubleExponentialMovingAverageState prevCalculation)
         : period(prevCalculation.period),
@@ -60,6 +125,9 @@ namespace tama {
         if (emaPeriod == 0) {
             throw std::invalid_argument("invalid emaPeriod");
         }
+
+        const ExponentialMovingAverageState stages[] = {prevCalculation.ema1, prevCalculation.ema2};
+        detail::requireCascadeStages(this->emaPeriod, stages);
     };
 
 
@@ -75,19 +143,44 @@ namespace tama {
     }
 
 
-    double GeneralizedDoubleExponentialMovingAverage::latest() {
-        return this->lastGd;
-    } 
+    status GeneralizedDoubleExponentialMovingAverage::sweep(std::span<const double> prices, double period, std::span<const uint16_t> emaPeriods, std::vector<double>& output, sweepLayout layout) {
+        output.resize(emaPeriods.size() * prices.size());
+        return GeneralizedDoubleExponentialMovingAverage::sweep(prices, period, emaPeriods, std::span<double>(output), layout);
+    }
 
+    status GeneralizedDoubleExponentialMovingAverage::sweep(std::span<const double> prices, double period, std::span<const uint16_t> emaPeriods, std::span<double> output, sweepLayout layout, std::pmr::memory_resource* scratch) {
+        if (prices.empty() || emaPeriods.empty()) {
+            return status::emptyParams;
+        }
 
-    double GeneralizedDoubleExponentialMovingAverage::update(double price) {
-        double ema1res = this->emaBuf1.update(price);
-        double ema2res = this->emaBuf2.update(ema1res);
+        if (period == 0) {
+            return status::invalidParam;
+        }
 
-        double NewGd = this->onePlusPeriod * ema1res - this->period * ema2res;
-        this->lastGd = NewGd;
+        const size_t priceLen = prices.size();
+        const size_t periodsLen = emaPeriods.size();
 
-        return NewGd;
-    };
+        if (output.size() < periodsLen * priceLen) {
+            return status::invalidParam;
+        }
+
+        std::pmr::vector<double> alpha(periodsLen, scratch);
+        std::pmr::vector<double> oma(periodsLen, scratch);
+        std::pmr::vector<double> coefficients(2 * periodsLen, scratch);
+        for (size_t k = 0; k < periodsLen; k++) {
+            if (emaPeriods[k] == 0) {
+                return status::invalidParam;
+            }
+            alpha[k] = 2.0 / (static_cast<double>(emaPeriods[k]) + 1.0);
+            oma[k] = 1.0 - alpha[k];
+            coefficients[k] = 1 + period;
+            coefficients[periodsLen + k] = -period;
+        }
+
+        const bool periodMajor = layout == sweepLayout::periodMajor;
+        helpers::simdEmaCascade(prices, alpha, oma, coefficients, 2, output, periodMajor ? 1 : periodsLen, periodMajor ? priceLen : 1);
+
+        return status::ok;
+    }
 
 }
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include <array>
 #include <vector>
 #include <tama/tama.hpp>
 #include <helpers/helpers.hpp>
@@ -12,6 +13,9 @@ namespace {
         }
         return period;
     }
+
+    // p2 = round(sqrt(period)) never exceeds this for a uint16_t period.
+    constexpr size_t maxSqrtPeriod = 256;
 }
 
 tama::HullMovingAverage::HullMovingAverage(uint16_t period, std::vector<double> prevCalc)
@@ -25,30 +29,7 @@ tama::HullMovingAverage::HullMovingAverage(uint16_t period, std::vector<double>
         if (prevCalc.size() != this->period) {
             throw std::invalid_argument("prevCalc buffer doesn't match period");
         }
-        std::vector<double> w1Out(prevCalc.size());
-        std::vector<double> w2Out(prevCalc.size());
-        std::vector<double> w3Out(prevCalc.size());
-
-        status res = this->w1.compute(prevCalc, w1Out);
-        if (res != status::ok) {
-            return;
-        }
-
-        res = this->w2.compute(prevCalc, w2Out);
-        if (res != status::ok) {
-            return;
-        }
-
-        for (size_t i = 0; i < prevCalc.size(); ++i) {
-            w1Out[i] = 2.0 * w1Out[i] - w2Out[i];
-        }
-
-        res = this->w3.compute(w1Out, w3Out);
-        if (res != status::ok) {
-            return;
-        }
-
-        this->lastHull = w3Out.back();
+        this->fusedCompute(prevCalc, std::span<double>(&this->lastHull, 1), 0);
         this->initialized = true;
     }
 }
@@ -74,73 +55,530 @@ tama::HullMovingAverage::HullMovingAverage(HullMovingAverageState prevCalculatio
     }
 }
 
-status tama::HullMovingAverage::compute(std::span<const double> prices, std::vector<double>& output) {
+status tama::HullMovingAverage::compute(std::span<const double> prices, std::vector<double>& output, computeMode mode) {
+    if (!prices.empty()) {
+        output.resize(prices.size());
+    }
+    return this->compute(prices, std::span<double>(output), mode);
+}
+
+status tama::HullMovingAverage::compute(std::span<const double> prices, std::span<double> output, computeMode mode) {
     if (prices.empty()) {
         return status::emptyParams;
     }
 
     const size_t pricesLen = prices.size();
-    if (output.size() != pricesLen) {
-        output.resize(pricesLen);
+    if (output.size() < pricesLen) {
+        return status::invalidParam;
+    }
+    if (this->period > pricesLen && !(mode == computeMode::resume && this->initialized)) {
+        return status::invalidParam;
+    }
+    const bool resumed = mode == computeMode::resume && this->initialized;
+    if (!resumed) {
+        std::fill(output.begin(), output.begin() + (this->p2 - 1), 0.0);
     }
 
-    std::vector<double> wmaAOut(pricesLen);
-    std::vector<double> wmaBOut(pricesLen);
+    this->fusedCompute(prices, output, 1, resumed);
 
+    this->lastHull = output[pricesLen - 1];
+    this->initialized = true;
+    
+    return status::ok;
+}
 
-    status res = this->w1.compute(prices, wmaAOut);
-    if (res != status::ok) {
-        return res;
+status tama::HullMovingAverage::computePaths(std::span<const double> paths, size_t pathCount, std::vector<double>& output, pathLayout layout, computeMode mode, std::span<HullMovingAverageState> finalStates) const {
+    if (output.size() < paths.size()) {
+        output.resize(paths.size());
     }
-    
-    res = this->w2.compute(prices, wmaBOut);
-    if (res != status::ok) {
-        return res;
+    return this->computePaths(paths, pathCount, std::span<double>(output), layout, mode, finalStates);
+}
+
+status tama::HullMovingAverage::computePaths(std::span<const double> paths, size_t pathCount, std::span<double> output, pathLayout layout, computeMode mode, std::span<HullMovingAverageState> finalStates) const {
+    detail::PathStrides s{};
+    const status checked = detail::checkPaths(paths.size(), pathCount, output.size(), finalStates.size(), layout, s);
+    if (checked != status::ok) {
+        return checked;
+    }
+    const bool resumed = mode == computeMode::resume && this->initialized;
+    if (this->period > s.steps && !resumed) {
+        return status::invalidParam;
     }
 
+    constexpr size_t W = detail::pathLanes;
+    const size_t n = s.steps;
+    const size_t n1 = this->p1;
+    const size_t n2 = this->period;
+    const size_t n3 = this->p2;
+    const double den1 = this->w1.denominator;
+    const double den2 = this->w2.denominator;
+    const double den3 = this->w3.denominator;
+    const helpers::RingView<double> r1 = this->w1.priceBuf.view();
+    const helpers::RingView<double> r2 = this->w2.priceBuf.view();
+    const helpers::RingView<double> r3 = this->w3.priceBuf.view();
+
+    // fusedCompute() across W lanes. A restarted path first fills its windows with
+    // the same scalar steps; the steady state then advances every lane at once in
+    // the same order, so each path rounds exactly like compute(). Samples leaving
+    // w1 and w2 come from the rings until a path has supplied them, then from a
+    // per-lane history of its last n2 inputs.
+    constexpr size_t G = detail::pathGroup;
+    const size_t group = detail::pathsPerGroup(layout);
+    const size_t groupTiles = group / W;
+
+    // Running sums and averages of the three windows, one column per lane.
+    struct Lanes {
+        double s1[W], ws1[W], a1[W];
+        double s2[W], ws2[W], a2[W];
+        double s3[W], ws3[W], a3[W];
+    };
+    std::array<Lanes, G> sums;
+    std::array<size_t, G> slots;
+    std::vector<double> lags(groupTiles * n3 * W);
+    std::vector<double> histories(groupTiles * n2 * W);
+    const double weight1 = static_cast<double>(n1);
+    const double weight2 = static_cast<double>(n2);
+    const double weight3 = static_cast<double>(n3);
+    const size_t steady = resumed ? 0 : n2;
+
+    for (size_t p0 = 0; p0 < pathCount; p0 += group) {
+        const size_t count = std::min(group, pathCount - p0);
+        const double* in = paths.data() + p0 * s.path;
+        double* out = output.data() + p0 * s.path;
 
-    // simd
-    for (size_t i = 0; i < pricesLen; ++i) {
-        wmaAOut[i] = 2.0 * wmaAOut[i] - wmaBOut[i];
+        for (size_t tile = 0; tile * W < count; tile++) {
+            const size_t width = std::min(W, count - tile * W);
+            Lanes& v = sums[tile];
+            double* lag = lags.data() + tile * n3 * W;
+            double* history = histories.data() + tile * n2 * W;
+            v = {};
+            slots[tile] = 0;
+
+            if (resumed) {
+                std::fill_n(v.s1, W, this->w1.rollingSum);
+                std::fill_n(v.ws1, W, this->w1.rollingWeightedSum);
+                std::fill_n(v.s2, W, this->w2.rollingSum);
+                std::fill_n(v.ws2, W, this->w2.rollingWeightedSum);
+                std::fill_n(v.s3, W, this->w3.rollingSum);
+                std::fill_n(v.ws3, W, this->w3.rollingWeightedSum);
+                for (size_t k = 0; k < n3; ++k) {
+                    std::fill_n(lag + k * W, W, r3[k]);
+                }
+                continue;
+            }
+
+            for (size_t l = 0; l < W; l++) {
+                // Padding lanes shadow the tile's first path, as the gather pads them.
+                const size_t path = tile * W + (l < width ? l : 0);
+                const double* x = in + path * s.path;
+                double s1 = 0.0, ws1 = 0.0, a1 = 0.0;
+                double s2 = 0.0, ws2 = 0.0, a2 = 0.0;
+                double s3 = 0.0, ws3 = 0.0, a3 = 0.0;
+                size_t slot = 0;
+                for (size_t t = 0; t < n2; ++t) {
+                    const double xt = x[t * s.time];
+                    history[t * W + l] = xt;
+
+                    if (t < n1) {
+                        s1 += xt;
+                        ws1 += xt * static_cast<double>(t + 1);
+                        a1 = (t + 1 == n1) ? ws1 / den1 : 0.0;
+                    } else {
+                        ws1 -= s1;
+                        s1 -= x[(t - n1) * s.time];
+                        s1 += xt;
+                        ws1 += xt * static_cast<double>(n1);
+                        a1 = ws1 / den1;
+                    }
+
+                    s2 += xt;
+                    ws2 += xt * static_cast<double>(t + 1);
+                    a2 = (t + 1 == n2) ? ws2 / den2 : 0.0;
+
+                    const double d = 2.0 * a1 - a2;
+                    if (t < n3) {
+                        s3 += d;
+                        ws3 += d * static_cast<double>(t + 1);
+                        lag[t * W + l] = d;
+                        if (t + 1 == n3) {
+                            a3 = ws3 / den3;
+                        }
+                    } else {
+                        ws3 -= s3;
+                        s3 -= lag[slot * W + l];
+                        s3 += d;
+                        ws3 += d * static_cast<double>(n3);
+                        lag[slot * W + l] = d;
+                        slot = (slot + 1 == n3) ? 0 : slot + 1;
+                        a3 = ws3 / den3;
+                    }
+                    if (l < width) {
+                        out[t * s.time + path * s.path] = t + 1 < n3 ? 0.0 : a3;
+                    }
+                }
+                v.s1[l] = s1, v.ws1[l] = ws1, v.a1[l] = a1;
+                v.s2[l] = s2, v.ws2[l] = ws2, v.a2[l] = a2;
+                v.s3[l] = s3, v.ws3[l] = ws3, v.a3[l] = a3;
+                slots[tile] = slot;
+            }
+        }
+
+        // Every tile of the group is at the same step, so they share one history head.
+        size_t head = 0;
+        size_t tilesDone = 0;
+        helpers::forEachLaneBlock<W, detail::pathBlock>(in + steady * s.time, out + steady * s.time, n - steady, s.time, s.path, count,
+            [&](size_t tile, const double* x, double* y, size_t t0, size_t rows) {
+                // A local copy the tile pointers cannot alias stays in registers.
+                Lanes v = sums[tile];
+                size_t slot = slots[tile];
+                size_t at = head;
+                double* lag = lags.data() + tile * n3 * W;
+                double* history = histories.data() + tile * n2 * W;
+                double old1[W], old2[W];
+                for (size_t k = 0; k < rows; k++, x += W, y += W) {
+                    const size_t t = steady + t0 + k;
+                    double* past = history + at * W;
+                    if (t < n1) {
+                        std::fill_n(old1, W, r1[t]);
+                    } else {
+                        std::copy_n(history + (at >= n1 ? at - n1 : at + n2 - n1) * W, W, old1);
+                    }
+                    if (t < n2) {
+                        std::fill_n(old2, W, r2[t]);
+                    } else {
+                        std::copy_n(past, W, old2);
+                    }
+                    double* d = lag + slot * W;
+
+                    for (size_t l = 0; l < W; l++) {
+                        v.ws1[l] -= v.s1[l];
+                        v.s1[l] -= old1[l];
+                        v.s1[l] += x[l];
+                        v.ws1[l] += x[l] * weight1;
+                        v.a1[l] = v.ws1[l] / den1;
+
+                        v.ws2[l] -= v.s2[l];
+                        v.s2[l] -= old2[l];
+                        v.s2[l] += x[l];
+                        v.ws2[l] += x[l] * weight2;
+                        v.a2[l] = v.ws2[l] / den2;
+
+                        const double dl = 2.0 * v.a1[l] - v.a2[l];
+                        v.ws3[l] -= v.s3[l];
+                        v.s3[l] -= d[l];
+                        v.s3[l] += dl;
+                        v.ws3[l] += dl * weight3;
+                        d[l] = dl;
+                        v.a3[l] = v.ws3[l] / den3;
+                        y[l] = v.a3[l];
+                    }
+                    std::copy_n(x, W, past);
+                    slot = (slot + 1 == n3) ? 0 : slot + 1;
+                    at = (at + 1 == n2) ? 0 : at + 1;
+                }
+                sums[tile] = v;
+                slots[tile] = slot;
+
+                // The last tile of the group moves the shared head on.
+                if (++tilesDone == (count + W - 1) / W) {
+                    tilesDone = 0;
+                    head = at;
+                }
+            });
+
+        if (finalStates.empty()) {
+            continue;
+        }
+        // Each window ends on its last samples of the ring followed by the path.
+        auto window = [&](const helpers::RingView<double>& ring, size_t len, size_t path) {
+            std::vector<double> buf;
+            buf.reserve(len);
+            const size_t fromRing = len > n ? len - n : 0;
+            for (size_t k = ring.size() - fromRing; k < ring.size(); k++) {
+                buf.push_back(ring[k]);
+            }
+            for (size_t t = n - (len - fromRing); t < n; t++) {
+                buf.push_back(in[t * s.time + path * s.path]);
+            }
+            return buf;
+        };
+        for (size_t i = 0; i < count; i++) {
+            const Lanes& v = sums[i / W];
+            const double* lag = lags.data() + (i / W) * n3 * W;
+            const size_t l = i % W;
+            HullMovingAverageState& state = finalStates[p0 + i];
+            state.p1 = this->p1;
+            state.p2 = this->p2;
+            state.period = this->period;
+            state.lastHull = v.a3[l];
+            state.initialized = true;
+            state.w1 = {.period = n1, .denominator = den1, .rollingSum = v.s1[l], .rollingWeightedSum = v.ws1[l], .initialized = true, .lastWma = v.a1[l], .priceBuf = window(r1, n1, i)};
+            state.w2 = {.period = n2, .denominator = den2, .rollingSum = v.s2[l], .rollingWeightedSum = v.ws2[l], .initialized = true, .lastWma = v.a2[l], .priceBuf = window(r2, n2, i)};
+            state.w3 = {.period = n3, .denominator = den3, .rollingSum = v.s3[l], .rollingWeightedSum = v.ws3[l], .initialized = true, .lastWma = v.a3[l], .priceBuf = {}};
+            state.w3.priceBuf.resize(n3);
+            for (size_t k = 0; k < n3; k++) {
+                state.w3.priceBuf[k] = lag[((slots[i / W] + k) % n3) * W + l];
+            }
+        }
     }
 
-    res = this->w3.compute(wmaAOut, output);
-    if (res != status::ok) {
-        return res;
+    return status::ok;
+}
+
+status tama::HullMovingAverage::update(std::span<const double> prices, std::span<double> output) {
+    if (prices.empty()) {
+        return status::emptyParams;
+    }
+    if (output.size() < prices.size()) {
+        return status::invalidParam;
+    }
+    if (!this->initialized) {
+        detail::throwNotInitialized("hma");
+    }
+
+    for (size_t t = 0; t < prices.size(); t++) {
+        const double w1 = this->w1.step(prices[t]);
+        const double w2 = this->w2.step(prices[t]);
+        output[t] = this->w3.step(2 * w1 - w2);
+    }
+
+    this->lastHull = output[prices.size() - 1];
+    return status::ok;
+}
+
+status tama::HullMovingAverage::peek(std::span<const double> candidates, std::span<double> output) const {
+    if (candidates.empty()) {
+        return status::emptyParams;
+    }
+    if (output.size() < candidates.size()) {
+        return status::invalidParam;
+    }
+    if (!this->initialized) {
+        detail::throwNotInitialized("hma");
+    }
+
+    // WeightedMovingAverage::peekStep() for each window, with the parts that do
+    // not depend on the candidate hoisted.
+    const double kept1 = this->w1.rollingWeightedSum - this->w1.rollingSum;
+    const double kept2 = this->w2.rollingWeightedSum - this->w2.rollingSum;
+    const double kept3 = this->w3.rollingWeightedSum - this->w3.rollingSum;
+    const double weight1 = static_cast<double>(this->w1.period);
+    const double weight2 = static_cast<double>(this->w2.period);
+    const double weight3 = static_cast<double>(this->w3.period);
+    const double den1 = this->w1.denominator;
+    const double den2 = this->w2.denominator;
+    const double den3 = this->w3.denominator;
+
+    for (size_t i = 0; i < candidates.size(); i++) {
+        const double x = candidates[i];
+        const double a1 = (kept1 + x * weight1) / den1;
+        const double a2 = (kept2 + x * weight2) / den2;
+        output[i] = (kept3 + (2 * a1 - a2) * weight3) / den3;
     }
-    
-    this->lastHull = output.back();
-    this->initialized = true;
-    
     return status::ok;
 }
 
-double tama::HullMovingAverage::latest() {
-    return this->lastHull;
+tama::HullMovingAverage tama::HullMovingAverage::fork() {
+    this->w1.priceBuf.share();
+    this->w2.priceBuf.share();
+    this->w3.priceBuf.share();
+    return *this;
+}
+
+void tama::HullMovingAverage::fusedCompute(std::span<const double> prices, std::span<double> output, size_t timeStride, bool resume) {
+    const size_t n = prices.size();
+    const size_t n1 = this->p1;
+    const size_t n2 = this->period;
+    const size_t n3 = this->p2;
+    const double den1 = this->w1.denominator;
+    const double den2 = this->w2.denominator;
+    const double den3 = this->w3.denominator;
+
+    // Each window keeps the accumulation order of WeightedMovingAverage::compute,
+    // so outputs and end states are bit-identical to the three separate passes.
+    double s1 = 0.0, ws1 = 0.0, a1 = 0.0;
+    double s2 = 0.0, ws2 = 0.0, a2 = 0.0;
+    double s3 = 0.0, ws3 = 0.0, a3 = 0.0;
+
+    // Last p2 values of 2*w1 - w2; lag[slot] is the oldest once the window is full.
+    std::array<double, maxSqrtPeriod> lag;
+    size_t slot = 0;
+
+    // Until this call has supplied a full window, a resumed pass reads the samples
+    // leaving w1 and w2 from their rings; a restart fills the windows first and
+    // never does. Both share the steady-state loop so they round alike.
+    const helpers::RingView<double> r1 = this->w1.priceBuf.view();
+    const helpers::RingView<double> r2 = this->w2.priceBuf.view();
+
+    // First sample handled by the steady-state loop below.
+    size_t steady = 0;
+
+    if (resume) {
+        const helpers::RingView<double> r3 = this->w3.priceBuf.view();
+        s1 = this->w1.rollingSum, ws1 = this->w1.rollingWeightedSum;
+        s2 = this->w2.rollingSum, ws2 = this->w2.rollingWeightedSum;
+        s3 = this->w3.rollingSum, ws3 = this->w3.rollingWeightedSum;
+        for (size_t k = 0; k < n3; ++k) {
+            lag[k] = r3[k];
+        }
+    } else {
+        for (size_t t = 0; t < n2; ++t) {
+            const double x = prices[t];
+
+            if (t < n1) {
+                s1 += x;
+                ws1 += x * static_cast<double>(t + 1);
+                a1 = (t + 1 == n1) ? ws1 / den1 : 0.0;
+            } else {
+                ws1 -= s1;
+                s1 -= prices[t - n1];
+                s1 += x;
+                ws1 += x * static_cast<double>(n1);
+                a1 = ws1 / den1;
+            }
+
+            s2 += x;
+            ws2 += x * static_cast<double>(t + 1);
+            a2 = (t + 1 == n2) ? ws2 / den2 : 0.0;
+
+            const double d = 2.0 * a1 - a2;
+            if (t < n3) {
+                s3 += d;
+                ws3 += d * static_cast<double>(t + 1);
+                lag[t] = d;
+                if (t + 1 == n3) {
+                    a3 = ws3 / den3;
+                    output[t * timeStride] = a3;
+                }
+            } else {
+                ws3 -= s3;
+                s3 -= lag[slot];
+                s3 += d;
+                ws3 += d * static_cast<double>(n3);
+                lag[slot] = d;
+                slot = (slot + 1 == n3) ? 0 : slot + 1;
+                a3 = ws3 / den3;
+                output[t * timeStride] = a3;
+            }
+        }
+        steady = n2;
+    }
+
+    for (size_t t = steady; t < n; ++t) {
+        const double x = prices[t];
+
+        ws1 -= s1;
+        s1 -= t < n1 ? r1[t] : prices[t - n1];
+        s1 += x;
+        ws1 += x * static_cast<double>(n1);
+        a1 = ws1 / den1;
+
+        ws2 -= s2;
+        s2 -= t < n2 ? r2[t] : prices[t - n2];
+        s2 += x;
+        ws2 += x * static_cast<double>(n2);
+        a2 = ws2 / den2;
+
+        const double d = 2.0 * a1 - a2;
+        ws3 -= s3;
+        s3 -= lag[slot];
+        s3 += d;
+        ws3 += d * static_cast<double>(n3);
+        lag[slot] = d;
+        slot = (slot + 1 == n3) ? 0 : slot + 1;
+        a3 = ws3 / den3;
+        output[t * timeStride] = a3;
+    }
+
+    // A span of at least a full window replaces the ring's contents.
+    this->w1.priceBuf.insert(prices.subspan(n - std::min(n, n1)));
+    this->w1.rollingSum = s1;
+    this->w1.rollingWeightedSum = ws1;
+    this->w1.lastWma = a1;
+    this->w1.initialized = true;
+
+    this->w2.priceBuf.insert(prices.subspan(n - std::min(n, n2)));
+    this->w2.rollingSum = s2;
+    this->w2.rollingWeightedSum = ws2;
+    this->w2.lastWma = a2;
+    this->w2.initialized = true;
+
+    this->w3.priceBuf.clear();
+    for (size_t k = 0; k < n3; ++k) {
+        this->w3.priceBuf.insert(lag[(slot + k) % n3]);
+    }
+    this->w3.rollingSum = s3;
+    this->w3.rollingWeightedSum = ws3;
+    this->w3.lastWma = a3;
+    this->w3.initialized = true;
 }
 
+tama::HullMovingAverage::HullMovingAverage(std::span<const std::byte> packed)
+    : HullMovingAverage([&] {
+          const auto header = helpers::unpackHeader<HullMovingAverageSnapshot>(packed);
+          size_t offset = sizeof(header);
+          return HullMovingAverageState{
+              .p1 = static_cast<uint16_t>(header.p1),
+              .p2 = static_cast<uint16_t>(header.p2),
+              .period = static_cast<uint16_t>(header.period),
+              .lastHull = header.lastHull,
+              .initialized = header.initialized != 0,
+              // Braced initializers run in order, so the windows are read back to back.
+              .w1 = WeightedMovingAverage::unpackState(header.w1, packed, offset),
+              .w2 = WeightedMovingAverage::unpackState(header.w2, packed, offset),
+              .w3 = WeightedMovingAverage::unpackState(header.w3, packed, offset)
+          };
+      }()) {}
+
 HullMovingAverageState tama::HullMovingAverage::getState() {
+    HullMovingAverageState state;
+    this->getState(state);
+    return state;
+}
+
+void tama::HullMovingAverage::getState(HullMovingAverageState& out) const {
+    out.p1 = this->p1;
+    out.p2 = this->p2;
+    out.period = this->period;
+    out.lastHull = this->lastHull;
+    out.initialized = this->initialized;
+    this->w1.getState(out.w1);
+    this->w2.getState(out.w2);
+    this->w3.getState(out.w3);
+}
+
+HullMovingAverageStateView tama::HullMovingAverage::view() const noexcept {
     return {
         .p1 = this->p1,
         .p2 = this->p2,
         .period = this->period,
         .lastHull = this->lastHull,
         .initialized = this->initialized,
-        .w1 = this->w1.getState(),
-        .w2 = this->w2.getState(),
-        .w3 = this->w3.getState()
+        .w1 = this->w1.view(),
+        .w2 = this->w2.view(),
+        .w3 = this->w3.view()
     };
 }
 
-double tama::HullMovingAverage::update(double price) {
-    if (!this->initialized) {
-        throw std::runtime_error("hma not initialized");
-    }
+size_t tama::HullMovingAverage::packedSize() const noexcept {
+    return helpers::packedSize<HullMovingAverageSnapshot>(this->w1.priceBuf.len() + this->w2.priceBuf.len() + this->w3.priceBuf.len());
+}
 
-    double w1 = this->w1.update(price);
-    double w2 = this->w2.update(price);
+status tama::HullMovingAverage::pack(std::span<std::byte> out) const noexcept {
+    if (out.size() < this->packedSize()) {
+        return status::invalidParam;
+    }
 
-    double res = this->w3.update(2 * w1 - w2);
-    this->lastHull = res;
-    return res;
-}
\ No newline at end of file
+    const HullMovingAverageSnapshot header{
+        .p1 = this->p1,
+        .p2 = this->p2,
+        .period = this->period,
+        .initialized = this->initialized,
+        .lastHull = this->lastHull,
+        .w1 = this->w1.snapshotHeader(),
+        .w2 = this->w2.snapshotHeader(),
+        .w3 = this->w3.snapshotHeader()
+    };
+    helpers::packSnapshot(out.data(), header, {this->w1.priceBuf.view(), this->w2.priceBuf.view(), this->w3.priceBuf.view()});
+    return status::ok;
+}
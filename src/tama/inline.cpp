@@ -0,0 +1,17 @@
+#include <tama/tama.hpp>
+#include <stdexcept>
+#include <string>
+
+void tama::detail::throwNotInitialized(const char* indicator) {
+    throw std::runtime_error(std::string(indicator) + " not initialized");
+}
+
+void tama::detail::throwNotAmendable(const char* indicator) {
+    throw std::runtime_error(std::string(indicator) + " cannot amend: value before the newest sample is unknown");
+}
+
+// Out-of-line hot paths for the default build; with TAMA_HEADER_INLINE every
+// consumer already sees them through tama.hpp.
+#ifndef TAMA_HEADER_INLINE
+#include <tama/inline.hpp>
+#endif
@@ -1,11 +1,28 @@
 #include <tama/tama.hpp>
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
+#include <type_traits>
+
+namespace {
+    // Runs `body` with `arithmetic` as a compile-time constant, so the per-sample
+    // loops below carry no branch on it.
+    template <typename Body>
+    void with_arithmetic(mdArithmetic arithmetic, Body&& body) {
+        if (arithmetic == mdArithmetic::fast) {
+            body(std::integral_constant<mdArithmetic, mdArithmetic::fast>{});
+        } else {
+            body(std::integral_constant<mdArithmetic, mdArithmetic::exact>{});
+        }
+    }
+}
 
-tama::McGinleyDynamicMovingAverage::McGinleyDynamicMovingAverage(uint16_t period, double prevCalculation)
+tama::McGinleyDynamicMovingAverage::McGinleyDynamicMovingAverage(uint16_t period, double prevCalculation, mdArithmetic arithmetic)
     : period(period),
+      invPeriod(1.0 / static_cast<double>(period)),
       lastMd(0.0),
-      initialized(false) {
+      initialized(false),
+      arithmetic(arithmetic) {
     if (period == 0) {
         throw std::invalid_argument("invalid period");
     }
@@ -18,8 +35,13 @@ tama::McGinleyDynamicMovingAverage::McGinleyDynamicMovingAverage(uint16_t period
 
 tama::McGinleyDynamicMovingAverage::McGinleyDynamicMovingAverage(McGinleyDynamicMovingAverageState prevCalculation)
     : period(prevCalculation.period),
+      invPeriod(1.0 / static_cast<double>(prevCalculation.period)),
       lastMd(prevCalculation.lastMd),
-      initialized(prevCalculation.initialized) {
+      initialized(prevCalculation.initialized),
+      arithmetic(prevCalculation.arithmetic),
+      prevMd(prevCalculation.prevMd),
+      hasPrevMd(prevCalculation.hasPrevMd),
+      newestSeeded(prevCalculation.newestSeeded) {
     if (this->period == 0) {
         throw std::invalid_argument("invalid period");
     }
@@ -29,55 +51,189 @@ tama::McGinleyDynamicMovingAverage::McGinleyDynamicMovingAverage(McGinleyDynamic
     }
 }
 
-status tama::McGinleyDynamicMovingAverage::compute(std::span<const double> prices, std::vector<double>& output) {
+status tama::McGinleyDynamicMovingAverage::compute(std::span<const double> prices, std::vector<double>& output, computeMode mode) {
+    if (output.size() < prices.size()) {
+        output.resize(prices.size());
+    }
+    return this->compute(prices, std::span<double>(output), mode);
+}
+
+status tama::McGinleyDynamicMovingAverage::compute(std::span<const double> prices, std::span<double> output, computeMode mode) {
     if (prices.empty()) {
         return status::emptyParams;
     }
 
     const size_t pricesLen = prices.size();
     if (output.size() < pricesLen) {
-        output.resize(pricesLen);
+        return status::invalidParam;
+    }
+
+    // A resumed series applies the recurrence to its first sample too.
+    const bool resumed = mode == computeMode::resume && this->initialized;
+    if (!resumed) {
+        output[0] = prices[0];
     }
 
-    output[0] = prices[0];
+    const double period = static_cast<double>(this->period);
+    with_arithmetic(this->arithmetic, [&](auto arithmetic) {
+        for (size_t t = resumed ? 0 : 1; t < pricesLen; t++) {
+            const double mt = t > 0 ? output[t - 1] : this->lastMd;
+            output[t] = detail::mdStep<arithmetic()>(mt, prices[t], period, this->invPeriod);
+        }
+    });
+
+    this->prevMd = pricesLen > 1 ? output[pricesLen - 2] : this->lastMd;
+    this->hasPrevMd = pricesLen > 1 || resumed;
+    this->newestSeeded = !this->hasPrevMd;
+    this->lastMd = output[pricesLen - 1];
+    this->initialized = true;
 
-    for (size_t t = 1; t < pricesLen; t++) {
-        const double pt = prices[t];
-        const double mt = output[t - 1];
+    return status::ok;
+}
 
-        const double numerator = pt - mt;
-        const double denominator = static_cast<double>(this->period) * std::pow(pt / mt, 4.0);
+status tama::McGinleyDynamicMovingAverage::computePaths(std::span<const double> paths, size_t pathCount, std::vector<double>& output, pathLayout layout, computeMode mode, std::span<McGinleyDynamicMovingAverageState> finalStates) const {
+    if (output.size() < paths.size()) {
+        output.resize(paths.size());
+    }
+    return this->computePaths(paths, pathCount, std::span<double>(output), layout, mode, finalStates);
+}
 
-        output[t] = numerator / denominator + mt;
+status tama::McGinleyDynamicMovingAverage::computePaths(std::span<const double> paths, size_t pathCount, std::span<double> output, pathLayout layout, computeMode mode, std::span<McGinleyDynamicMovingAverageState> finalStates) const {
+    detail::PathStrides s{};
+    const status checked = detail::checkPaths(paths.size(), pathCount, output.size(), finalStates.size(), layout, s);
+    if (checked != status::ok) {
+        return checked;
     }
 
-    this->lastMd = output.back();
-    this->initialized = true;
+    constexpr size_t W = detail::pathLanes;
+    const bool resumed = mode == computeMode::resume && this->initialized;
+    const double period = static_cast<double>(this->period);
+    const double invPeriod = this->invPeriod;
+
+    // compute()'s recurrence on W paths per tile. In exact arithmetic the ratio
+    // power stays a libm call per lane so every path rounds exactly as compute()
+    // would; the subtraction, division and update around it run across the lanes.
+    const size_t group = detail::pathsPerGroup(layout);
+    with_arithmetic(this->arithmetic, [&](auto arithmetic) {
+        for (size_t p0 = 0; p0 < pathCount; p0 += group) {
+            const size_t count = std::min(group, pathCount - p0);
+            double last[detail::pathGroup][W];
+            for (auto& tile : last) {
+                std::fill_n(tile, W, this->lastMd);
+            }
+
+            helpers::forEachLaneBlock<W, detail::pathBlock>(paths.data() + p0 * s.path, output.data() + p0 * s.path, s.steps, s.time, s.path, count,
+                [&](size_t tile, const double* x, double* y, size_t t0, size_t rows) {
+                    // Local copies the tile pointers cannot alias stay in registers.
+                    double mt[W];
+                    double scale[W];
+                    std::copy_n(last[tile], W, mt);
+                    for (size_t k = 0; k < rows; k++, x += W, y += W) {
+                        if (t0 + k == 0 && !resumed) {
+                            std::copy_n(x, W, mt);
+                        } else if constexpr (arithmetic() == mdArithmetic::fast) {
+                            for (size_t l = 0; l < W; l++) {
+                                mt[l] = detail::mdStep<mdArithmetic::fast>(mt[l], x[l], period, invPeriod);
+                            }
+                        } else {
+                            for (size_t l = 0; l < W; l++) {
+                                scale[l] = std::pow(x[l] / mt[l], 4.0);
+                            }
+                            for (size_t l = 0; l < W; l++) {
+                                const double numerator = x[l] - mt[l];
+                                const double denominator = period * scale[l];
+                                mt[l] = numerator / denominator + mt[l];
+                            }
+                        }
+                        std::copy_n(mt, W, y);
+                    }
+                    std::copy_n(mt, W, last[tile]);
+                });
+
+            if (!finalStates.empty()) {
+                // The value before each path's newest sample is its second-to-last output.
+                const bool stepped = s.steps > 1 || resumed;
+                for (size_t i = 0; i < count; i++) {
+                    const size_t p = p0 + i;
+                    finalStates[p] = {
+                        .period = this->period,
+                        .lastMd = last[i / W][i % W],
+                        .initialized = true,
+                        .arithmetic = this->arithmetic,
+                        .prevMd = s.steps > 1 ? output[(s.steps - 2) * s.time + p * s.path] : this->lastMd,
+                        .hasPrevMd = stepped,
+                        .newestSeeded = !stepped
+                    };
+                }
+            }
+        }
+    });
+
+    return status::ok;
+}
+
+status tama::McGinleyDynamicMovingAverage::update(std::span<const double> prices, std::span<double> output) {
+    if (prices.empty()) {
+        return status::emptyParams;
+    }
+    if (output.size() < prices.size()) {
+        return status::invalidParam;
+    }
+    if (!this->initialized) {
+        detail::throwNotInitialized("md");
+    }
 
+    const double period = static_cast<double>(this->period);
+    double mt = this->lastMd;
+    double before = mt;
+    with_arithmetic(this->arithmetic, [&](auto arithmetic) {
+        for (size_t t = 0; t < prices.size(); t++) {
+            before = mt;
+            mt = detail::mdStep<arithmetic()>(mt, prices[t], period, this->invPeriod);
+            output[t] = mt;
+        }
+    });
+
+    this->prevMd = before;
+    this->hasPrevMd = true;
+    this->newestSeeded = false;
+    this->lastMd = mt;
     return status::ok;
 }
 
-double tama::McGinleyDynamicMovingAverage::update(double price) {
+status tama::McGinleyDynamicMovingAverage::peek(std::span<const double> candidates, std::span<double> output) const {
+    if (candidates.empty()) {
+        return status::emptyParams;
+    }
+    if (output.size() < candidates.size()) {
+        return status::invalidParam;
+    }
     if (!this->initialized) {
-        throw std::runtime_error("md not initialized");
+        detail::throwNotInitialized("md");
     }
 
+    const double period = static_cast<double>(this->period);
     const double mt = this->lastMd;
-    const double numerator = price - mt;
-    const double denominator = static_cast<double>(this->period) * std::pow(price / mt, 4.0);
-
-    this->lastMd = numerator / denominator + mt;
-    return this->lastMd;
+    with_arithmetic(this->arithmetic, [&](auto arithmetic) {
+        for (size_t i = 0; i < candidates.size(); i++) {
+            output[i] = detail::mdStep<arithmetic()>(mt, candidates[i], period, this->invPeriod);
+        }
+    });
+    return status::ok;
 }
 
-double tama::McGinleyDynamicMovingAverage::latest() {
-    return this->lastMd;
+tama::McGinleyDynamicMovingAverage tama::McGinleyDynamicMovingAverage::fork() const {
+    return *this;
 }
 
 McGinleyDynamicMovingAverageState tama::McGinleyDynamicMovingAverage::getState() {
     return {
         .period = this->period,
         .lastMd = this->lastMd,
-        .initialized = this->initialized
+        .initialized = this->initialized,
+        .arithmetic = this->arithmetic,
+        .prevMd = this->prevMd,
+        .hasPrevMd = this->hasPrevMd,
+        .newestSeeded = this->newestSeeded
     };
 }
\ No newline at end of file
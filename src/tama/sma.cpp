@@ -6,13 +6,17 @@
 #include <stdexcept>
 
 namespace {
-std::vector<double> ring_to_vector(const helpers::RingBuffer<double>& buffer) {
-    std::vector<double> values;
-    values.reserve(buffer.len());
-    for (size_t i = 0; i < buffer.len(); ++i) {
-        values.push_back(buffer[i]);
-    }
-    return values;
+SimpleMovingAverageState unpack_state(std::span<const std::byte> packed) {
+    const auto header = helpers::unpackHeader<SimpleMovingAverageSnapshot>(packed);
+    size_t offset = sizeof(header);
+    return {
+        .alpha = header.alpha,
+        .period = header.period,
+        .rollingSum = header.rollingSum,
+        .initialized = header.initialized != 0,
+        .lastSma = header.lastSma,
+        .priceBuf = helpers::unpackValues(packed, offset, header.priceCount)
+    };
 }
 }
 
@@ -69,22 +73,279 @@ tama::SimpleMovingAverage::SimpleMovingAverage(SimpleMovingAverageState prevCalc
     }
 }
 
-double tama::SimpleMovingAverage::latest() {
-    return this->lastSma;
-}
+tama::SimpleMovingAverage::SimpleMovingAverage(std::span<const std::byte> packed)
+    : SimpleMovingAverage(unpack_state(packed)) {}
 
 SimpleMovingAverageState tama::SimpleMovingAverage::getState() {
+    SimpleMovingAverageState state;
+    this->getState(state);
+    return state;
+}
+
+void tama::SimpleMovingAverage::getState(SimpleMovingAverageState& out) const {
+    out.alpha = this->alpha;
+    out.period = this->period;
+    out.rollingSum = this->rollingSum;
+    out.initialized = this->initalized;
+    out.lastSma = this->lastSma;
+    this->priceBuf.view().assignTo(out.priceBuf);
+}
+
+SimpleMovingAverageStateView tama::SimpleMovingAverage::view() const noexcept {
     return {
         .alpha = this->alpha,
         .period = this->period,
         .rollingSum = this->rollingSum,
         .initialized = this->initalized,
         .lastSma = this->lastSma,
-        .priceBuf = ring_to_vector(this->priceBuf)
+        .priceBuf = this->priceBuf.view()
     };
 }
 
-status tama::SimpleMovingAverage::compute(std::span<const double> prices, std::vector<double>& output) {
+size_t tama::SimpleMovingAverage::packedSize() const noexcept {
+    return helpers::packedSize<SimpleMovingAverageSnapshot>(this->priceBuf.len());
+}
+
+status tama::SimpleMovingAverage::pack(std::span<std::byte> out) const noexcept {
+    if (out.size() < this->packedSize()) {
+        return status::invalidParam;
+    }
+
+    const SimpleMovingAverageSnapshot header{
+        .period = this->period,
+        .initialized = this->initalized,
+        .priceCount = this->priceBuf.len(),
+        .alpha = this->alpha,
+        .rollingSum = this->rollingSum,
+        .lastSma = this->lastSma
+    };
+    helpers::packSnapshot(out.data(), header, {this->priceBuf.view()});
+    return status::ok;
+}
+
+status tama::SimpleMovingAverage::compute(std::span<const double> prices, std::vector<double>& output, computeMode mode) {
+    if (output.size() < prices.size()) {
+        output.resize(prices.size());
+    }
+    return this->compute(prices, std::span<double>(output), mode);
+}
+
+status tama::SimpleMovingAverage::compute(std::span<const double> prices, std::span<double> output, computeMode mode) {
+    if (prices.empty()) {
+        return status::emptyParams;
+    }
+    const size_t pricesLen = prices.size();
+
+    if (output.size() < pricesLen) {
+        return status::invalidParam;
+    }
+
+    const bool resumed = mode == computeMode::resume && this->initalized;
+    if (!resumed && this->period >= pricesLen) {
+        return status::invalidParam;
+    }
+
+    // Samples leaving the window come from the ring until this call has supplied
+    // `period` of its own. A restart fills its window first and never reads it.
+    const helpers::RingView<double> window = this->priceBuf.view();
+    double sum = resumed ? this->rollingSum : 0.0;
+    size_t first = 0;
+
+    if (!resumed) {
+        std::fill(output.begin(), output.begin() + this->period - 1, 0.0);
+
+        sum = helpers::simdSum(prices.subspan(0, this->period));
+        output[this->period - 1] = this->alpha * sum;
+        first = this->period;
+    }
+
+    for (size_t t = first; t < pricesLen; t++) {
+        sum += prices[t] - (t < this->period ? window[t] : prices[t - this->period]);
+        output[t] = this->alpha * sum;
+    }
+
+    this->priceBuf.insert(prices);
+    this->rollingSum = sum;
+    this->initalized = true;
+    this->lastSma = output[pricesLen - 1];
+
+    return status::ok;
+}
+
+status tama::SimpleMovingAverage::computeBlocked(std::span<const double> prices, std::vector<double>& output) {
+    if (output.size() < prices.size()) {
+        output.resize(prices.size());
+    }
+    return this->computeBlocked(prices, std::span<double>(output));
+}
+
+status tama::SimpleMovingAverage::computeBlocked(std::span<const double> prices, std::span<double> output) {
+    if (prices.empty()) {
+        return status::emptyParams;
+    }
+    const size_t pricesLen = prices.size();
+    const size_t period = this->period;
+
+    if (output.size() < pricesLen || period >= pricesLen) {
+        return status::invalidParam;
+    }
+
+    std::fill(output.begin(), output.begin() + period - 1, 0.0);
+
+    // Each block starts from the exact sum of its first window; the scan then
+    // carries it across the rest of the block.
+    const size_t interval = detail::rebaseInterval(period);
+    double sum = 0.0;
+    for (size_t base = period - 1; base < pricesLen; base += interval) {
+        const size_t count = std::min(pricesLen, base + interval) - base - 1;
+        sum = helpers::simdSum(prices.subspan(base + 1 - period, period));
+        output[base] = this->alpha * sum;
+        sum = helpers::simdWindowScan(prices.subspan(base + 1, count), prices.subspan(base + 1 - period, count), this->alpha, sum, output.subspan(base + 1, count));
+    }
+
+    this->priceBuf.insert(prices);
+    this->rollingSum = sum;
+    this->initalized = true;
+    this->lastSma = output[pricesLen - 1];
+
+    return status::ok;
+}
+
+status tama::SimpleMovingAverage::update(std::span<const double> prices, std::span<double> output) {
+    if (prices.empty()) {
+        return status::emptyParams;
+    }
+    const size_t n = prices.size();
+    if (output.size() < n) {
+        return status::invalidParam;
+    }
+    if (!this->initalized) {
+        detail::throwNotInitialized("sma");
+    }
+
+    // The sample leaving the window comes from the ring for the first `period`
+    // ticks and from `prices` itself afterwards, so the ring is written once.
+    const helpers::RingView<double> window = this->priceBuf.view();
+    const size_t period = this->period;
+    const size_t warm = std::min(n, period);
+    const double alpha = this->alpha;
+    double sum = this->rollingSum;
+
+    for (size_t t = 0; t < warm; t++) {
+        sum -= window[t];
+        sum += prices[t];
+        output[t] = alpha * sum;
+    }
+    for (size_t t = warm; t < n; t++) {
+        sum -= prices[t - period];
+        sum += prices[t];
+        output[t] = alpha * sum;
+    }
+
+    this->priceBuf.insert(prices);
+    this->rollingSum = sum;
+    this->lastSma = output[n - 1];
+    return status::ok;
+}
+
+status tama::SimpleMovingAverage::peek(std::span<const double> candidates, std::span<double> output) const {
+    if (candidates.empty()) {
+        return status::emptyParams;
+    }
+    if (output.size() < candidates.size()) {
+        return status::invalidParam;
+    }
+    if (!this->initalized) {
+        detail::throwNotInitialized("sma");
+    }
+
+    // Only the incoming sample differs between candidates.
+    const double kept = this->rollingSum - this->priceBuf.head();
+    const double alpha = this->alpha;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        output[i] = alpha * (kept + candidates[i]);
+    }
+    return status::ok;
+}
+
+tama::SimpleMovingAverage tama::SimpleMovingAverage::fork() {
+    this->priceBuf.share();
+    return *this;
+}
+
+status tama::SimpleMovingAverage::sweep(std::span<const double> prices, std::span<const uint16_t> periods, std::vector<double>& output, sweepLayout layout) {
+    output.resize(periods.size() * prices.size());
+    return SimpleMovingAverage::sweep(prices, periods, std::span<double>(output), layout);
+}
+
+status tama::SimpleMovingAverage::sweep(std::span<const double> prices, std::span<const uint16_t> periods, std::span<double> output, sweepLayout layout, std::pmr::memory_resource* scratch) {
+    if (prices.empty() || periods.empty()) {
+        return status::emptyParams;
+    }
+    const size_t pricesLen = prices.size();
+    const size_t periodsLen = periods.size();
+    const auto [minPeriod, maxPeriod] = std::minmax_element(periods.begin(), periods.end());
+
+    if (*minPeriod == 0 || *maxPeriod >= pricesLen || output.size() < periodsLen * pricesLen) {
+        return status::invalidParam;
+    }
+
+    std::fill_n(output.begin(), periodsLen * pricesLen, 0.0);
+    const size_t rowStride = layout == sweepLayout::periodMajor ? pricesLen : 1;
+    const size_t colStride = layout == sweepLayout::periodMajor ? 1 : periodsLen;
+
+    helpers::blockedPrefixSums(pricesLen, *maxPeriod, scratch,
+        [&](size_t j, size_t) {
+            return std::pair{prices[j], 0.0};
+        },
+        [&](size_t start, size_t end, size_t base, std::span<const double> sums, std::span<const double>) {
+            for (size_t k = 0; k < periodsLen; k++) {
+                const size_t period = periods[k];
+                const double alpha = 1.0 / static_cast<double>(period);
+                double* row = output.data() + k * rowStride;
+
+                for (size_t t = std::max(start, period - 1); t < end; t++) {
+                    const size_t b = t + 1 - base;
+                    row[t * colStride] = alpha * (sums[b] - sums[b - period]);
+                }
+            }
+        });
+
+    return status::ok;
+}
+
+template <typename Sample, typename Accum>
+tama::BasicSimpleMovingAverage<Sample, Accum>::BasicSimpleMovingAverage(uint16_t period, std::vector<Sample> prevCalc)
+    : period(static_cast<size_t>(period)),
+      alpha(0),
+      priceBuf(period > 0 ? period : 1) {
+    if (this->period == 0) {
+        throw std::invalid_argument("invalid period");
+    }
+
+    this->alpha = Accum(1) / static_cast<Accum>(this->period);
+
+    if (!prevCalc.empty()) {
+        if (prevCalc.size() != this->period) {
+            throw std::invalid_argument("prevCalc buffer doesn't match period");
+        }
+
+        this->priceBuf.insert(prevCalc);
+        for (Sample price : prevCalc) {
+            this->rollingSum += price;
+        }
+        this->lastSma = static_cast<Sample>(this->alpha * this->rollingSum);
+        this->initialized = true;
+    }
+}
+
+template <typename Sample, typename Accum>
+Sample tama::BasicSimpleMovingAverage<Sample, Accum>::latest() {
+    return this->lastSma;
+}
+
+template <typename Sample, typename Accum>
+status tama::BasicSimpleMovingAverage<Sample, Accum>::compute(std::span<const Sample> prices, std::vector<Sample>& output) {
     if (prices.empty()) {
         return status::emptyParams;
     }
@@ -97,27 +358,30 @@ status tama::SimpleMovingAverage::compute(std::span<const double> prices, std::v
     if (output.size() < pricesLen) {
         output.resize(pricesLen);
     }
-    std::fill(output.begin(), output.begin() + this->period - 1, 0.0);
+    std::fill(output.begin(), output.begin() + this->period - 1, Sample(0));
+
+    Accum sum = 0;
+    for (size_t i = 0; i < this->period; i++) {
+        sum += prices[i];
+    }
+    output[this->period - 1] = static_cast<Sample>(this->alpha * sum);
 
-    double sum = helpers::simdSum(prices.subspan(0, this->period));
-    output[this->period - 1] = this->alpha * sum;
-    
     for (size_t t = this->period; t < pricesLen; t++) {
-        sum += prices[t] - prices[t - this->period];
-        output[t] = this->alpha * sum;
+        sum += static_cast<Accum>(prices[t]) - static_cast<Accum>(prices[t - this->period]);
+        output[t] = static_cast<Sample>(this->alpha * sum);
     }
 
-    std::span<const double> tail = prices.subspan(pricesLen - this->period, this->period);
-    this->priceBuf.insert(std::vector<double>(tail.begin(), tail.end()));
+    this->priceBuf.insert(prices.subspan(pricesLen - this->period, this->period));
     this->rollingSum = sum;
-    this->initalized = true;
-    this->lastSma = output.back();
+    this->initialized = true;
+    this->lastSma = output[pricesLen - 1];
 
     return status::ok;
 }
 
-double tama::SimpleMovingAverage::update(double price) {
-    if (!this->initalized) {
+template <typename Sample, typename Accum>
+Sample tama::BasicSimpleMovingAverage<Sample, Accum>::update(Sample price) {
+    if (!this->initialized) {
         throw std::runtime_error("sma not initialized");
     }
 
@@ -125,7 +389,9 @@ double tama::SimpleMovingAverage::update(double price) {
     this->rollingSum += price;
     this->priceBuf.insert(price);
 
-    double sma = this->alpha * this->rollingSum;
-    this->lastSma = sma;
-    return sma;
+    this->lastSma = static_cast<Sample>(this->alpha * this->rollingSum);
+    return this->lastSma;
 }
+
+template class tama::BasicSimpleMovingAverage<float, float>;
+template class tama::BasicSimpleMovingAverage<float, double>;
@@ -14,36 +14,17 @@ namespace {
 tama::TripleExponentialMovingAverage::TripleExponentialMovingAverage(uint16_t period, std::vector<double> prevCalc)
 	: period(static_cast<size_t>(require_period(period))),
 	  initialized(false),
-	  lastTema(0.0),
 	  ema1(period),
 	  ema2(period),
-	  ema3(period) {
+	  ema3(period),
+	  lastTema(0.0) {
 	if (!prevCalc.empty()) {
 		size_t psize = prevCalc.size();
 		if (psize != this->period) {
 			throw std::invalid_argument("prevCalc buffer doesn't match period");
 		}
 
-		std::vector<double> emaAOut(psize);
-		std::vector<double> emaBOut(psize);
-		std::vector<double> emaCOut(psize);
-
-		status res = this->ema1.compute(prevCalc, emaAOut);
-		if (res != status::ok) {
-			return;
-		}
-
-		res = this->ema2.compute(emaAOut, emaBOut);
-		if (res != status::ok) {
-			return;
-		}
-
-		res = this->ema3.compute(emaBOut, emaCOut);
-		if (res != status::ok) {
-			return;
-		}
-
-		this->lastTema = 3.0 * emaAOut.back() - 3.0 * emaBOut.back() + emaCOut.back();
+		this->fusedCompute(prevCalc, std::span<double>(&this->lastTema, 1), 0);
 		this->initialized = true;
 	}
 }
@@ -51,71 +32,125 @@ tama::TripleExponentialMovingAverage::TripleExponentialMovingAverage(uint16_t pe
 tama::TripleExponentialMovingAverage::TripleExponentialMovingAverage(TripleExponentialMovingAverageState prevCalculation)
 	: period(prevCalculation.period),
 	  initialized(prevCalculation.initialized),
-	  lastTema(prevCalculation.lastTema),
 	  ema1(prevCalculation.ema1),
 	  ema2(prevCalculation.ema2),
-	  ema3(prevCalculation.ema3) {
+	  ema3(prevCalculation.ema3),
+	  lastTema(prevCalculation.lastTema) {
 	if (this->period == 0) {
 		throw std::invalid_argument("invalid period");
 	}
+
+	const ExponentialMovingAverageState stages[] = {prevCalculation.ema1, prevCalculation.ema2, prevCalculation.ema3};
+	detail::requireCascadeStages(static_cast<double>(this->period), stages);
+}
+
+status tama::TripleExponentialMovingAverage::compute(std::span<const double> prices, std::vector<double>& output, computeMode mode) {
+	if (output.size() < prices.size()) {
+		output.resize(prices.size());
+	}
+	return this->compute(prices, std::span<double>(output), mode);
 }
 
-status tama::TripleExponentialMovingAverage::compute(std::span<const double> prices, std::vector<double>& output) {
+status tama::TripleExponentialMovingAverage::compute(std::span<const double> prices, std::span<double> output, computeMode mode) {
 	if (prices.empty()) {
 		return status::emptyParams;
 	}
 
 	const size_t pricesLen = prices.size();
 	if (output.size() < pricesLen) {
-		output.resize(pricesLen);
+		return status::invalidParam;
 	}
 
-	std::vector<double> emaAOut(pricesLen);
-	std::vector<double> emaBOut(pricesLen);
-	std::vector<double> emaCOut(pricesLen);
+	this->fusedCompute(prices, output, 1, mode == computeMode::resume && this->initialized);
 
-	status res = this->ema1.compute(prices, emaAOut);
-	if (res != status::ok) {
-		return res;
-	}
+	this->lastTema = output[pricesLen - 1];
+	this->initialized = true;
 
-	res = this->ema2.compute(emaAOut, emaBOut);
-	if (res != status::ok) {
-		return res;
-	}
+	return status::ok;
+}
 
-	res = this->ema3.compute(emaBOut, emaCOut);
-	if (res != status::ok) {
-		return res;
+status tama::TripleExponentialMovingAverage::update(std::span<const double> prices, std::span<double> output) {
+	if (prices.empty()) {
+		return status::emptyParams;
 	}
-
-	// simd
-	for (size_t i = 0; i < pricesLen; i++) {
-		output[i] = 3.0 * emaAOut[i] - 3.0 * emaBOut[i] + emaCOut[i];
+	if (output.size() < prices.size()) {
+		return status::invalidParam;
+	}
+	if (!this->initialized) {
+		detail::throwNotInitialized("tema");
 	}
 
-	this->lastTema = output.back();
-	this->initialized = true;
+	// The stage states stay in registers for the batch.
+	const double alpha1 = this->ema1.alpha;
+	const double oma1 = this->ema1.oma;
+	const double alpha2 = this->ema2.alpha;
+	const double oma2 = this->ema2.oma;
+	const double alpha3 = this->ema3.alpha;
+	const double oma3 = this->ema3.oma;
+	double e1 = this->ema1.lastEma;
+	double e2 = this->ema2.lastEma;
+	double e3 = this->ema3.lastEma;
+	double before1 = e1;
+	double before2 = e2;
+	double before3 = e3;
+	for (size_t t = 0; t < prices.size(); t++) {
+		before1 = e1;
+		before2 = e2;
+		before3 = e3;
+		e1 = alpha1 * prices[t] + oma1 * e1;
+		e2 = alpha2 * e1 + oma2 * e2;
+		e3 = alpha3 * e2 + oma3 * e3;
+		output[t] = 3.0 * e1 - 3.0 * e2 + e3;
+	}
 
+	this->ema1.markStepped(before1);
+	this->ema2.markStepped(before2);
+	this->ema3.markStepped(before3);
+	this->ema1.lastEma = e1;
+	this->ema2.lastEma = e2;
+	this->ema3.lastEma = e3;
+	this->lastTema = output[prices.size() - 1];
 	return status::ok;
 }
 
-double tama::TripleExponentialMovingAverage::update(double price) {
+status tama::TripleExponentialMovingAverage::peek(std::span<const double> candidates, std::span<double> output) const {
+	if (candidates.empty()) {
+		return status::emptyParams;
+	}
+	if (output.size() < candidates.size()) {
+		return status::invalidParam;
+	}
 	if (!this->initialized) {
-		throw std::runtime_error("tema not initialized");
+		detail::throwNotInitialized("tema");
 	}
 
-	const double ema1Value = this->ema1.update(price);
-	const double ema2Value = this->ema2.update(ema1Value);
-	const double ema3Value = this->ema3.update(ema2Value);
+	const double alpha1 = this->ema1.alpha;
+	const double oma1 = this->ema1.oma;
+	const double alpha2 = this->ema2.alpha;
+	const double oma2 = this->ema2.oma;
+	const double alpha3 = this->ema3.alpha;
+	const double oma3 = this->ema3.oma;
+	const double e1 = this->ema1.lastEma;
+	const double e2 = this->ema2.lastEma;
+	const double e3 = this->ema3.lastEma;
+	for (size_t i = 0; i < candidates.size(); i++) {
+		const double next1 = alpha1 * candidates[i] + oma1 * e1;
+		const double next2 = alpha2 * next1 + oma2 * e2;
+		const double next3 = alpha3 * next2 + oma3 * e3;
+		output[i] = 3.0 * next1 - 3.0 * next2 + next3;
+	}
+	return status::ok;
+}
 
-	const double tema = 3.0 * ema1Value - 3.0 * ema2Value + ema3Value;
-	this->lastTema = tema;
-	return tema;
+tama::TripleExponentialMovingAverage tama::TripleExponentialMovingAverage::fork() const {
+	return *this;
 }
 
-double tama::TripleExponentialMovingAverage::latest() {
-	return this->lastTema;
+void tama::TripleExponentialMovingAverage::fusedCompute(std::span<const double> prices, std::span<double> output, size_t timeStride, bool resume) {
+	ExponentialMovingAverage* const stages[3] = {&this->ema1, &this->ema2, &this->ema3};
+	const double coefficients[3] = {3.0, -3.0, 1.0};
+
+	ExponentialMovingAverage::cascade(stages, coefficients, prices, output, timeStride, resume);
 }
 
 TripleExponentialMovingAverageState tama::TripleExponentialMovingAverage::getState() {
@@ -128,3 +163,40 @@ TripleExponentialMovingAverageState tama::TripleExponentialMovingAverage::getSta
 		.ema3 = this->ema3.getState()
 	};
 }
+
+status tama::TripleExponentialMovingAverage::sweep(std::span<const double> prices, std::span<const uint16_t> periods, std::vector<double>& output, sweepLayout layout) {
+	output.resize(periods.size() * prices.size());
+	return TripleExponentialMovingAverage::sweep(prices, periods, std::span<double>(output), layout);
+}
+
+status tama::TripleExponentialMovingAverage::sweep(std::span<const double> prices, std::span<const uint16_t> periods, std::span<double> output, sweepLayout layout, std::pmr::memory_resource* scratch) {
+	if (prices.empty() || periods.empty()) {
+		return status::emptyParams;
+	}
+
+	const size_t pricesLen = prices.size();
+	const size_t periodsLen = periods.size();
+
+	if (output.size() < periodsLen * pricesLen) {
+		return status::invalidParam;
+	}
+
+	std::pmr::vector<double> alpha(periodsLen, scratch);
+	std::pmr::vector<double> oma(periodsLen, scratch);
+	std::pmr::vector<double> coefficients(3 * periodsLen, scratch);
+	for (size_t k = 0; k < periodsLen; k++) {
+		if (periods[k] == 0) {
+			return status::invalidParam;
+		}
+		alpha[k] = 2.0 / (static_cast<double>(periods[k]) + 1.0);
+		oma[k] = 1.0 - alpha[k];
+		coefficients[k] = 3.0;
+		coefficients[periodsLen + k] = -3.0;
+		coefficients[2 * periodsLen + k] = 1.0;
+	}
+
+	const bool periodMajor = layout == sweepLayout::periodMajor;
+	helpers::simdEmaCascade(prices, alpha, oma, coefficients, 3, output, periodMajor ? 1 : periodsLen, periodMajor ? pricesLen : 1);
+
+	return status::ok;
+}
@@ -1,15 +1,54 @@
+#include <algorithm>
 #include <vector>
 #include <tama/tama.hpp>
 #include <stdexcept>
 
 namespace {
-std::vector<double> ring_to_vector(const helpers::RingBuffer<double>& buffer) {
-    std::vector<double> values;
-    values.reserve(buffer.len());
-    for (size_t i = 0; i < buffer.len(); ++i) {
-        values.push_back(buffer[i]);
+VolumeWeightedMovingAverageState unpack_state(std::span<const std::byte> packed) {
+    const auto header = helpers::unpackHeader<VolumeWeightedMovingAverageSnapshot>(packed);
+    size_t offset = sizeof(header);
+    std::vector<double> prices = helpers::unpackValues(packed, offset, header.priceCount);
+    std::vector<double> volumes = helpers::unpackValues(packed, offset, header.volumeCount);
+    return {
+        .period = header.period,
+        .initialized = header.initialized != 0,
+        .rollingNumerator = header.rollingNumerator,
+        .rollingDenominator = header.rollingDenominator,
+        .lastCalculation = header.lastCalculation,
+        .priceBuf = std::move(prices),
+        .volumeBuf = std::move(volumes)
+    };
+}
+
+constexpr size_t vwma_block = 256;
+
+// Advances the rolling sums over `count` ticks. The window deltas and the
+// quotients are independent per tick and vectorize; only the two running sums
+// are carried serially, so the result does not depend on where blocks start.
+// Kept out of line: inlined into compute() the passes ran about half as fast.
+[[gnu::noinline]] void vwma_rolling_block(const double* prices, const double* volume, const double* oldPrices, const double* oldVolumes, size_t count,
+                                          double& numeratorSum, double& denominatorSum, double* output) {
+    alignas(64) double numerators[vwma_block];
+    alignas(64) double denominators[vwma_block];
+    for (size_t i = 0; i < count; i++) {
+        numerators[i] = prices[i] * volume[i] - oldPrices[i] * oldVolumes[i];
+        denominators[i] = volume[i] - oldVolumes[i];
     }
-    return values;
+
+    double numerator = numeratorSum;
+    double denominator = denominatorSum;
+    for (size_t i = 0; i < count; i++) {
+        numerator += numerators[i];
+        denominator += denominators[i];
+        numerators[i] = numerator;
+        denominators[i] = denominator;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        output[i] = numerators[i] / denominators[i];
+    }
+    numeratorSum = numerator;
+    denominatorSum = denominator;
 }
 }
 
@@ -84,23 +123,292 @@ tama::VolumeWeightedMovingAverage::VolumeWeightedMovingAverage(VolumeWeightedMov
     }
 }
 
-double tama::VolumeWeightedMovingAverage::latest() {
-    return this->lastCalculation;
-}
+tama::VolumeWeightedMovingAverage::VolumeWeightedMovingAverage(std::span<const std::byte> packed)
+    : VolumeWeightedMovingAverage(unpack_state(packed)) {}
 
 VolumeWeightedMovingAverageState tama::VolumeWeightedMovingAverage::getState() {
+    VolumeWeightedMovingAverageState state;
+    this->getState(state);
+    return state;
+}
+
+void tama::VolumeWeightedMovingAverage::getState(VolumeWeightedMovingAverageState& out) const {
+    out.period = this->period;
+    out.initialized = this->initialized;
+    out.rollingNumerator = this->rollingNumerator;
+    out.rollingDenominator = this->rollingDenominator;
+    out.lastCalculation = this->lastCalculation;
+    this->priceBuf.view().assignTo(out.priceBuf);
+    this->volumeBuf.view().assignTo(out.volumeBuf);
+}
+
+VolumeWeightedMovingAverageStateView tama::VolumeWeightedMovingAverage::view() const noexcept {
     return {
         .period = this->period,
         .initialized = this->initialized,
         .rollingNumerator = this->rollingNumerator,
         .rollingDenominator = this->rollingDenominator,
         .lastCalculation = this->lastCalculation,
-        .priceBuf = ring_to_vector(this->priceBuf),
-        .volumeBuf = ring_to_vector(this->volumeBuf)
+        .priceBuf = this->priceBuf.view(),
+        .volumeBuf = this->volumeBuf.view()
+    };
+}
+
+size_t tama::VolumeWeightedMovingAverage::packedSize() const noexcept {
+    return helpers::packedSize<VolumeWeightedMovingAverageSnapshot>(this->priceBuf.len() + this->volumeBuf.len());
+}
+
+status tama::VolumeWeightedMovingAverage::pack(std::span<std::byte> out) const noexcept {
+    if (out.size() < this->packedSize()) {
+        return status::invalidParam;
+    }
+
+    const VolumeWeightedMovingAverageSnapshot header{
+        .period = this->period,
+        .initialized = this->initialized,
+        .priceCount = this->priceBuf.len(),
+        .volumeCount = this->volumeBuf.len(),
+        .rollingNumerator = this->rollingNumerator,
+        .rollingDenominator = this->rollingDenominator,
+        .lastCalculation = this->lastCalculation
     };
+    helpers::packSnapshot(out.data(), header, {this->priceBuf.view(), this->volumeBuf.view()});
+    return status::ok;
+}
+
+status tama::VolumeWeightedMovingAverage::compute(std::span<const double> prices, std::span<const double> volume, std::vector<double>& output, computeMode mode) {
+    if (output.size() < prices.size()) {
+        output.resize(prices.size());
+    }
+    return this->compute(prices, volume, std::span<double>(output), mode);
+}
+
+status tama::VolumeWeightedMovingAverage::compute(std::span<const double> prices, std::span<const double> volume, std::span<double> output, computeMode mode) {
+    const size_t pricesLen = prices.size();
+    const size_t volumeLen = volume.size();
+
+    if (pricesLen == 0 || volumeLen == 0) {
+        return status::emptyParams;
+    }
+
+    if (pricesLen != volumeLen || output.size() < pricesLen) {
+        return status::invalidParam;
+    }
+
+    const bool resumed = mode == computeMode::resume && this->initialized;
+    if (!resumed && this->period >= pricesLen) {
+        return status::invalidParam;
+    }
+
+    // Samples leaving the window come from the rings until this call has supplied
+    // `period` of its own. A restart fills its window first and never reads them.
+    const helpers::RingView<double> priceWindow = this->priceBuf.view();
+    const helpers::RingView<double> volumeWindow = this->volumeBuf.view();
+    double numeratorSum = resumed ? this->rollingNumerator : 0.0;
+    double denominatorSum = resumed ? this->rollingDenominator : 0.0;
+    size_t first = 0;
+
+    if (!resumed) {
+        std::fill(output.begin(), output.begin() + this->period - 1, 0.0);
+
+        // Runs once per call over a single window, so the seed stays a plain loop.
+        for (size_t i = 0; i < this->period; i++) {
+            numeratorSum += prices[i] * volume[i];
+            denominatorSum += volume[i];
+        }
+        output[this->period - 1] = numeratorSum / denominatorSum;
+        first = this->period;
+    }
+
+    // Ring samples are copied out a block at a time so that both sources go
+    // through the same kernel and round identically.
+    alignas(64) double ringPrices[vwma_block];
+    alignas(64) double ringVolumes[vwma_block];
+    for (size_t t = first; t < pricesLen;) {
+        const bool fromRing = t < this->period;
+        const size_t count = std::min(vwma_block, (fromRing ? std::min(this->period, pricesLen) : pricesLen) - t);
+        const double* oldPrices = ringPrices;
+        const double* oldVolumes = ringVolumes;
+        if (fromRing) {
+            for (size_t i = 0; i < count; i++) {
+                ringPrices[i] = priceWindow[t + i];
+                ringVolumes[i] = volumeWindow[t + i];
+            }
+        } else {
+            oldPrices = prices.data() + t - this->period;
+            oldVolumes = volume.data() + t - this->period;
+        }
+
+        vwma_rolling_block(prices.data() + t, volume.data() + t, oldPrices, oldVolumes, count, numeratorSum, denominatorSum, output.data() + t);
+        t += count;
+    }
+
+    this->priceBuf.insert(prices);
+    this->volumeBuf.insert(volume);
+
+    this->lastCalculation = output[pricesLen - 1];
+    this->rollingNumerator = numeratorSum;
+    this->rollingDenominator = denominatorSum;
+    this->initialized = true;
+
+    return status::ok;    
+}
+
+status tama::VolumeWeightedMovingAverage::update(std::span<const double> prices, std::span<const double> volume, std::span<double> output) {
+    const size_t n = prices.size();
+    if (n == 0 || volume.empty()) {
+        return status::emptyParams;
+    }
+    if (volume.size() != n || output.size() < n) {
+        return status::invalidParam;
+    }
+    if (!this->initialized) {
+        detail::throwNotInitialized("vwma");
+    }
+
+    // Evicted samples come from the rings for the first `period` ticks and
+    // from the inputs afterwards, as in SimpleMovingAverage::update(span).
+    const helpers::RingView<double> priceWindow = this->priceBuf.view();
+    const helpers::RingView<double> volumeWindow = this->volumeBuf.view();
+    const size_t period = this->period;
+    const size_t warm = std::min(n, period);
+    double numerator = this->rollingNumerator;
+    double denominator = this->rollingDenominator;
+
+    for (size_t t = 0; t < warm; t++) {
+        numerator -= priceWindow[t] * volumeWindow[t];
+        numerator += prices[t] * volume[t];
+        denominator -= volumeWindow[t];
+        denominator += volume[t];
+        output[t] = numerator / denominator;
+    }
+    for (size_t t = warm; t < n; t++) {
+        numerator -= prices[t - period] * volume[t - period];
+        numerator += prices[t] * volume[t];
+        denominator -= volume[t - period];
+        denominator += volume[t];
+        output[t] = numerator / denominator;
+    }
+
+    this->priceBuf.insert(prices);
+    this->volumeBuf.insert(volume);
+    this->rollingNumerator = numerator;
+    this->rollingDenominator = denominator;
+    this->lastCalculation = output[n - 1];
+    return status::ok;
+}
+
+status tama::VolumeWeightedMovingAverage::peek(std::span<const double> candidates, std::span<const double> volume, std::span<double> output) const {
+    if (candidates.empty() || volume.empty()) {
+        return status::emptyParams;
+    }
+    const size_t n = candidates.size();
+    if (volume.size() != n || output.size() < n) {
+        return status::invalidParam;
+    }
+    if (!this->initialized) {
+        detail::throwNotInitialized("vwma");
+    }
+
+    const double keptNumerator = this->rollingNumerator - this->priceBuf.head() * this->volumeBuf.head();
+    const double keptDenominator = this->rollingDenominator - this->volumeBuf.head();
+    for (size_t i = 0; i < n; i++) {
+        output[i] = (keptNumerator + candidates[i] * volume[i]) / (keptDenominator + volume[i]);
+    }
+    return status::ok;
+}
+
+tama::VolumeWeightedMovingAverage tama::VolumeWeightedMovingAverage::fork() {
+    this->priceBuf.share();
+    this->volumeBuf.share();
+    return *this;
+}
+
+status tama::VolumeWeightedMovingAverage::sweep(std::span<const double> prices, std::span<const double> volume, std::span<const uint16_t> periods, std::vector<double>& output, sweepLayout layout) {
+    output.resize(periods.size() * prices.size());
+    return VolumeWeightedMovingAverage::sweep(prices, volume, periods, std::span<double>(output), layout);
+}
+
+status tama::VolumeWeightedMovingAverage::sweep(std::span<const double> prices, std::span<const double> volume, std::span<const uint16_t> periods, std::span<double> output, sweepLayout layout, std::pmr::memory_resource* scratch) {
+    const size_t pricesLen = prices.size();
+    const size_t volumeLen = volume.size();
+    const size_t periodsLen = periods.size();
+
+    if (pricesLen == 0 || volumeLen == 0 || periodsLen == 0) {
+        return status::emptyParams;
+    }
+
+    const auto [minPeriod, maxPeriod] = std::minmax_element(periods.begin(), periods.end());
+    if (pricesLen != volumeLen || *minPeriod == 0 || *maxPeriod >= pricesLen || output.size() < periodsLen * pricesLen) {
+        return status::invalidParam;
+    }
+
+    std::fill_n(output.begin(), periodsLen * pricesLen, 0.0);
+    const size_t rowStride = layout == sweepLayout::periodMajor ? pricesLen : 1;
+    const size_t colStride = layout == sweepLayout::periodMajor ? 1 : periodsLen;
+
+    helpers::blockedPrefixSums(pricesLen, *maxPeriod, scratch,
+        [&](size_t j, size_t) {
+            return std::pair{prices[j] * volume[j], volume[j]};
+        },
+        [&](size_t start, size_t end, size_t base, std::span<const double> numeratorSums, std::span<const double> denominatorSums) {
+            for (size_t k = 0; k < periodsLen; k++) {
+                const size_t period = periods[k];
+                double* row = output.data() + k * rowStride;
+
+                for (size_t t = std::max(start, period - 1); t < end; t++) {
+                    const size_t b = t + 1 - base;
+                    const size_t a = b - period;
+                    row[t * colStride] = (numeratorSums[b] - numeratorSums[a]) / (denominatorSums[b] - denominatorSums[a]);
+                }
+            }
+        });
+
+    return status::ok;
+}
+
+template <typename Sample, typename Accum>
+tama::BasicVolumeWeightedMovingAverage<Sample, Accum>::BasicVolumeWeightedMovingAverage(uint16_t period, std::vector<Sample> prevPrices, std::vector<Sample> prevVolume)
+    : period(static_cast<size_t>(period)),
+      priceBuf(period > 0 ? period : 1),
+      volumeBuf(period > 0 ? period : 1) {
+    if (this->period == 0) {
+        throw std::invalid_argument("invalid period");
+    }
+
+    if (prevPrices.empty() != prevVolume.empty()) {
+        throw std::invalid_argument("prevPrices and prevVolume must both be empty or both be provided");
+    }
+
+    if (!prevPrices.empty()) {
+        if (prevPrices.size() != this->period) {
+            throw std::invalid_argument("prevPrices buffer doesn't match period");
+        }
+
+        if (prevVolume.size() != this->period) {
+            throw std::invalid_argument("prevVolume buffer doesn't match period");
+        }
+
+        this->priceBuf.insert(prevPrices);
+        this->volumeBuf.insert(prevVolume);
+
+        for (size_t i = 0; i < this->period; i++) {
+            this->rollingNumerator += static_cast<Accum>(prevPrices[i]) * static_cast<Accum>(prevVolume[i]);
+            this->rollingDenominator += prevVolume[i];
+        }
+
+        this->lastCalculation = static_cast<Sample>(this->rollingNumerator / this->rollingDenominator);
+        this->initialized = true;
+    }
 }
 
-status tama::VolumeWeightedMovingAverage::compute(std::span<const double> prices, std::span<const double> volume, std::vector<double>& output) {
+template <typename Sample, typename Accum>
+Sample tama::BasicVolumeWeightedMovingAverage<Sample, Accum>::latest() {
+    return this->lastCalculation;
+}
+
+template <typename Sample, typename Accum>
+status tama::BasicVolumeWeightedMovingAverage<Sample, Accum>::compute(std::span<const Sample> prices, std::span<const Sample> volume, std::vector<Sample>& output) {
     const size_t pricesLen = prices.size();
     const size_t volumeLen = volume.size();
 
@@ -116,47 +424,44 @@ status tama::VolumeWeightedMovingAverage::compute(std::span<const double> prices
         output.resize(pricesLen);
     }
 
-    double numeratorSum = 0.0;
-    double denominatorSum = 0.0;
+    Accum numeratorSum = 0;
+    Accum denominatorSum = 0;
 
-    // simd
     for (size_t i = 0; i < this->period; i++) {
-        numeratorSum += prices[i] * volume[i];
+        numeratorSum += static_cast<Accum>(prices[i]) * static_cast<Accum>(volume[i]);
         denominatorSum += volume[i];
     }
-    output[this->period - 1] = numeratorSum / denominatorSum;
+    output[this->period - 1] = static_cast<Sample>(numeratorSum / denominatorSum);
 
     for (size_t t = this->period; t < pricesLen; t++) {
-        numeratorSum -= prices[t - this->period] * volume[t - this->period];
-        numeratorSum += prices[t] * volume[t];
+        numeratorSum -= static_cast<Accum>(prices[t - this->period]) * static_cast<Accum>(volume[t - this->period]);
+        numeratorSum += static_cast<Accum>(prices[t]) * static_cast<Accum>(volume[t]);
 
         denominatorSum -= volume[t - this->period];
         denominatorSum += volume[t];
 
-        output[t] = numeratorSum / denominatorSum;
+        output[t] = static_cast<Sample>(numeratorSum / denominatorSum);
     }
 
-    std::span<const double> pricesTail = prices.subspan(pricesLen - this->period, this->period);
-    this->priceBuf.insert(std::vector<double>(pricesTail.begin(), pricesTail.end()));
-
-    std::span<const double> volumeTail = volume.subspan(volumeLen - this->period, this->period);
-    this->volumeBuf.insert(std::vector<double>(volumeTail.begin(), volumeTail.end()));
+    this->priceBuf.insert(prices.subspan(pricesLen - this->period, this->period));
+    this->volumeBuf.insert(volume.subspan(volumeLen - this->period, this->period));
 
-    this->lastCalculation = output.back();
+    this->lastCalculation = output[pricesLen - 1];
     this->rollingNumerator = numeratorSum;
     this->rollingDenominator = denominatorSum;
     this->initialized = true;
 
-    return status::ok;    
+    return status::ok;
 }
 
-double tama::VolumeWeightedMovingAverage::update(double price, double volume) {
+template <typename Sample, typename Accum>
+Sample tama::BasicVolumeWeightedMovingAverage<Sample, Accum>::update(Sample price, Sample volume) {
     if (!this->initialized) {
         throw std::runtime_error("vwma not initialized");
     }
 
-    this->rollingNumerator -= this->priceBuf.head() * this->volumeBuf.head();
-    this->rollingNumerator += price * volume;
+    this->rollingNumerator -= static_cast<Accum>(this->priceBuf.head()) * static_cast<Accum>(this->volumeBuf.head());
+    this->rollingNumerator += static_cast<Accum>(price) * static_cast<Accum>(volume);
 
     this->rollingDenominator -= this->volumeBuf.head();
     this->rollingDenominator += volume;
@@ -164,9 +469,9 @@ double tama::VolumeWeightedMovingAverage::update(double price, double volume) {
     this->priceBuf.insert(price);
     this->volumeBuf.insert(volume);
 
-    double calc = this->rollingNumerator / this->rollingDenominator;
-
-    this->lastCalculation = calc;
+    this->lastCalculation = static_cast<Sample>(this->rollingNumerator / this->rollingDenominator);
+    return this->lastCalculation;
+}
 
-    return calc;
-}
\ No newline at end of file
+template class tama::BasicVolumeWeightedMovingAverage<float, float>;
+template class tama::BasicVolumeWeightedMovingAverage<float, double>;
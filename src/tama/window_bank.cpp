@@ -0,0 +1,450 @@
+#include <map>
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+#include <tama/tama.hpp>
+#include <helpers/helpers.hpp>
+
+namespace {
+    // Instruments grouped by (period, initialized); each group becomes one bucket.
+    using BucketGroups = std::map<std::pair<size_t, bool>, std::vector<size_t>>;
+
+    template <typename State>
+    BucketGroups group_states(std::span<const State> states) {
+        if (states.empty()) {
+            throw std::invalid_argument("empty bank");
+        }
+
+        BucketGroups groups;
+        for (size_t i = 0; i < states.size(); i++) {
+            const State& state = states[i];
+
+            if (state.period == 0) {
+                throw std::invalid_argument("invalid period");
+            }
+
+            if (!state.priceBuf.empty() && state.priceBuf.size() != state.period) {
+                throw std::invalid_argument("priceBuf size doesn't match period");
+            }
+
+            if (state.initialized && state.priceBuf.size() != state.period) {
+                throw std::invalid_argument("initialized bank state requires a full buffer");
+            }
+
+            groups[{state.period, state.initialized}].push_back(i);
+        }
+        return groups;
+    }
+
+    template <typename State>
+    std::vector<State> fresh_states(std::span<const uint16_t> periods) {
+        std::vector<State> states(periods.size());
+        for (size_t i = 0; i < periods.size(); i++) {
+            states[i].period = periods[i];
+        }
+        return states;
+    }
+
+    std::vector<double> slab_to_vector(const helpers::WindowSlab<double>& slab, size_t lane) {
+        std::vector<double> values;
+        if (!slab.full()) {
+            return values;
+        }
+
+        values.reserve(slab.len());
+        for (size_t i = 0; i < slab.len(); ++i) {
+            values.push_back(slab.at(i, lane));
+        }
+        return values;
+    }
+}
+
+namespace tama {
+    SimpleMovingAverageBank::SimpleMovingAverageBank(std::span<const uint16_t> periods)
+        : SimpleMovingAverageBank(fresh_states<SimpleMovingAverageState>(periods)) {}
+
+    SimpleMovingAverageBank::SimpleMovingAverageBank(std::span<const SimpleMovingAverageState> prevCalculations)
+        : lanes(prevCalculations.size()),
+          lastSma(prevCalculations.size(), 0.0) {
+        for (auto& [key, instruments] : group_states(prevCalculations)) {
+            const auto [period, initialized] = key;
+            const size_t width = instruments.size();
+
+            Bucket bucket{
+                .period = period,
+                .alpha = 1.0 / static_cast<double>(period),
+                .instruments = instruments,
+                .priceBuf = helpers::WindowSlab<double>(period, width),
+                .rollingSum = helpers::AlignedVector<double>(width, 0.0),
+                .prices = helpers::AlignedVector<double>(width, 0.0),
+                .lastSma = helpers::AlignedVector<double>(width, 0.0)
+            };
+
+            for (size_t l = 0; l < width; l++) {
+                const SimpleMovingAverageState& state = prevCalculations[instruments[l]];
+                if (initialized) {
+                    bucket.rollingSum[l] = state.rollingSum;
+                    bucket.lastSma[l] = state.lastSma;
+                    this->lastSma[instruments[l]] = state.lastSma;
+                }
+                this->lanes[instruments[l]] = {this->buckets.size(), l};
+            }
+
+            for (size_t k = 0; initialized && k < period; k++) {
+                double* slot = bucket.priceBuf.next();
+                for (size_t l = 0; l < width; l++) {
+                    slot[l] = prevCalculations[instruments[l]].priceBuf[k];
+                }
+                bucket.priceBuf.advance();
+            }
+
+            this->buckets.push_back(std::move(bucket));
+        }
+    }
+
+    status SimpleMovingAverageBank::update(std::span<const double> prices) {
+        if (prices.empty()) {
+            return status::emptyParams;
+        }
+
+        if (prices.size() != this->lastSma.size()) {
+            return status::invalidParam;
+        }
+
+        for (Bucket& bucket : this->buckets) {
+            const size_t width = bucket.instruments.size();
+            const double alpha = bucket.alpha;
+            double* x = bucket.prices.data();
+            double* sum = bucket.rollingSum.data();
+            double* out = bucket.lastSma.data();
+            double* slot = bucket.priceBuf.next();
+
+            for (size_t l = 0; l < width; l++) {
+                x[l] = prices[bucket.instruments[l]];
+            }
+
+            if (bucket.priceBuf.full()) {
+                for (size_t l = 0; l < width; l++) {
+                    sum[l] -= slot[l];
+                    sum[l] += x[l];
+                    slot[l] = x[l];
+                    out[l] = alpha * sum[l];
+                }
+            } else {
+                for (size_t l = 0; l < width; l++) {
+                    sum[l] += x[l];
+                    slot[l] = x[l];
+                }
+
+                if (bucket.priceBuf.len() + 1 == bucket.period) {
+                    for (size_t l = 0; l < width; l++) {
+                        out[l] = alpha * sum[l];
+                    }
+                }
+            }
+            bucket.priceBuf.advance();
+
+            for (size_t l = 0; l < width; l++) {
+                this->lastSma[bucket.instruments[l]] = out[l];
+            }
+        }
+
+        return status::ok;
+    }
+
+    std::span<const double> SimpleMovingAverageBank::latest() {
+        return this->lastSma;
+    }
+
+    size_t SimpleMovingAverageBank::size() {
+        return this->lastSma.size();
+    }
+
+    SimpleMovingAverageState SimpleMovingAverageBank::getState(size_t instrument) {
+        if (instrument >= this->lanes.size()) {
+            throw std::out_of_range("instrument out of range");
+        }
+
+        const auto [b, lane] = this->lanes[instrument];
+        const Bucket& bucket = this->buckets[b];
+
+        return {
+            .alpha = bucket.alpha,
+            .period = bucket.period,
+            .rollingSum = bucket.priceBuf.full() ? bucket.rollingSum[lane] : 0.0,
+            .initialized = bucket.priceBuf.full(),
+            .lastSma = bucket.lastSma[lane],
+            .priceBuf = slab_to_vector(bucket.priceBuf, lane)
+        };
+    }
+
+
+    WeightedMovingAverageBank::WeightedMovingAverageBank(std::span<const uint16_t> periods)
+        : WeightedMovingAverageBank(fresh_states<WeightedMovingAverageState>(periods)) {}
+
+    WeightedMovingAverageBank::WeightedMovingAverageBank(std::span<const WeightedMovingAverageState> prevCalculations)
+        : lanes(prevCalculations.size()),
+          lastWma(prevCalculations.size(), 0.0) {
+        for (auto& [key, instruments] : group_states(prevCalculations)) {
+            const auto [period, initialized] = key;
+            const size_t width = instruments.size();
+
+            Bucket bucket{
+                .period = period,
+                .denominator = static_cast<double>(period) * static_cast<double>(period + 1) / 2.0,
+                .instruments = instruments,
+                .priceBuf = helpers::WindowSlab<double>(period, width),
+                .rollingSum = helpers::AlignedVector<double>(width, 0.0),
+                .rollingWeightedSum = helpers::AlignedVector<double>(width, 0.0),
+                .prices = helpers::AlignedVector<double>(width, 0.0),
+                .lastWma = helpers::AlignedVector<double>(width, 0.0)
+            };
+
+            for (size_t l = 0; l < width; l++) {
+                const WeightedMovingAverageState& state = prevCalculations[instruments[l]];
+                if (initialized) {
+                    bucket.rollingSum[l] = state.rollingSum;
+                    bucket.rollingWeightedSum[l] = state.rollingWeightedSum;
+                    bucket.lastWma[l] = state.lastWma;
+                    this->lastWma[instruments[l]] = state.lastWma;
+                }
+                this->lanes[instruments[l]] = {this->buckets.size(), l};
+            }
+
+            for (size_t k = 0; initialized && k < period; k++) {
+                double* slot = bucket.priceBuf.next();
+                for (size_t l = 0; l < width; l++) {
+                    slot[l] = prevCalculations[instruments[l]].priceBuf[k];
+                }
+                bucket.priceBuf.advance();
+            }
+
+            this->buckets.push_back(std::move(bucket));
+        }
+    }
+
+    status WeightedMovingAverageBank::update(std::span<const double> prices) {
+        if (prices.empty()) {
+            return status::emptyParams;
+        }
+
+        if (prices.size() != this->lastWma.size()) {
+            return status::invalidParam;
+        }
+
+        for (Bucket& bucket : this->buckets) {
+            const size_t width = bucket.instruments.size();
+            const double denominator = bucket.denominator;
+            double* x = bucket.prices.data();
+            double* sum = bucket.rollingSum.data();
+            double* weightedSum = bucket.rollingWeightedSum.data();
+            double* out = bucket.lastWma.data();
+            double* slot = bucket.priceBuf.next();
+
+            for (size_t l = 0; l < width; l++) {
+                x[l] = prices[bucket.instruments[l]];
+            }
+
+            if (bucket.priceBuf.full()) {
+                const double period = static_cast<double>(bucket.period);
+                for (size_t l = 0; l < width; l++) {
+                    const double oldSum = sum[l];
+                    weightedSum[l] = weightedSum[l] - oldSum + (x[l] * period);
+                    sum[l] = oldSum - slot[l] + x[l];
+                    slot[l] = x[l];
+                    out[l] = weightedSum[l] / denominator;
+                }
+            } else {
+                const double weight = static_cast<double>(bucket.priceBuf.len() + 1);
+                for (size_t l = 0; l < width; l++) {
+                    sum[l] += x[l];
+                    weightedSum[l] += x[l] * weight;
+                    slot[l] = x[l];
+                }
+
+                if (bucket.priceBuf.len() + 1 == bucket.period) {
+                    for (size_t l = 0; l < width; l++) {
+                        out[l] = weightedSum[l] / denominator;
+                    }
+                }
+            }
+            bucket.priceBuf.advance();
+
+            for (size_t l = 0; l < width; l++) {
+                this->lastWma[bucket.instruments[l]] = out[l];
+            }
+        }
+
+        return status::ok;
+    }
+
+    std::span<const double> WeightedMovingAverageBank::latest() {
+        return this->lastWma;
+    }
+
+    size_t WeightedMovingAverageBank::size() {
+        return this->lastWma.size();
+    }
+
+    WeightedMovingAverageState WeightedMovingAverageBank::getState(size_t instrument) {
+        if (instrument >= this->lanes.size()) {
+            throw std::out_of_range("instrument out of range");
+        }
+
+        const auto [b, lane] = this->lanes[instrument];
+        const Bucket& bucket = this->buckets[b];
+        const bool initialized = bucket.priceBuf.full();
+
+        return {
+            .period = bucket.period,
+            .denominator = bucket.denominator,
+            .rollingSum = initialized ? bucket.rollingSum[lane] : 0.0,
+            .rollingWeightedSum = initialized ? bucket.rollingWeightedSum[lane] : 0.0,
+            .initialized = initialized,
+            .lastWma = bucket.lastWma[lane],
+            .priceBuf = slab_to_vector(bucket.priceBuf, lane)
+        };
+    }
+
+
+    VolumeWeightedMovingAverageBank::VolumeWeightedMovingAverageBank(std::span<const uint16_t> periods)
+        : VolumeWeightedMovingAverageBank(fresh_states<VolumeWeightedMovingAverageState>(periods)) {}
+
+    VolumeWeightedMovingAverageBank::VolumeWeightedMovingAverageBank(std::span<const VolumeWeightedMovingAverageState> prevCalculations)
+        : lanes(prevCalculations.size()),
+          lastCalculation(prevCalculations.size(), 0.0) {
+        for (const VolumeWeightedMovingAverageState& state : prevCalculations) {
+            if (state.priceBuf.size() != state.volumeBuf.size()) {
+                throw std::invalid_argument("priceBuf and volumeBuf must match in size");
+            }
+        }
+
+        for (auto& [key, instruments] : group_states(prevCalculations)) {
+            const auto [period, initialized] = key;
+            const size_t width = instruments.size();
+
+            Bucket bucket{
+                .period = period,
+                .instruments = instruments,
+                .priceBuf = helpers::WindowSlab<double>(period, width),
+                .volumeBuf = helpers::WindowSlab<double>(period, width),
+                .rollingNumerator = helpers::AlignedVector<double>(width, 0.0),
+                .rollingDenominator = helpers::AlignedVector<double>(width, 0.0),
+                .prices = helpers::AlignedVector<double>(width, 0.0),
+                .volume = helpers::AlignedVector<double>(width, 0.0),
+                .lastCalculation = helpers::AlignedVector<double>(width, 0.0)
+            };
+
+            for (size_t l = 0; l < width; l++) {
+                const VolumeWeightedMovingAverageState& state = prevCalculations[instruments[l]];
+                if (initialized) {
+                    bucket.rollingNumerator[l] = state.rollingNumerator;
+                    bucket.rollingDenominator[l] = state.rollingDenominator;
+                    bucket.lastCalculation[l] = state.lastCalculation;
+                    this->lastCalculation[instruments[l]] = state.lastCalculation;
+                }
+                this->lanes[instruments[l]] = {this->buckets.size(), l};
+            }
+
+            for (size_t k = 0; initialized && k < period; k++) {
+                double* priceSlot = bucket.priceBuf.next();
+                double* volumeSlot = bucket.volumeBuf.next();
+                for (size_t l = 0; l < width; l++) {
+                    priceSlot[l] = prevCalculations[instruments[l]].priceBuf[k];
+                    volumeSlot[l] = prevCalculations[instruments[l]].volumeBuf[k];
+                }
+                bucket.priceBuf.advance();
+                bucket.volumeBuf.advance();
+            }
+
+            this->buckets.push_back(std::move(bucket));
+        }
+    }
+
+    status VolumeWeightedMovingAverageBank::update(std::span<const double> prices, std::span<const double> volume) {
+        if (prices.empty() || volume.empty()) {
+            return status::emptyParams;
+        }
+
+        if (prices.size() != this->lastCalculation.size() || volume.size() != this->lastCalculation.size()) {
+            return status::invalidParam;
+        }
+
+        for (Bucket& bucket : this->buckets) {
+            const size_t width = bucket.instruments.size();
+            double* x = bucket.prices.data();
+            double* v = bucket.volume.data();
+            double* numerator = bucket.rollingNumerator.data();
+            double* denominator = bucket.rollingDenominator.data();
+            double* out = bucket.lastCalculation.data();
+            double* priceSlot = bucket.priceBuf.next();
+            double* volumeSlot = bucket.volumeBuf.next();
+
+            for (size_t l = 0; l < width; l++) {
+                x[l] = prices[bucket.instruments[l]];
+                v[l] = volume[bucket.instruments[l]];
+            }
+
+            if (bucket.priceBuf.full()) {
+                for (size_t l = 0; l < width; l++) {
+                    numerator[l] -= priceSlot[l] * volumeSlot[l];
+                    numerator[l] += x[l] * v[l];
+                    denominator[l] -= volumeSlot[l];
+                    denominator[l] += v[l];
+                    priceSlot[l] = x[l];
+                    volumeSlot[l] = v[l];
+                    out[l] = numerator[l] / denominator[l];
+                }
+            } else {
+                for (size_t l = 0; l < width; l++) {
+                    numerator[l] += x[l] * v[l];
+                    denominator[l] += v[l];
+                    priceSlot[l] = x[l];
+                    volumeSlot[l] = v[l];
+                }
+
+                if (bucket.priceBuf.len() + 1 == bucket.period) {
+                    for (size_t l = 0; l < width; l++) {
+                        out[l] = numerator[l] / denominator[l];
+                    }
+                }
+            }
+            bucket.priceBuf.advance();
+            bucket.volumeBuf.advance();
+
+            for (size_t l = 0; l < width; l++) {
+                this->lastCalculation[bucket.instruments[l]] = out[l];
+            }
+        }
+
+        return status::ok;
+    }
+
+    std::span<const double> VolumeWeightedMovingAverageBank::latest() {
+        return this->lastCalculation;
+    }
+
+    size_t VolumeWeightedMovingAverageBank::size() {
+        return this->lastCalculation.size();
+    }
+
+    VolumeWeightedMovingAverageState VolumeWeightedMovingAverageBank::getState(size_t instrument) {
+        if (instrument >= this->lanes.size()) {
+            throw std::out_of_range("instrument out of range");
+        }
+
+        const auto [b, lane] = this->lanes[instrument];
+        const Bucket& bucket = this->buckets[b];
+        const bool initialized = bucket.priceBuf.full();
+
+        return {
+            .period = bucket.period,
+            .initialized = initialized,
+            .rollingNumerator = initialized ? bucket.rollingNumerator[lane] : 0.0,
+            .rollingDenominator = initialized ? bucket.rollingDenominator[lane] : 0.0,
+            .lastCalculation = bucket.lastCalculation[lane],
+            .priceBuf = slab_to_vector(bucket.priceBuf, lane),
+            .volumeBuf = slab_to_vector(bucket.volumeBuf, lane)
+        };
+    }
+}
@@ -1,19 +1,9 @@
+#include <algorithm>
 #include <vector>
 #include <cmath>
 #include <stdexcept>
 #include <tama/tama.hpp>
 
-namespace {
-std::vector<double> ring_to_vector(const helpers::RingBuffer<double>& buffer) {
-    std::vector<double> values;
-    values.reserve(buffer.len());
-    for (size_t i = 0; i < buffer.len(); ++i) {
-        values.push_back(buffer[i]);
-    }
-    return values;
-}
-}
-
 tama::WeightedMovingAverage::WeightedMovingAverage(uint16_t period, std::vector<double> prevCalc)
     : period(static_cast<size_t>(period)),
       denominator(static_cast<double>(period) * static_cast<double>(period + 1) / 2.0),
@@ -75,11 +65,30 @@ tama::WeightedMovingAverage::WeightedMovingAverage(WeightedMovingAverageState pr
     }
 }
 
-double tama::WeightedMovingAverage::latest() {
-    return this->lastWma;
-}
+tama::WeightedMovingAverage::WeightedMovingAverage(std::span<const std::byte> packed)
+    : WeightedMovingAverage([&] {
+          const auto header = helpers::unpackHeader<WeightedMovingAverageSnapshot>(packed);
+          size_t offset = sizeof(header);
+          return unpackState(header, packed, offset);
+      }()) {}
 
 WeightedMovingAverageState tama::WeightedMovingAverage::getState() {
+    WeightedMovingAverageState state;
+    this->getState(state);
+    return state;
+}
+
+void tama::WeightedMovingAverage::getState(WeightedMovingAverageState& out) const {
+    out.period = this->period;
+    out.denominator = this->denominator;
+    out.rollingSum = this->rollingSum;
+    out.rollingWeightedSum = this->rollingWeightedSum;
+    out.initialized = this->initialized;
+    out.lastWma = this->lastWma;
+    this->priceBuf.view().assignTo(out.priceBuf);
+}
+
+WeightedMovingAverageStateView tama::WeightedMovingAverage::view() const noexcept {
     return {
         .period = this->period,
         .denominator = this->denominator,
@@ -87,52 +96,351 @@ WeightedMovingAverageState tama::WeightedMovingAverage::getState() {
         .rollingWeightedSum = this->rollingWeightedSum,
         .initialized = this->initialized,
         .lastWma = this->lastWma,
-        .priceBuf = ring_to_vector(this->priceBuf)
+        .priceBuf = this->priceBuf.view()
+    };
+}
+
+size_t tama::WeightedMovingAverage::packedSize() const noexcept {
+    return helpers::packedSize<WeightedMovingAverageSnapshot>(this->priceBuf.len());
+}
+
+WeightedMovingAverageSnapshot tama::WeightedMovingAverage::snapshotHeader() const noexcept {
+    return {
+        .period = this->period,
+        .initialized = this->initialized,
+        .priceCount = this->priceBuf.len(),
+        .denominator = this->denominator,
+        .rollingSum = this->rollingSum,
+        .rollingWeightedSum = this->rollingWeightedSum,
+        .lastWma = this->lastWma
     };
 }
 
+status tama::WeightedMovingAverage::pack(std::span<std::byte> out) const noexcept {
+    if (out.size() < this->packedSize()) {
+        return status::invalidParam;
+    }
+
+    helpers::packSnapshot(out.data(), this->snapshotHeader(), {this->priceBuf.view()});
+    return status::ok;
+}
+
+WeightedMovingAverageState tama::WeightedMovingAverage::unpackState(const WeightedMovingAverageSnapshot& header, std::span<const std::byte> packed, size_t& offset) {
+    return {
+        .period = header.period,
+        .denominator = header.denominator,
+        .rollingSum = header.rollingSum,
+        .rollingWeightedSum = header.rollingWeightedSum,
+        .initialized = header.initialized != 0,
+        .lastWma = header.lastWma,
+        .priceBuf = helpers::unpackValues(packed, offset, header.priceCount)
+    };
+}
+
+status tama::WeightedMovingAverage::compute(std::span<const double> prices, std::vector<double>& output, computeMode mode) {
+    if (!prices.empty()) {
+        output.resize(prices.size());
+    }
+    return this->compute(prices, std::span<double>(output), mode);
+}
+
 status tama::WeightedMovingAverage::compute(
     std::span<const double> prices,
-    std::vector<double>& output) {
+    std::span<double> output, computeMode mode) {
     const size_t n = prices.size();
 
     if (n == 0) {
         return status::emptyParams;
     }
-    if (this->period > n) {
+    if (output.size() < n) {
         return status::invalidParam;
     }
 
-    output.resize(n);
+    const bool resumed = mode == computeMode::resume && this->initialized;
+    if (!resumed && this->period > n) {
+        return status::invalidParam;
+    }
+
+    // Samples leaving the window come from the ring until this call has supplied
+    // `period` of its own. A restart fills its window first and never reads it.
+    const helpers::RingView<double> window = this->priceBuf.view();
+    double sSum = resumed ? this->rollingSum : 0.0;
+    double weightedSum = resumed ? this->rollingWeightedSum : 0.0;
+    size_t first = 0;
+
+    if (!resumed) {
+        std::fill(output.begin(), output.begin() + this->period - 1, 0.0);
+
+        for (size_t i = 0; i < this->period; ++i) {
+            const double value = prices[i];
+            sSum += value;
+            weightedSum += value * static_cast<double>(i + 1);
+        }
+
+        output[this->period - 1] = weightedSum / this->denominator;
+        first = this->period;
+    }
+
+    for (size_t t = first; t < n; ++t) {
+        weightedSum -= sSum;
+        sSum -= t < this->period ? window[t] : prices[t - this->period];
+
+        const double value = prices[t];
+        sSum += value;
+        weightedSum += value * static_cast<double>(this->period);
+
+        output[t] = weightedSum / this->denominator;
+    }
+
+    this->priceBuf.insert(prices);
 
+    this->rollingSum = sSum;
+    this->rollingWeightedSum = weightedSum;
+    this->lastWma = output[n - 1];
+    this->initialized = true;
+
+    return status::ok;
+}
+
+status tama::WeightedMovingAverage::computeBlocked(std::span<const double> prices, std::vector<double>& output) {
+    if (!prices.empty()) {
+        output.resize(prices.size());
+    }
+    return this->computeBlocked(prices, std::span<double>(output));
+}
+
+status tama::WeightedMovingAverage::computeBlocked(std::span<const double> prices, std::span<double> output) {
+    const size_t n = prices.size();
+    const size_t period = this->period;
+
+    if (n == 0) {
+        return status::emptyParams;
+    }
+    if (output.size() < n || period > n) {
+        return status::invalidParam;
+    }
+
+    std::fill(output.begin(), output.begin() + period - 1, 0.0);
+
+    // Each block starts from the exact sums of its first window, as compute()
+    // seeds its first one; the scan then carries both across the rest of the block.
+    const size_t interval = detail::rebaseInterval(period);
     double sSum = 0.0;
     double weightedSum = 0.0;
+    for (size_t base = period - 1; base < n; base += interval) {
+        const size_t count = std::min(n, base + interval) - base - 1;
+        const double* window = prices.data() + base + 1 - period;
+        sSum = 0.0;
+        weightedSum = 0.0;
+        for (size_t i = 0; i < period; ++i) {
+            sSum += window[i];
+            weightedSum += window[i] * static_cast<double>(i + 1);
+        }
+        output[base] = weightedSum / this->denominator;
+        helpers::simdWeightedWindowScan(prices.subspan(base + 1, count), prices.subspan(base + 1 - period, count), static_cast<double>(period), this->denominator,
+            sSum, weightedSum, output.subspan(base + 1, count));
+    }
 
+    this->priceBuf.insert(prices);
+
+    this->rollingSum = sSum;
+    this->rollingWeightedSum = weightedSum;
+    this->lastWma = output[n - 1];
+    this->initialized = true;
+
+    return status::ok;
+}
+
+status tama::WeightedMovingAverage::update(std::span<const double> prices, std::span<double> output) {
+    if (prices.empty()) {
+        return status::emptyParams;
+    }
+    const size_t n = prices.size();
+    if (output.size() < n) {
+        return status::invalidParam;
+    }
+    if (!this->initialized) {
+        detail::throwNotInitialized("wma");
+    }
+
+    // step() over the batch; as in SimpleMovingAverage::update(span), the evicted
+    // sample is read from `prices` once the ring's contents have left the window.
+    const helpers::RingView<double> window = this->priceBuf.view();
+    const size_t period = this->period;
+    const size_t warm = std::min(n, period);
+    const double weight = static_cast<double>(period);
+    const double denominator = this->denominator;
+    double sSum = this->rollingSum;
+    double weightedSum = this->rollingWeightedSum;
+
+    for (size_t t = 0; t < warm; t++) {
+        weightedSum = weightedSum - sSum + (prices[t] * weight);
+        sSum = sSum - window[t] + prices[t];
+        output[t] = weightedSum / denominator;
+    }
+    for (size_t t = warm; t < n; t++) {
+        weightedSum = weightedSum - sSum + (prices[t] * weight);
+        sSum = sSum - prices[t - period] + prices[t];
+        output[t] = weightedSum / denominator;
+    }
+
+    this->priceBuf.insert(prices);
+    this->rollingSum = sSum;
+    this->rollingWeightedSum = weightedSum;
+    this->lastWma = output[n - 1];
+    return status::ok;
+}
+
+status tama::WeightedMovingAverage::peek(std::span<const double> candidates, std::span<double> output) const {
+    if (candidates.empty()) {
+        return status::emptyParams;
+    }
+    if (output.size() < candidates.size()) {
+        return status::invalidParam;
+    }
+    if (!this->initialized) {
+        detail::throwNotInitialized("wma");
+    }
+
+    // Every held sample loses one unit of weight; the candidate enters with `period`.
+    const double kept = this->rollingWeightedSum - this->rollingSum;
+    const double weight = static_cast<double>(this->period);
+    const double denominator = this->denominator;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        output[i] = (kept + candidates[i] * weight) / denominator;
+    }
+    return status::ok;
+}
+
+tama::WeightedMovingAverage tama::WeightedMovingAverage::fork() {
+    this->priceBuf.share();
+    return *this;
+}
+
+
+status tama::WeightedMovingAverage::sweep(
+    std::span<const double> prices,
+    std::span<const uint16_t> periods,
+    std::vector<double>& output,
+    sweepLayout layout) {
+    output.resize(periods.size() * prices.size());
+    return WeightedMovingAverage::sweep(prices, periods, std::span<double>(output), layout);
+}
+
+status tama::WeightedMovingAverage::sweep(
+    std::span<const double> prices,
+    std::span<const uint16_t> periods,
+    std::span<double> output,
+    sweepLayout layout,
+    std::pmr::memory_resource* scratch) {
+    const size_t n = prices.size();
+    const size_t periodsLen = periods.size();
+
+    if (n == 0 || periodsLen == 0) {
+        return status::emptyParams;
+    }
+
+    const auto [minPeriod, maxPeriod] = std::minmax_element(periods.begin(), periods.end());
+    if (*minPeriod == 0 || *maxPeriod > n || output.size() < periodsLen * n) {
+        return status::invalidParam;
+    }
+
+    std::fill_n(output.begin(), periodsLen * n, 0.0);
+    const size_t rowStride = layout == sweepLayout::periodMajor ? n : 1;
+    const size_t colStride = layout == sweepLayout::periodMajor ? 1 : periodsLen;
+
+    // Window [a, b) in block-relative indices has weights k - a + 1, so
+    // sum (k - a + 1) * x = (Q[b] - Q[a]) - (a - 1) * (S[b] - S[a]).
+    helpers::blockedPrefixSums(n, *maxPeriod, scratch,
+        [&](size_t j, size_t k) {
+            return std::pair{prices[j], static_cast<double>(k) * prices[j]};
+        },
+        [&](size_t start, size_t end, size_t base, std::span<const double> sums, std::span<const double> indexedSums) {
+            for (size_t p = 0; p < periodsLen; p++) {
+                const size_t period = periods[p];
+                const double denominator = static_cast<double>(period) * static_cast<double>(period + 1) / 2.0;
+                double* row = output.data() + p * rowStride;
+
+                for (size_t t = std::max(start, period - 1); t < end; t++) {
+                    const size_t b = t + 1 - base;
+                    const size_t a = b - period;
+                    const double sSum = sums[b] - sums[a];
+                    const double weightedSum = indexedSums[b] - indexedSums[a] - (static_cast<double>(a) - 1.0) * sSum;
+                    row[t * colStride] = weightedSum / denominator;
+                }
+            }
+        });
+
+    return status::ok;
+}
+
+template <typename Sample, typename Accum>
+tama::BasicWeightedMovingAverage<Sample, Accum>::BasicWeightedMovingAverage(uint16_t period, std::vector<Sample> prevCalc)
+    : period(static_cast<size_t>(period)),
+      denominator(static_cast<Accum>(period) * static_cast<Accum>(period + 1) / Accum(2)),
+      priceBuf(period > 0 ? period : 1) {
+    if (period == 0) {
+        throw std::invalid_argument("invalid period");
+    }
+
+    if (!prevCalc.empty()) {
+        if (prevCalc.size() != this->period) {
+            throw std::invalid_argument("prevCalc buffer doesn't match period");
+        }
+        this->priceBuf.insert(prevCalc);
+
+        for (size_t i = 0; i < this->period; i++) {
+            this->rollingSum += prevCalc[i];
+            this->rollingWeightedSum += static_cast<Accum>(prevCalc[i]) * static_cast<Accum>(i + 1);
+        }
+
+        this->lastWma = static_cast<Sample>(this->rollingWeightedSum / this->denominator);
+        this->initialized = true;
+    }
+}
+
+template <typename Sample, typename Accum>
+Sample tama::BasicWeightedMovingAverage<Sample, Accum>::latest() {
+    return this->lastWma;
+}
+
+template <typename Sample, typename Accum>
+status tama::BasicWeightedMovingAverage<Sample, Accum>::compute(std::span<const Sample> prices, std::vector<Sample>& output) {
+    const size_t n = prices.size();
+
+    if (n == 0) {
+        return status::emptyParams;
+    }
+    if (this->period > n) {
+        return status::invalidParam;
+    }
+
+    output.resize(n);
+
+    Accum sSum = 0;
+    Accum weightedSum = 0;
 
     for (size_t i = 0; i < this->period; ++i) {
-        const double value = prices[i];
+        const Accum value = prices[i];
         sSum += value;
-        weightedSum += value * static_cast<double>(i + 1);
+        weightedSum += value * static_cast<Accum>(i + 1);
     }
 
-    output[this->period - 1] = weightedSum / this->denominator;
-
+    output[this->period - 1] = static_cast<Sample>(weightedSum / this->denominator);
 
     for (size_t t = this->period; t < n; ++t) {
         weightedSum -= sSum;
         sSum -= prices[t - this->period];
 
-        const double value = prices[t];
+        const Accum value = prices[t];
         sSum += value;
-        weightedSum += value * static_cast<double>(this->period);
+        weightedSum += value * static_cast<Accum>(this->period);
 
-        output[t] = weightedSum / this->denominator;
+        output[t] = static_cast<Sample>(weightedSum / this->denominator);
     }
 
-    const size_t offset = n - this->period;
-
-    this->priceBuf = helpers::RingBuffer<double>(this->period);
-    this->priceBuf.insert(std::vector<double>(prices.begin() + offset, prices.end()));
+    this->priceBuf.clear();
+    this->priceBuf.insert(prices.subspan(n - this->period));
 
     this->rollingSum = sSum;
     this->rollingWeightedSum = weightedSum;
@@ -142,21 +450,22 @@ status tama::WeightedMovingAverage::compute(
     return status::ok;
 }
 
-
-double tama::WeightedMovingAverage::update(double price) {
+template <typename Sample, typename Accum>
+Sample tama::BasicWeightedMovingAverage<Sample, Accum>::update(Sample price) {
     if (!this->initialized) {
         throw std::runtime_error("wma not initialized");
     }
 
-    const double oldSum = this->rollingSum;
+    const Accum oldSum = this->rollingSum;
 
-    this->rollingWeightedSum = this->rollingWeightedSum - oldSum + (price * this->period);
+    this->rollingWeightedSum = this->rollingWeightedSum - oldSum + (static_cast<Accum>(price) * static_cast<Accum>(this->period));
     this->rollingSum = oldSum - this->priceBuf.head() + price;
 
     this->priceBuf.insert(price);
 
-    this->lastWma = this->rollingWeightedSum / this->denominator;
-
-
+    this->lastWma = static_cast<Sample>(this->rollingWeightedSum / this->denominator);
     return this->lastWma;
-}
\ No newline at end of file
+}
+
+template class tama::BasicWeightedMovingAverage<float, float>;
+template class tama::BasicWeightedMovingAverage<float, double>;
@@ -1,4 +1,7 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <span>
 #include <vector>
 
 #include <helpers/helpers.hpp>
@@ -58,4 +61,217 @@ TEST(RingBufferTest, RingBufferMin) {
 
     buffer.insert({4, 3, 2});
     EXPECT_EQ(buffer.min(), 2);
-}
\ No newline at end of file
+}
+TEST(MonotonicDequeTest, TracksWindowExtremaAgainstScan_test) {
+    const std::vector<int> values{5, 3, 8, 8, 1, 2, 9, 4, 4, 7, 0, 6, 6, 3};
+    const size_t window = 4;
+    helpers::MonotonicDeque<int, std::greater<int>> maxes(window);
+    helpers::MonotonicDeque<int, std::less<int>> mins(window);
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        maxes.push(values[i]);
+        mins.push(values[i]);
+
+        const size_t start = i + 1 >= window ? i + 1 - window : 0;
+        const auto first = values.begin() + static_cast<std::ptrdiff_t>(start);
+        const auto last = values.begin() + static_cast<std::ptrdiff_t>(i + 1);
+        EXPECT_EQ(maxes.front(), *std::max_element(first, last)) << "max differs at index " << i;
+        EXPECT_EQ(mins.front(), *std::min_element(first, last)) << "min differs at index " << i;
+        EXPECT_LE(maxes.len(), window);
+    }
+}
+
+TEST(MonotonicDequeTest, ClearResetsWindow_test) {
+    helpers::MonotonicDeque<int, std::greater<int>> maxes(2);
+    maxes.push(9);
+    maxes.clear();
+
+    EXPECT_TRUE(maxes.empty());
+    EXPECT_THROW(maxes.front(), std::runtime_error);
+    maxes.push(1);
+    EXPECT_EQ(maxes.front(), 1);
+    using MinDeque = helpers::MonotonicDeque<int, std::less<int>>;
+    EXPECT_THROW(MinDeque(0), std::invalid_argument);
+}
+
+TEST(MonotonicDequeTest, ReplaceBackWithBetterValue_test) {
+    // Each newest value is amended upwards once; the front must match a window scan.
+    std::vector<int> values{5, 3, 8, 8, 1, 2, 9, 4, 4, 7, 0, 6, 6, 3};
+    const size_t window = 4;
+    helpers::MonotonicDeque<int, std::greater<int>> maxes(window);
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        maxes.push(values[i]);
+        values[i] += static_cast<int>(i % 4);
+        maxes.replaceBack(values[i]);
+
+        const size_t start = i + 1 >= window ? i + 1 - window : 0;
+        const auto first = values.begin() + static_cast<std::ptrdiff_t>(start);
+        const auto last = values.begin() + static_cast<std::ptrdiff_t>(i + 1);
+        EXPECT_EQ(maxes.front(), *std::max_element(first, last)) << "max differs at index " << i;
+    }
+}
+
+TEST(FixedRingBufferTest, KeepsLastPeriodValuesAcrossWrap_test) {
+    // Period 5 rounds storage up to 8, so the window wraps at a different point than it fills.
+    helpers::FixedRingBuffer<int> buffer(5);
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(buffer.cap(), 5u);
+
+    for (int v = 1; v <= 12; v++) {
+        buffer.insert(v);
+        const int expectedLen = std::min(v, 5);
+        ASSERT_EQ(buffer.len(), static_cast<size_t>(expectedLen));
+        EXPECT_EQ(buffer.head(), v - expectedLen + 1);
+        EXPECT_EQ(buffer.back(), v);
+        for (int i = 0; i < expectedLen; i++) {
+            EXPECT_EQ(buffer[static_cast<size_t>(i)], v - expectedLen + 1 + i);
+        }
+    }
+}
+
+TEST(FixedRingBufferTest, ReplaceBackOverwritesNewest_test) {
+    helpers::FixedRingBuffer<int> buffer(3);
+    for (int v = 1; v <= 4; v++) {
+        buffer.insert(v);
+    }
+
+    buffer.replaceBack(40);
+    EXPECT_EQ(buffer.len(), 3u);
+    EXPECT_EQ(buffer.head(), 2);
+    EXPECT_EQ(buffer[2], 40);
+    buffer.insert(5);
+    EXPECT_EQ(buffer.head(), 3);
+    EXPECT_EQ(buffer[1], 40);
+}
+
+TEST(FixedRingBufferTest, SpanInsertMatchesElementwiseInsert_test) {
+    const std::vector<int> values{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13};
+
+    for (size_t chunk = 1; chunk <= values.size(); chunk++) {
+        helpers::FixedRingBuffer<int> bulk(6);
+        helpers::FixedRingBuffer<int> single(6);
+        bulk.insert(7);
+        single.insert(7);
+
+        for (size_t i = 0; i < values.size(); i += chunk) {
+            const size_t n = std::min(chunk, values.size() - i);
+            bulk.insert(std::span<const int>(values.data() + i, n));
+            for (size_t k = 0; k < n; k++) {
+                single.insert(values[i + k]);
+            }
+
+            ASSERT_EQ(bulk.len(), single.len()) << "chunk " << chunk;
+            for (size_t k = 0; k < single.len(); k++) {
+                EXPECT_EQ(bulk[k], single[k]) << "chunk " << chunk << ", index " << k;
+            }
+        }
+    }
+}
+
+TEST(FixedRingBufferTest, SpansCoverWindowOldestFirst_test) {
+    helpers::FixedRingBuffer<int> buffer(4);
+    for (int v = 1; v <= 6; v++) {
+        buffer.insert(v);
+    }
+
+    const auto [older, newer] = buffer.spans();
+    std::vector<int> window(older.begin(), older.end());
+    window.insert(window.end(), newer.begin(), newer.end());
+    EXPECT_EQ(window, (std::vector<int>{3, 4, 5, 6}));
+    EXPECT_FALSE(newer.empty());
+
+    buffer.clear();
+    EXPECT_TRUE(buffer.empty());
+    const auto [first, second] = buffer.spans();
+    EXPECT_TRUE(first.empty());
+    EXPECT_TRUE(second.empty());
+}
+
+TEST(FixedRingBufferTest, SharedCopiesDivergeIndependently_test) {
+    // Period 5 in storage of 8; the shared window wraps around the end of it.
+    helpers::FixedRingBuffer<int> parent(5);
+    for (int v = 1; v <= 7; v++) {
+        parent.insert(v);
+    }
+    parent.share();
+    helpers::FixedRingBuffer<int> branch(parent);
+    EXPECT_TRUE(branch.sharing());
+
+    auto window = [](const helpers::FixedRingBuffer<int>& buffer) {
+        std::vector<int> values;
+        buffer.view().assignTo(values);
+        return values;
+    };
+
+    parent.insert(8);
+    branch.insert(80);
+    branch.insert(90);
+    EXPECT_EQ(window(parent), (std::vector<int>{4, 5, 6, 7, 8}));
+    EXPECT_EQ(window(branch), (std::vector<int>{5, 6, 7, 80, 90}));
+    EXPECT_EQ(branch.head(), 5);
+    EXPECT_EQ(branch.back(), 90);
+    EXPECT_EQ(branch[2], 7);
+    EXPECT_EQ(branch[3], 80);
+
+    // The shared samples age out after a full window of own inserts.
+    for (int v = 100; v < 103; v++) {
+        EXPECT_TRUE(branch.sharing());
+        branch.insert(v);
+    }
+    EXPECT_FALSE(branch.sharing());
+    EXPECT_EQ(window(branch), (std::vector<int>{80, 90, 100, 101, 102}));
+    branch.insert(103);
+    EXPECT_EQ(window(branch), (std::vector<int>{90, 100, 101, 102, 103}));
+    EXPECT_EQ(window(parent), (std::vector<int>{4, 5, 6, 7, 8}));
+}
+
+TEST(FixedRingBufferTest, SharedRingMutatorsMatchPlainRing_test) {
+    helpers::FixedRingBuffer<int> plain(6);
+    helpers::FixedRingBuffer<int> source(6);
+    for (int v = 1; v <= 9; v++) {
+        plain.insert(v);
+        source.insert(v);
+    }
+    source.share();
+
+    auto expectSame = [&](const helpers::FixedRingBuffer<int>& shared) {
+        ASSERT_EQ(shared.len(), plain.len());
+        for (size_t i = 0; i < plain.len(); i++) {
+            EXPECT_EQ(shared[i], plain[i]) << "index " << i;
+        }
+    };
+
+    // An inherited newest sample is replaced, then forked again with own samples.
+    helpers::FixedRingBuffer<int> branch(source);
+    branch.replaceBack(90);
+    plain.replaceBack(90);
+    expectSame(branch);
+    branch.insert(10);
+    plain.insert(10);
+    branch.share();
+    helpers::FixedRingBuffer<int> nested(branch);
+    expectSame(nested);
+    nested.insert(11);
+    plain.insert(11);
+    expectSame(nested);
+
+    // Span inserts and clear() leave shared storage behind.
+    helpers::FixedRingBuffer<int> bulk(source);
+    helpers::FixedRingBuffer<int> reference(6);
+    reference.insert(std::span<const int>(std::vector<int>{4, 5, 6, 7, 8, 9}));
+    const std::vector<int> more{20, 21};
+    bulk.insert(more);
+    reference.insert(more);
+    EXPECT_FALSE(bulk.sharing());
+    for (size_t i = 0; i < reference.len(); i++) {
+        EXPECT_EQ(bulk[i], reference[i]) << "index " << i;
+    }
+    helpers::FixedRingBuffer<int> cleared(source);
+    cleared.clear();
+    EXPECT_TRUE(cleared.empty());
+    cleared.insert(1);
+    EXPECT_EQ(cleared.head(), 1);
+    EXPECT_EQ(source.len(), 6u);
+    EXPECT_EQ(source.back(), 9);
+}
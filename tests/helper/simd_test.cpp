@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 #include <span>
 #include <vector>
+#include <cmath>
 #include <numeric>
+#include <cstdlib>
+#include <stdexcept>
+#include <string_view>
 
 #include <helpers/helpers.hpp>
 
@@ -23,3 +27,151 @@ TEST(SimdHelpersTest, SimdSumHandlesTailElements_test) {
 
     EXPECT_NEAR(result, expected, 1e-12);
 }
+
+TEST(SimdHelpersTest, KernelsMatchScalarAcrossTailLengths_test) {
+    for (size_t n = 0; n < 37; n++) {
+        std::vector<double> x(n);
+        std::vector<double> alpha(n);
+        std::vector<double> oma(n);
+        std::vector<double> state(n);
+        for (size_t i = 0; i < n; i++) {
+            x[i] = 1.0 + 0.37 * static_cast<double>(i % 7);
+            alpha[i] = 0.05 + 0.01 * static_cast<double>(i);
+            oma[i] = 1.0 - alpha[i];
+            state[i] = 10.0 - 0.1 * static_cast<double>(i);
+        }
+
+        EXPECT_NEAR(helpers::simdSum(x), std::accumulate(x.begin(), x.end(), 0.0), 1e-12) << "n = " << n;
+
+        std::vector<double> expected(state);
+        for (size_t i = 0; i < n; i++) {
+            expected[i] = alpha[i] * x[i] + oma[i] * expected[i];
+        }
+        helpers::simdEmaStep(state, alpha, oma, x);
+        for (size_t i = 0; i < n; i++) {
+            EXPECT_NEAR(state[i], expected[i], 1e-12) << "n = " << n << ", index " << i;
+        }
+
+        std::vector<double> scanned(n);
+        double carry = 5.0;
+        const double last = helpers::simdEmaScan(x, 0.2, 0.8, carry, scanned);
+        for (size_t i = 0; i < n; i++) {
+            carry = 0.2 * x[i] + 0.8 * carry;
+            EXPECT_NEAR(scanned[i], carry, 1e-12) << "n = " << n << ", index " << i;
+        }
+        EXPECT_NEAR(last, carry, 1e-12) << "n = " << n;
+
+        // The McGinley step against the std::pow form it replaces.
+        std::vector<double> invPeriod(n);
+        std::vector<double> md(n);
+        for (size_t i = 0; i < n; i++) {
+            invPeriod[i] = 1.0 / static_cast<double>(i + 2);
+            md[i] = x[i] + 0.3 - 0.1 * static_cast<double>(i % 5);
+        }
+        std::vector<double> mdExpected(md);
+        for (size_t i = 0; i < n; i++) {
+            mdExpected[i] += (x[i] - md[i]) / (static_cast<double>(i + 2) * std::pow(x[i] / md[i], 4.0));
+        }
+        helpers::simdMdStep(md, invPeriod, x);
+        for (size_t i = 0; i < n; i++) {
+            EXPECT_NEAR(md[i], mdExpected[i], 1e-12 * std::fabs(mdExpected[i])) << "n = " << n << ", index " << i;
+        }
+
+        // Window scans against the rolling sums they reassociate.
+        std::vector<double> old(n);
+        for (size_t i = 0; i < n; i++) {
+            old[i] = 2.0 - 0.11 * static_cast<double>(i % 5);
+        }
+        std::vector<double> windowed(n);
+        const double windowLast = helpers::simdWindowScan(x, old, 0.25, 40.0, windowed);
+        std::vector<double> weighted(n);
+        double sum = 40.0;
+        double weightedSum = 300.0;
+        helpers::simdWeightedWindowScan(x, old, 12.0, 78.0, sum, weightedSum, weighted);
+        double expectedSum = 40.0;
+        double expectedWeighted = 300.0;
+        for (size_t i = 0; i < n; i++) {
+            expectedWeighted += 12.0 * x[i] - expectedSum;
+            expectedSum += x[i] - old[i];
+            EXPECT_NEAR(windowed[i], 0.25 * expectedSum, 1e-12) << "n = " << n << ", index " << i;
+            EXPECT_NEAR(weighted[i], expectedWeighted / 78.0, 1e-12) << "n = " << n << ", index " << i;
+        }
+        EXPECT_NEAR(windowLast, expectedSum, 1e-12) << "n = " << n;
+        EXPECT_NEAR(sum, expectedSum, 1e-12) << "n = " << n;
+        EXPECT_NEAR(weightedSum, expectedWeighted, 1e-11) << "n = " << n;
+    }
+}
+
+TEST(SimdHelpersTest, EmaCascadeMatchesScalarForEveryLaneCount_test) {
+    const std::vector<double> prices{10, 12, 11, 13, 12, 14, 15, 13, 14, 16, 15, 17};
+    const size_t n = prices.size();
+
+    for (size_t lanes = 1; lanes <= 11; lanes++) {
+        std::vector<double> alpha(lanes);
+        std::vector<double> oma(lanes);
+        std::vector<double> coefficients(3 * lanes);
+        for (size_t l = 0; l < lanes; l++) {
+            alpha[l] = 2.0 / static_cast<double>(l + 3);
+            oma[l] = 1.0 - alpha[l];
+            coefficients[l] = 3.0;
+            coefficients[lanes + l] = -3.0;
+            coefficients[2 * lanes + l] = 1.0;
+        }
+
+        // Time-major output with a lane stride of 1, plus the final stage states.
+        std::vector<double> output(n * lanes);
+        std::vector<double> lastStates(3 * lanes);
+        helpers::simdEmaCascade(prices, alpha, oma, coefficients, 3, output, lanes, 1, lastStates);
+
+        for (size_t l = 0; l < lanes; l++) {
+            double e1 = prices[0];
+            double e2 = prices[0];
+            double e3 = prices[0];
+            for (size_t t = 0; t < n; t++) {
+                if (t > 0) {
+                    e1 = alpha[l] * prices[t] + oma[l] * e1;
+                    e2 = alpha[l] * e1 + oma[l] * e2;
+                    e3 = alpha[l] * e2 + oma[l] * e3;
+                }
+                EXPECT_NEAR(output[t * lanes + l], 3.0 * e1 - 3.0 * e2 + e3, 1e-12) << "lanes " << lanes << ", lane " << l << ", t " << t;
+            }
+            EXPECT_NEAR(lastStates[l], e1, 1e-12);
+            EXPECT_NEAR(lastStates[lanes + l], e2, 1e-12);
+            EXPECT_NEAR(lastStates[2 * lanes + l], e3, 1e-12);
+        }
+    }
+
+    std::vector<double> output(n);
+    const double one = 1.0;
+    EXPECT_THROW(helpers::simdEmaCascade(prices, std::span<const double>(&one, 1), std::span<const double>(&one, 1), std::span<const double>(&one, 1), 4, output, 1, 1), std::invalid_argument);
+}
+
+TEST(SimdHelpersTest, ActiveIsaHonoursCap_test) {
+    const helpers::simdIsa isa = helpers::activeSimdIsa();
+    const char* cap = std::getenv("TAMA_SIMD_ISA");
+
+    if (cap != nullptr && std::string_view(cap) == "sse2") {
+        EXPECT_EQ(isa, helpers::simdIsa::sse2);
+    } else if (cap != nullptr && std::string_view(cap) == "avx2") {
+        EXPECT_TRUE(isa == helpers::simdIsa::sse2 || isa == helpers::simdIsa::avx2);
+    }
+#if defined(__aarch64__) || defined(_M_ARM64)
+    EXPECT_EQ(isa, helpers::simdIsa::neon);
+#endif
+}
+
+TEST(SimdHelpersTest, ApproxLog2Exp2StayWithinDocumentedError_test) {
+    // From FRAMA's window ratios in (1, 4] out to the whole normal range.
+    for (double x = 1e-300; x < 1e300; x *= 1.37) {
+        EXPECT_NEAR(helpers::approxLog2(x), std::log2(x), 2e-15 + 2.3e-16 * std::fabs(std::log2(x))) << "x = " << x;
+    }
+    for (double x = 1.0; x <= 4.0; x += 0.0009765625 * 0.37) {
+        EXPECT_NEAR(helpers::approxLog2(x), std::log2(x), 1e-15) << "x = " << x;
+    }
+
+    for (double y = -1022.0; y <= 1023.0; y += 0.731) {
+        EXPECT_NEAR(helpers::approxExp2(y) / std::exp2(y), 1.0, 5e-16) << "y = " << y;
+    }
+    EXPECT_EQ(helpers::approxExp2(0.0), 1.0);
+    EXPECT_TRUE(std::isnan(helpers::approxExp2(std::nan(""))));
+}
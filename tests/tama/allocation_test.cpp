@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include <tama/tama.hpp>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+using std::vector;
+
+using namespace tama;
+
+namespace {
+    // Counts every global allocation made by this test binary.
+    size_t allocations = 0;
+
+    void* countedAlloc(size_t size, size_t alignment) {
+        allocations++;
+        const size_t rounded = (size + alignment - 1) / alignment * alignment;
+        void* p = alignment <= alignof(std::max_align_t) ? std::malloc(size ? size : 1) : std::aligned_alloc(alignment, rounded ? rounded : alignment);
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+
+    vector<double> series(size_t n, double base) {
+        vector<double> values(n);
+        for (size_t i = 0; i < n; i++) {
+            values[i] = base + static_cast<double>((i * 7919) % 23) - 11.0 * static_cast<double>(i % 2);
+        }
+        return values;
+    }
+}
+
+void* operator new(size_t size) { return countedAlloc(size, alignof(std::max_align_t)); }
+void* operator new[](size_t size) { return countedAlloc(size, alignof(std::max_align_t)); }
+void* operator new(size_t size, std::align_val_t al) { return countedAlloc(size, static_cast<size_t>(al)); }
+void* operator new[](size_t size, std::align_val_t al) { return countedAlloc(size, static_cast<size_t>(al)); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+
+TEST(TamaTest, SpanComputeDoesNotAllocate_test) {
+    const size_t n = 5000;
+    const vector<double> prices = series(n, 100.0);
+    const vector<double> volumes = series(n, 1000.0);
+    vector<double> lows(prices);
+    vector<double> highs(prices);
+    for (size_t i = 0; i < n; i++) {
+        lows[i] -= 1.5;
+        highs[i] += 1.5;
+    }
+
+    ExponentialMovingAverage ema(20);
+    SimpleMovingAverage sma(20);
+    WeightedMovingAverage wma(20);
+    VolumeWeightedMovingAverage vwma(20);
+    HullMovingAverage hma(20);
+    DoubleExponentialMovingAverage dema(20);
+    TripleExponentialMovingAverage tema(20);
+    McGinleyDynamicMovingAverage md(20);
+    FractalAdaptiveMovingAverage frama(20);
+    GeneralizedDoubleExponentialMovingAverage gd(0.7, 20);
+
+    vector<vector<double>> outputs(10, vector<double>(n));
+
+    const size_t before = allocations;
+    EXPECT_EQ(ema.compute(prices, std::span<double>(outputs[0])), status::ok);
+    EXPECT_EQ(sma.compute(prices, std::span<double>(outputs[1])), status::ok);
+    EXPECT_EQ(wma.compute(prices, std::span<double>(outputs[2])), status::ok);
+    EXPECT_EQ(vwma.compute(prices, volumes, std::span<double>(outputs[3])), status::ok);
+    EXPECT_EQ(hma.compute(prices, std::span<double>(outputs[4])), status::ok);
+    EXPECT_EQ(dema.compute(prices, std::span<double>(outputs[5])), status::ok);
+    EXPECT_EQ(tema.compute(prices, std::span<double>(outputs[6])), status::ok);
+    EXPECT_EQ(md.compute(prices, std::span<double>(outputs[7])), status::ok);
+    EXPECT_EQ(frama.compute(prices, lows, highs, std::span<double>(outputs[8])), status::ok);
+    EXPECT_EQ(gd.compute(prices, std::span<double>(outputs[9])), status::ok);
+    EXPECT_EQ(sma.computeBlocked(prices, std::span<double>(outputs[1])), status::ok);
+    EXPECT_EQ(wma.computeBlocked(prices, std::span<double>(outputs[2])), status::ok);
+    EXPECT_EQ(allocations, before);
+
+    // The vector overloads write the same values.
+    vector<double> expected;
+    ASSERT_EQ(ExponentialMovingAverage(20).compute(prices, expected), status::ok);
+    EXPECT_EQ(outputs[0], expected);
+    ASSERT_EQ(HullMovingAverage(20).compute(prices, expected), status::ok);
+    EXPECT_EQ(outputs[4], expected);
+    ASSERT_EQ(FractalAdaptiveMovingAverage(20).compute(prices, lows, highs, expected), status::ok);
+    EXPECT_EQ(outputs[8], expected);
+    EXPECT_EQ(frama.latest(), outputs[8].back());
+}
+
+TEST(TamaTest, SpanComputeRejectsShortOutput_test) {
+    const vector<double> prices = series(64, 100.0);
+    vector<double> out(prices.size() - 1, -1.0);
+
+    SimpleMovingAverage sma(5);
+    HullMovingAverage hma(9);
+    EXPECT_EQ(sma.compute(prices, std::span<double>(out)), status::invalidParam);
+    EXPECT_EQ(hma.compute(prices, std::span<double>(out)), status::invalidParam);
+    EXPECT_EQ(out.front(), -1.0);
+    EXPECT_THROW(sma.update(1.0), std::runtime_error);
+
+    // A longer destination is accepted; the tail is left untouched.
+    out.assign(prices.size() + 3, -1.0);
+    EXPECT_EQ(sma.compute(prices, std::span<double>(out)), status::ok);
+    EXPECT_EQ(out.back(), -1.0);
+    EXPECT_EQ(sma.latest(), out[prices.size() - 1]);
+
+    VolumeWeightedMovingAverage vwma(5);
+    EXPECT_EQ(vwma.compute(prices, prices, std::span<double>(out)), status::ok);
+    EXPECT_EQ(vwma.latest(), out[prices.size() - 1]);
+}
+
+TEST(TamaTest, PeekDoesNotAllocate_test) {
+    const vector<double> prices = series(200, 100.0);
+    const vector<double> levels = series(50, 100.0);
+    vector<double> out(prices.size());
+
+    SimpleMovingAverage sma(20);
+    HullMovingAverage hma(20);
+    TripleExponentialMovingAverage tema(20);
+    VolumeWeightedMovingAverage vwma(20);
+    ASSERT_EQ(sma.compute(prices, out), status::ok);
+    ASSERT_EQ(hma.compute(prices, out), status::ok);
+    ASSERT_EQ(tema.compute(prices, out), status::ok);
+    ASSERT_EQ(vwma.compute(prices, prices, out), status::ok);
+
+    const size_t before = allocations;
+    double sum = sma.peek(101.0) + hma.peek(101.0) + tema.peek(101.0) + vwma.peek(101.0, 50.0);
+    EXPECT_EQ(sma.peek(levels, std::span<double>(out)), status::ok);
+    EXPECT_EQ(hma.peek(levels, std::span<double>(out)), status::ok);
+    EXPECT_EQ(tema.peek(levels, std::span<double>(out)), status::ok);
+    EXPECT_EQ(vwma.peek(levels, levels, std::span<double>(out)), status::ok);
+    EXPECT_EQ(allocations, before);
+    EXPECT_TRUE(std::isfinite(sum));
+}
+
+TEST(TamaTest, ForkSharesWindowsInsteadOfCopying_test) {
+    const vector<double> prices = series(600, 100.0);
+    vector<double> out(prices.size());
+    HullMovingAverage hma(200);
+    ASSERT_EQ(hma.compute(prices, out), status::ok);
+
+    // One shared handle per ring for the first fork, then nothing for the rest.
+    size_t before = allocations;
+    HullMovingAverage branch = hma.fork();
+    EXPECT_LE(allocations - before, 3u);
+    vector<HullMovingAverage> siblings;
+    siblings.reserve(16);
+    before = allocations;
+    for (size_t i = 0; i < 16; i++) {
+        siblings.push_back(branch.fork());
+    }
+    EXPECT_EQ(allocations, before);
+
+    // Own storage grows with the ticks a branch takes, not with its period.
+    before = allocations;
+    for (size_t i = 0; i < 8; i++) {
+        siblings[0].update(100.0 + static_cast<double>(i));
+    }
+    EXPECT_LE(allocations - before, 3u);
+}
+
+TEST(TamaTest, SweepWithScratchArenaDoesNotAllocate_test) {
+    const vector<double> prices = series(10000, 50.0);
+    const vector<double> volumes = series(10000, 500.0);
+    const vector<uint16_t> periods{5, 21, 50, 200};
+    vector<double> out(periods.size() * prices.size());
+    vector<double> expected;
+
+    // null_memory_resource() makes any overflow of the arena throw.
+    alignas(64) static std::array<std::byte, 1 << 17> arena;
+
+    auto check = [&](auto&& viaSpan, auto&& viaVector) {
+        std::pmr::monotonic_buffer_resource scratch(arena.data(), arena.size(), std::pmr::null_memory_resource());
+        const size_t before = allocations;
+        EXPECT_EQ(viaSpan(&scratch), status::ok);
+        EXPECT_EQ(allocations, before);
+        ASSERT_EQ(viaVector(), status::ok);
+        EXPECT_EQ(out, expected);
+    };
+
+    check([&](auto* s) { return SimpleMovingAverage::sweep(prices, periods, std::span<double>(out), sweepLayout::timeMajor, s); },
+          [&] { return SimpleMovingAverage::sweep(prices, periods, expected, sweepLayout::timeMajor); });
+    check([&](auto* s) { return WeightedMovingAverage::sweep(prices, periods, std::span<double>(out), sweepLayout::periodMajor, s); },
+          [&] { return WeightedMovingAverage::sweep(prices, periods, expected); });
+    check([&](auto* s) { return VolumeWeightedMovingAverage::sweep(prices, volumes, periods, std::span<double>(out), sweepLayout::periodMajor, s); },
+          [&] { return VolumeWeightedMovingAverage::sweep(prices, volumes, periods, expected); });
+    check([&](auto* s) { return ExponentialMovingAverage::sweep(prices, periods, std::span<double>(out), sweepLayout::periodMajor, s); },
+          [&] { return ExponentialMovingAverage::sweep(prices, periods, expected); });
+    check([&](auto* s) { return DoubleExponentialMovingAverage::sweep(prices, periods, std::span<double>(out), sweepLayout::periodMajor, s); },
+          [&] { return DoubleExponentialMovingAverage::sweep(prices, periods, expected); });
+    check([&](auto* s) { return TripleExponentialMovingAverage::sweep(prices, periods, std::span<double>(out), sweepLayout::periodMajor, s); },
+          [&] { return TripleExponentialMovingAverage::sweep(prices, periods, expected); });
+    check([&](auto* s) { return GeneralizedDoubleExponentialMovingAverage::sweep(prices, 0.7, periods, std::span<double>(out), sweepLayout::periodMajor, s); },
+          [&] { return GeneralizedDoubleExponentialMovingAverage::sweep(prices, 0.7, periods, expected); });
+
+    vector<double> tooShort(out.size() - 1);
+    EXPECT_EQ(SimpleMovingAverage::sweep(prices, periods, std::span<double>(tooShort)), status::invalidParam);
+    EXPECT_EQ(ExponentialMovingAverage::sweep(prices, periods, std::span<double>(tooShort)), status::invalidParam);
+}
@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include <tama/tama.hpp>
+#include <vector>
+#include <stdexcept>
+
+using std::vector;
+
+using namespace tama;
+
+namespace {
+    // The window indicators move their rolling sums by the difference, which rounds
+    // differently from rebuilding the sums; the EMA stages recompute the same step.
+    constexpr double windowTolerance = 1e-9;
+
+    vector<double> series(size_t n, double base) {
+        vector<double> values(n);
+        for (size_t i = 0; i < n; i++) {
+            values[i] = base + static_cast<double>((i * 53) % 19) * 0.5 - static_cast<double>(i % 4);
+        }
+        return values;
+    }
+
+    // `amended` takes a tick and then several intrabar revisions; `reference` only
+    // sees the final revision. Both must agree now and over the following bars.
+    template <typename Indicator>
+    void expectAmendMatchesUpdate(Indicator indicator, double tolerance) {
+        vector<double> out;
+        ASSERT_EQ(indicator.compute(series(60, 100.0), out), status::ok);
+
+        Indicator amended(indicator);
+        Indicator reference(indicator);
+        amended.update(97.0);
+        for (double revision : {104.0, 91.5, 99.25}) {
+            amended.amend(revision);
+        }
+        EXPECT_NEAR(amended.latest(), reference.update(99.25), tolerance);
+
+        for (double next : series(30, 98.0)) {
+            EXPECT_NEAR(amended.update(next), reference.update(next), tolerance);
+        }
+    }
+
+    // Amending the last sample of a compute() matches computing the revised series.
+    template <typename Indicator>
+    void expectAmendMatchesCompute(Indicator indicator, double tolerance) {
+        vector<double> prices = series(60, 100.0);
+        vector<double> out;
+        Indicator reference(indicator);
+        ASSERT_EQ(indicator.compute(prices, out), status::ok);
+
+        prices.back() = 92.0;
+        ASSERT_EQ(reference.compute(prices, out), status::ok);
+        EXPECT_NEAR(indicator.amend(92.0), out.back(), tolerance);
+        EXPECT_NEAR(indicator.update(101.0), reference.update(101.0), tolerance);
+    }
+}
+
+TEST(TamaTest, AmendMatchesUpdateWithFinalTick_test) {
+    expectAmendMatchesUpdate(ExponentialMovingAverage(10), 0.0);
+    expectAmendMatchesUpdate(DoubleExponentialMovingAverage(10), 0.0);
+    expectAmendMatchesUpdate(TripleExponentialMovingAverage(10), 0.0);
+    expectAmendMatchesUpdate(GeneralizedDoubleExponentialMovingAverage(0.7, 10), 0.0);
+    expectAmendMatchesUpdate(McGinleyDynamicMovingAverage(10), 0.0);
+    expectAmendMatchesUpdate(SimpleMovingAverage(10), windowTolerance);
+    expectAmendMatchesUpdate(WeightedMovingAverage(10), windowTolerance);
+    expectAmendMatchesUpdate(HullMovingAverage(10), windowTolerance);
+}
+
+TEST(TamaTest, AmendReplacesLastComputedSample_test) {
+    expectAmendMatchesCompute(ExponentialMovingAverage(10), windowTolerance);
+    expectAmendMatchesCompute(DoubleExponentialMovingAverage(10), windowTolerance);
+    expectAmendMatchesCompute(TripleExponentialMovingAverage(10), windowTolerance);
+    expectAmendMatchesCompute(McGinleyDynamicMovingAverage(10), windowTolerance);
+    expectAmendMatchesCompute(SimpleMovingAverage(10), windowTolerance);
+    expectAmendMatchesCompute(WeightedMovingAverage(10), windowTolerance);
+    expectAmendMatchesCompute(HullMovingAverage(10), windowTolerance);
+
+    // A single computed sample is a seed, so amending it re-seeds.
+    vector<double> out;
+    ExponentialMovingAverage ema(10);
+    DoubleExponentialMovingAverage dema(10);
+    ASSERT_EQ(ema.compute(vector<double>{50.0}, out), status::ok);
+    ASSERT_EQ(dema.compute(vector<double>{50.0}, out), status::ok);
+    EXPECT_EQ(ema.amend(55.0), 55.0);
+    EXPECT_EQ(dema.amend(55.0), 55.0);
+}
+
+TEST(TamaTest, AmendVolumeAndOhlcVariants_test) {
+    const vector<double> prices = series(60, 100.0);
+    const vector<double> volumes = series(60, 1000.0);
+    vector<double> lows(prices);
+    vector<double> highs(prices);
+    for (size_t i = 0; i < prices.size(); i++) {
+        lows[i] -= 1.0 + static_cast<double>(i % 3);
+        highs[i] += 1.0 + static_cast<double>(i % 2);
+    }
+    vector<double> out;
+
+    VolumeWeightedMovingAverage vwma(10);
+    ASSERT_EQ(vwma.compute(prices, volumes, out), status::ok);
+    VolumeWeightedMovingAverage vwmaReference(vwma);
+    vwma.update(97.0, 800.0);
+    vwma.amend(103.0, 1500.0);
+    EXPECT_NEAR(vwma.amend(99.0, 900.0), vwmaReference.update(99.0, 900.0), windowTolerance);
+    EXPECT_EQ(vwma.getState().priceBuf, vwmaReference.getState().priceBuf);
+    EXPECT_EQ(vwma.getState().volumeBuf, vwmaReference.getState().volumeBuf);
+
+    FractalAdaptiveMovingAverage frama(10);
+    ASSERT_EQ(frama.compute(prices, lows, highs, out), status::ok);
+    FractalAdaptiveMovingAverage framaReference(frama);
+
+    // The bar's range first widens past the window extrema, then shrinks back
+    // inside them, which makes the extrema fall back to older bars.
+    frama.update(100.0, 99.0, 101.0);
+    frama.amend(104.0, 80.0, 130.0);
+    const double amended = frama.amend(100.5, 99.5, 100.75);
+    EXPECT_EQ(amended, framaReference.update(100.5, 99.5, 100.75));
+
+    const FractalAdaptiveMovingAverageState state = frama.getState();
+    const FractalAdaptiveMovingAverageState expected = framaReference.getState();
+    EXPECT_EQ(state.highBuf2, expected.highBuf2);
+    EXPECT_EQ(state.lowBuf2, expected.lowBuf2);
+    EXPECT_EQ(state.highBuf2Max, expected.highBuf2Max);
+    EXPECT_EQ(state.lowBuf2min, expected.lowBuf2min);
+    for (size_t i = 0; i < 12; i++) {
+        const double close = 100.0 + static_cast<double>(i % 5);
+        EXPECT_EQ(frama.update(close, close - 1.5, close + 2.0), framaReference.update(close, close - 1.5, close + 2.0));
+    }
+}
+
+TEST(TamaTest, AmendBeforeInitializationThrows_test) {
+    SimpleMovingAverage sma(5);
+    ExponentialMovingAverage ema(5);
+    FractalAdaptiveMovingAverage frama(6);
+    EXPECT_THROW(sma.amend(1.0), std::runtime_error);
+    EXPECT_THROW(ema.amend(1.0), std::runtime_error);
+    EXPECT_THROW(frama.amend(1.0, 0.5, 1.5), std::runtime_error);
+}
+
+TEST(TamaTest, AmendAfterRestoreMatchesLive_test) {
+    const vector<double> prices = series(60, 100.0);
+    vector<double> lows(prices);
+    vector<double> highs(prices);
+    for (size_t i = 0; i < prices.size(); i++) {
+        lows[i] -= 1.0 + static_cast<double>(i % 3);
+        highs[i] += 1.0 + static_cast<double>(i % 2);
+    }
+    vector<double> out;
+
+    // A restored indicator carries the value before its newest sample, so it
+    // amends exactly like the one it was taken from.
+    auto expectRestoredAmend = [&](auto live) {
+        ASSERT_EQ(live.compute(prices, out), status::ok);
+        decltype(live) restored(live.getState());
+        EXPECT_EQ(restored.amend(90.0), live.amend(90.0));
+        EXPECT_EQ(restored.update(101.0), live.update(101.0));
+    };
+    expectRestoredAmend(ExponentialMovingAverage(10));
+    expectRestoredAmend(DoubleExponentialMovingAverage(10));
+    expectRestoredAmend(TripleExponentialMovingAverage(10));
+    expectRestoredAmend(GeneralizedDoubleExponentialMovingAverage(0.7, 10));
+    expectRestoredAmend(McGinleyDynamicMovingAverage(10));
+
+    // A restored seed is still re-seeded.
+    ExponentialMovingAverage seeded(10);
+    ASSERT_EQ(seeded.compute(vector<double>{50.0}, out), status::ok);
+    EXPECT_EQ(ExponentialMovingAverage(seeded.getState()).amend(55.0), 55.0);
+
+    FractalAdaptiveMovingAverage frama(10);
+    ASSERT_EQ(frama.compute(prices, lows, highs, out), status::ok);
+    FractalAdaptiveMovingAverage framaRestored(frama.getState());
+    vector<std::byte> packed(frama.packedSize());
+    ASSERT_EQ(frama.pack(packed), status::ok);
+    FractalAdaptiveMovingAverage framaUnpacked{std::span<const std::byte>(packed)};
+    const double expected = frama.amend(90.0, 89.0, 91.0);
+    EXPECT_EQ(framaRestored.amend(90.0, 89.0, 91.0), expected);
+    EXPECT_EQ(framaUnpacked.amend(90.0, 89.0, 91.0), expected);
+
+    // computePaths() final states resume amend() from each path's own history.
+    McGinleyDynamicMovingAverage md(10);
+    vector<double> paths(prices);
+    paths.insert(paths.end(), prices.rbegin(), prices.rend());
+    vector<McGinleyDynamicMovingAverageState> finalStates(2);
+    ASSERT_EQ(md.computePaths(paths, 2, out, pathLayout::pathMajor, computeMode::restart, finalStates), status::ok);
+    McGinleyDynamicMovingAverage second(10);
+    ASSERT_EQ(second.compute(std::span<const double>(paths).subspan(prices.size()), out), status::ok);
+    EXPECT_EQ(McGinleyDynamicMovingAverage(finalStates[1]).amend(90.0), second.amend(90.0));
+}
+
+TEST(TamaTest, AmendWithUnknownPreviousValueThrows_test) {
+    // States built by hand, or warm starts, do not say what preceded the newest value.
+    ExponentialMovingAverage ema(ExponentialMovingAverageState{.lastEma = 100.0, .period = 10.0, .alpha = 2.0 / 11.0, .oma = 9.0 / 11.0});
+    McGinleyDynamicMovingAverage md(10, 100.0);
+    FractalAdaptiveMovingAverage frama(6);
+    vector<double> out;
+    const vector<double> bars(6, 100.0);
+    ASSERT_EQ(frama.compute(bars, bars, bars, out), status::ok);
+    FractalAdaptiveMovingAverageState framaState = frama.getState();
+    framaState.hasPrevFrama = false;
+    FractalAdaptiveMovingAverage framaRestored(framaState);
+
+    EXPECT_THROW(ema.amend(90.0), std::runtime_error);
+    EXPECT_THROW(md.amend(90.0), std::runtime_error);
+    EXPECT_THROW(framaRestored.amend(90.0, 89.0, 91.0), std::runtime_error);
+
+    // One update() makes the newest value known again.
+    ema.update(95.0);
+    md.update(95.0);
+    EXPECT_EQ(ema.amend(90.0), ExponentialMovingAverage(ExponentialMovingAverageState{.lastEma = 100.0, .period = 10.0, .alpha = 2.0 / 11.0, .oma = 9.0 / 11.0}).update(90.0));
+    EXPECT_EQ(md.amend(90.0), McGinleyDynamicMovingAverage(10, 100.0).update(90.0));
+}
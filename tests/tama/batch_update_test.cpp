@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <tama/tama.hpp>
+#include <vector>
+#include <stdexcept>
+
+using std::vector;
+
+using namespace tama;
+
+namespace {
+    // tama exports -ffp-contract=off, so inlined single updates round like the
+    // library's batch loops even in a header-inline build.
+    constexpr double tolerance = 0.0;
+
+    vector<double> series(size_t n, double base) {
+        vector<double> values(n);
+        for (size_t i = 0; i < n; i++) {
+            values[i] = base + static_cast<double>((i * 37) % 17) - 0.5 * static_cast<double>(i % 3);
+        }
+        return values;
+    }
+
+    // Feeds `ticks` to `batched` in one call and to `single` one tick at a time,
+    // then checks the outputs and one further update.
+    template <typename Indicator>
+    void expectBatchMatchesSingle(Indicator batched, Indicator single, const vector<double>& ticks) {
+        vector<double> out(ticks.size());
+        ASSERT_EQ(batched.update(ticks, std::span<double>(out)), status::ok);
+
+        for (size_t t = 0; t < ticks.size(); t++) {
+            EXPECT_NEAR(out[t], single.update(ticks[t]), tolerance) << "differs at tick " << t;
+        }
+        EXPECT_NEAR(batched.latest(), single.latest(), tolerance);
+        EXPECT_NEAR(batched.update(101.0), single.update(101.0), tolerance);
+    }
+
+    template <typename Indicator>
+    void checkAllBatchSizes(Indicator seeded) {
+        for (size_t n : {1u, 3u, 9u, 40u}) {
+            expectBatchMatchesSingle(seeded, seeded, series(n, 95.0));
+        }
+    }
+
+    template <typename Indicator>
+    Indicator seeded(Indicator indicator) {
+        vector<double> out;
+        EXPECT_EQ(indicator.compute(series(60, 100.0), out), status::ok);
+        return indicator;
+    }
+}
+
+TEST(TamaTest, BatchUpdateMatchesSingleUpdates_test) {
+    checkAllBatchSizes(seeded(ExponentialMovingAverage(10)));
+    checkAllBatchSizes(seeded(SimpleMovingAverage(10)));
+    checkAllBatchSizes(seeded(WeightedMovingAverage(10)));
+    checkAllBatchSizes(seeded(HullMovingAverage(10)));
+    checkAllBatchSizes(seeded(DoubleExponentialMovingAverage(10)));
+    checkAllBatchSizes(seeded(TripleExponentialMovingAverage(10)));
+    checkAllBatchSizes(seeded(McGinleyDynamicMovingAverage(10)));
+    checkAllBatchSizes(seeded(GeneralizedDoubleExponentialMovingAverage(0.7, 10)));
+}
+
+TEST(TamaTest, BatchUpdateVolumeAndOhlcVariants_test) {
+    const vector<double> prices = series(60, 100.0);
+    const vector<double> volumes = series(60, 1000.0);
+    vector<double> out;
+
+    VolumeWeightedMovingAverage vwma(10);
+    ASSERT_EQ(vwma.compute(prices, volumes, out), status::ok);
+    FractalAdaptiveMovingAverage frama(10);
+    vector<double> lows(prices);
+    vector<double> highs(prices);
+    for (size_t i = 0; i < prices.size(); i++) {
+        lows[i] -= 2.0;
+        highs[i] += 2.0;
+    }
+    ASSERT_EQ(frama.compute(prices, lows, highs, out), status::ok);
+
+    for (size_t n : {1u, 7u, 25u}) {
+        const vector<double> ticks = series(n, 97.0);
+        const vector<double> tickVolumes = series(n, 900.0);
+        vector<double> tickLows(ticks);
+        vector<double> tickHighs(ticks);
+        for (size_t i = 0; i < n; i++) {
+            tickLows[i] -= 1.0;
+            tickHighs[i] += 3.0;
+        }
+
+        VolumeWeightedMovingAverage vwmaSingle(vwma);
+        VolumeWeightedMovingAverage vwmaBatched(vwma);
+        FractalAdaptiveMovingAverage framaSingle(frama);
+        FractalAdaptiveMovingAverage framaBatched(frama);
+
+        vector<double> vwmaOut(n);
+        vector<double> framaOut(n);
+        ASSERT_EQ(vwmaBatched.update(ticks, tickVolumes, std::span<double>(vwmaOut)), status::ok);
+        ASSERT_EQ(framaBatched.update(ticks, tickLows, tickHighs, std::span<double>(framaOut)), status::ok);
+        for (size_t t = 0; t < n; t++) {
+            EXPECT_NEAR(vwmaOut[t], vwmaSingle.update(ticks[t], tickVolumes[t]), tolerance) << "differs at tick " << t;
+            EXPECT_NEAR(framaOut[t], framaSingle.update(ticks[t], tickLows[t], tickHighs[t]), tolerance) << "differs at tick " << t;
+        }
+
+        EXPECT_EQ(vwmaBatched.getState().priceBuf, vwmaSingle.getState().priceBuf);
+        EXPECT_EQ(vwmaBatched.getState().volumeBuf, vwmaSingle.getState().volumeBuf);
+        EXPECT_NEAR(vwmaBatched.update(99.0, 950.0), vwmaSingle.update(99.0, 950.0), tolerance);
+        EXPECT_NEAR(framaBatched.update(99.0, 98.0, 101.0), framaSingle.update(99.0, 98.0, 101.0), tolerance);
+    }
+}
+
+TEST(TamaTest, BatchUpdateRejectsInvalidParams_test) {
+    const vector<double> ticks{10, 11, 12};
+    const vector<double> empty{};
+    vector<double> out(2);
+
+    SimpleMovingAverage sma(2);
+    EXPECT_EQ(sma.update(empty, std::span<double>(out)), status::emptyParams);
+    EXPECT_EQ(sma.update(ticks, std::span<double>(out)), status::invalidParam);
+
+    out.resize(ticks.size());
+    EXPECT_THROW(sma.update(ticks, std::span<double>(out)), std::runtime_error);
+
+    VolumeWeightedMovingAverage vwma(2, {10, 11}, {1, 1});
+    EXPECT_EQ(vwma.update(ticks, vector<double>{1, 1}, std::span<double>(out)), status::invalidParam);
+    EXPECT_EQ(vwma.update(ticks, vector<double>{1, 1, 1}, std::span<double>(out)), status::ok);
+}
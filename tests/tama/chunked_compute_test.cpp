@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <tama/tama.hpp>
+#include <cstring>
+#include <vector>
+
+using std::vector;
+
+using namespace tama;
+
+namespace {
+    vector<double> series(size_t n, double base) {
+        vector<double> values(n);
+        for (size_t i = 0; i < n; i++) {
+            values[i] = base + static_cast<double>((i * 7919) % 31) * 0.37 - static_cast<double>(i % 5);
+        }
+        return values;
+    }
+
+    // Chunk lengths after the first: single samples, less than a window, and long runs.
+    const vector<size_t> chunkSizes{1, 3, 1, 17, 250, 2, 64, 9, 1000};
+
+    bool sameBytes(const vector<double>& a, const vector<double>& b) {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+    }
+
+    // `run(indicator, offset, length, out)` computes one chunk in the given mode.
+    template <typename Indicator, typename Run>
+    void expectChunksMatchWhole(Indicator whole, Indicator chunked, size_t total, size_t firstChunk, Run&& run) {
+        vector<double> expected(total);
+        ASSERT_EQ(run(whole, 0, total, std::span<double>(expected), computeMode::restart), status::ok);
+
+        vector<double> actual(total);
+        size_t offset = 0;
+        size_t next = firstChunk;
+        for (size_t k = 0; offset < total; k++) {
+            const size_t length = std::min(next, total - offset);
+            ASSERT_EQ(run(chunked, offset, length, std::span<double>(actual).subspan(offset, length), computeMode::resume), status::ok);
+            offset += length;
+            next = chunkSizes[k % chunkSizes.size()];
+        }
+
+        EXPECT_TRUE(sameBytes(actual, expected));
+        EXPECT_EQ(chunked.latest(), whole.latest());
+    }
+}
+
+TEST(TamaTest, ChunkedComputeMatchesWholeSeries_test) {
+    const vector<double> prices = series(3000, 100.0);
+    auto run = [&](auto& indicator, size_t offset, size_t length, std::span<double> out, computeMode mode) {
+        return indicator.compute(std::span<const double>(prices).subspan(offset, length), out, mode);
+    };
+
+    expectChunksMatchWhole(ExponentialMovingAverage(14), ExponentialMovingAverage(14), prices.size(), 40, run);
+    expectChunksMatchWhole(SimpleMovingAverage(14), SimpleMovingAverage(14), prices.size(), 40, run);
+    expectChunksMatchWhole(WeightedMovingAverage(14), WeightedMovingAverage(14), prices.size(), 40, run);
+    expectChunksMatchWhole(HullMovingAverage(16), HullMovingAverage(16), prices.size(), 40, run);
+    expectChunksMatchWhole(DoubleExponentialMovingAverage(14), DoubleExponentialMovingAverage(14), prices.size(), 40, run);
+    expectChunksMatchWhole(TripleExponentialMovingAverage(14), TripleExponentialMovingAverage(14), prices.size(), 40, run);
+    expectChunksMatchWhole(McGinleyDynamicMovingAverage(14), McGinleyDynamicMovingAverage(14), prices.size(), 40, run);
+    expectChunksMatchWhole(GeneralizedDoubleExponentialMovingAverage(0.7, 14), GeneralizedDoubleExponentialMovingAverage(0.7, 14), prices.size(), 40, run);
+}
+
+TEST(TamaTest, ChunkedComputeVolumeAndOhlc_test) {
+    const vector<double> prices = series(3000, 100.0);
+    const vector<double> volumes = series(3000, 1000.0);
+    vector<double> lows(prices);
+    vector<double> highs(prices);
+    for (size_t i = 0; i < prices.size(); i++) {
+        lows[i] -= 1.0 + static_cast<double>(i % 3);
+        highs[i] += 1.0 + static_cast<double>(i % 4);
+    }
+
+    expectChunksMatchWhole(VolumeWeightedMovingAverage(14), VolumeWeightedMovingAverage(14), prices.size(), 40,
+        [&](auto& indicator, size_t offset, size_t length, std::span<double> out, computeMode mode) {
+            return indicator.compute(std::span<const double>(prices).subspan(offset, length), std::span<const double>(volumes).subspan(offset, length), out, mode);
+        });
+    expectChunksMatchWhole(FractalAdaptiveMovingAverage(16), FractalAdaptiveMovingAverage(16), prices.size(), 40,
+        [&](auto& indicator, size_t offset, size_t length, std::span<double> out, computeMode mode) {
+            return indicator.compute(std::span<const double>(prices).subspan(offset, length), std::span<const double>(lows).subspan(offset, length),
+                std::span<const double>(highs).subspan(offset, length), out, mode);
+        });
+}
+
+TEST(TamaTest, RestartModeDiscardsPreviousState_test) {
+    const vector<double> prices = series(200, 100.0);
+    const std::span<const double> head(prices.data(), 100);
+    const std::span<const double> tail(prices.data() + 100, 100);
+
+    vector<double> fresh;
+    vector<double> restarted;
+    SimpleMovingAverage reference(10);
+    SimpleMovingAverage sma(10);
+    ASSERT_EQ(reference.compute(tail, fresh), status::ok);
+    ASSERT_EQ(sma.compute(head, restarted), status::ok);
+    ASSERT_EQ(sma.compute(tail, restarted), status::ok);
+    EXPECT_EQ(restarted, fresh);
+
+    // A first chunk in resume mode on a fresh indicator is an ordinary compute(),
+    // so it still needs a full window.
+    vector<double> out(5);
+    SimpleMovingAverage shortStart(10);
+    EXPECT_EQ(shortStart.compute(std::span<const double>(prices.data(), 5), std::span<double>(out), computeMode::resume), status::invalidParam);
+}
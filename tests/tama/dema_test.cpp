@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <tama/tama.hpp>
 #include <vector>
+#include <random>
 #include <stdexcept>
 
 using std::vector;
@@ -38,3 +39,82 @@ TEST(TamaTest, DemaRejectsInvalidParams_test) {
 
     EXPECT_THROW(DoubleExponentialMovingAverage(0), std::invalid_argument);
 }
+
+TEST(TamaTest, DemaSweepMatchesCompute_test) {
+    std::mt19937_64 gen(7);
+    std::uniform_real_distribution<double> dist(1.0, 100.0);
+    vector<double> prices(2'000);
+    for (double& p : prices) {
+        p = dist(gen);
+    }
+    vector<uint16_t> periods;
+    for (uint16_t p = 2; p < 39; p++) {
+        periods.push_back(p);
+    }
+
+    vector<double> periodMajor;
+    vector<double> timeMajor;
+    ASSERT_EQ(DoubleExponentialMovingAverage::sweep(prices, periods, periodMajor), status::ok);
+    ASSERT_EQ(DoubleExponentialMovingAverage::sweep(prices, periods, timeMajor, sweepLayout::timeMajor), status::ok);
+    ASSERT_EQ(periodMajor.size(), periods.size() * prices.size());
+
+    for (size_t k = 0; k < periods.size(); k++) {
+        vector<double> expected;
+        ASSERT_EQ(DoubleExponentialMovingAverage(periods[k]).compute(prices, expected), status::ok);
+
+        for (size_t t = 0; t < prices.size(); t++) {
+            EXPECT_NEAR(periodMajor[k * prices.size() + t], expected[t], 1e-9) << "period " << periods[k] << " differs at index " << t;
+            EXPECT_NEAR(timeMajor[t * periods.size() + k], expected[t], 1e-9) << "period " << periods[k] << " differs at index " << t;
+        }
+    }
+}
+
+TEST(TamaTest, DemaComputeLeavesCascadedEmaState_test) {
+    const vector<double> prices{10, 12, 11, 13, 12, 14, 15, 13, 14, 16};
+    vector<double> demaOut;
+    vector<double> ema1Out;
+    vector<double> ema2Out;
+
+    DoubleExponentialMovingAverage dema(3);
+    ASSERT_EQ(dema.compute(prices, demaOut), status::ok);
+
+    tama::ExponentialMovingAverage ema1(3);
+    tama::ExponentialMovingAverage ema2(3);
+    ASSERT_EQ(ema1.compute(prices, ema1Out), status::ok);
+    ASSERT_EQ(ema2.compute(ema1Out, ema2Out), status::ok);
+
+    const DoubleExponentialMovingAverageState state = dema.getState();
+    EXPECT_TRUE(state.initialized);
+    EXPECT_NEAR(state.ema1.lastEma, ema1.latest(), 1e-12);
+    EXPECT_NEAR(state.ema2.lastEma, ema2.latest(), 1e-12);
+    EXPECT_NEAR(dema.latest(), 2.0 * ema1.latest() - ema2.latest(), 1e-12);
+
+    DoubleExponentialMovingAverage warm(3, vector<double>(prices.end() - 3, prices.end()));
+    DoubleExponentialMovingAverage warmBaseline(3);
+    ASSERT_EQ(warmBaseline.compute(vector<double>(prices.end() - 3, prices.end()), demaOut), status::ok);
+    EXPECT_NEAR(warm.update(17.0), warmBaseline.update(17.0), 1e-12);
+}
+
+TEST(TamaTest, DemaRejectsMismatchedStageStates_test) {
+    const vector<double> prices{10, 11, 12, 13, 14, 15, 14, 13, 12, 11};
+    vector<double> out;
+    tama::ExponentialMovingAverage fast(5);
+    tama::ExponentialMovingAverage slow(20);
+    ASSERT_EQ(fast.compute(prices, out), status::ok);
+    ASSERT_EQ(slow.compute(prices, out), status::ok);
+
+    // compute() fuses the stages with one alpha, so stages of another period
+    // would silently disagree with update().
+    DoubleExponentialMovingAverageState state{.period = 5, .initialized = true, .lastDema = 10.0, .ema1 = fast.getState(), .ema2 = slow.getState()};
+    EXPECT_THROW(DoubleExponentialMovingAverage{state}, std::invalid_argument);
+    state.ema2 = fast.getState();
+    EXPECT_NO_THROW(DoubleExponentialMovingAverage{state});
+    state.period = 20;
+    EXPECT_THROW(DoubleExponentialMovingAverage{state}, std::invalid_argument);
+
+    TripleExponentialMovingAverageState tema{.period = 5, .initialized = true, .lastTema = 10.0, .ema1 = fast.getState(), .ema2 = fast.getState(), .ema3 = slow.getState()};
+    EXPECT_THROW(tama::TripleExponentialMovingAverage{tema}, std::invalid_argument);
+
+    GeneralizedDoubleExponentialMovingAverageState gd{.period = 0.7, .emaPeriod = 5, .onePlusPeriod = 1.7, .lastGd = 10.0, .ema1 = fast.getState(), .ema2 = slow.getState()};
+    EXPECT_THROW(tama::GeneralizedDoubleExponentialMovingAverage{gd}, std::invalid_argument);
+}
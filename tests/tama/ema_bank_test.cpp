@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include <tama/tama.hpp>
+#include <vector>
+#include <stdexcept>
+
+using std::vector;
+
+using namespace tama;
+
+namespace {
+    // prices[t][i] is the tick at time t for instrument i.
+    const vector<vector<double>> prices{
+        {11, 10, 101, 55, 7},
+        {12, 12, 99, 54, 8},
+        {14, 11, 98, 56, 9},
+        {18, 13, 102, 57, 7},
+        {12, 12, 104, 53, 6},
+        {15, 14, 103, 52, 8},
+        {13, 15, 101, 58, 9},
+        {16, 13, 100, 59, 10},
+        {10, 14, 97, 60, 9},
+    };
+    const vector<uint16_t> periods{3, 5, 10, 2, 7};
+
+    vector<double> column(size_t instrument) {
+        vector<double> values;
+        for (const auto& row : prices) {
+            values.push_back(row[instrument]);
+        }
+        return values;
+    }
+}
+
+TEST(TamaTest, EmaBankMatchesPerInstrumentCompute_test) {
+    ExponentialMovingAverageBank bank(periods);
+
+    vector<vector<double>> bankOut;
+    for (const auto& row : prices) {
+        ASSERT_EQ(bank.update(row), status::ok);
+        bankOut.emplace_back(bank.latest().begin(), bank.latest().end());
+    }
+
+    for (size_t i = 0; i < periods.size(); i++) {
+        vector<double> expected;
+        ExponentialMovingAverage ema(periods[i]);
+        ASSERT_EQ(ema.compute(column(i), expected), status::ok);
+
+        for (size_t t = 0; t < prices.size(); t++) {
+            EXPECT_NEAR(bankOut[t][i], expected[t], 1e-12) << "instrument " << i << " differs at index " << t;
+        }
+    }
+}
+
+TEST(TamaTest, EmaBankStateRoundTrip_test) {
+    ExponentialMovingAverageBank bank(periods);
+    for (const auto& row : prices) {
+        ASSERT_EQ(bank.update(row), status::ok);
+    }
+
+    vector<ExponentialMovingAverageState> states;
+    for (size_t i = 0; i < bank.size(); i++) {
+        states.push_back(bank.getState(i));
+    }
+
+    ExponentialMovingAverageBank resumed(states);
+    const vector<double> next{19, 16, 95, 61, 11};
+    ASSERT_EQ(bank.update(next), status::ok);
+    ASSERT_EQ(resumed.update(next), status::ok);
+
+    for (size_t i = 0; i < bank.size(); i++) {
+        ExponentialMovingAverage single(states[i]);
+        EXPECT_NEAR(resumed.latest()[i], bank.latest()[i], 1e-12);
+        EXPECT_NEAR(single.update(next[i]), bank.latest()[i], 1e-12);
+    }
+}
+
+TEST(TamaTest, EmaBankRejectsInvalidParams_test) {
+    ExponentialMovingAverageBank bank(periods);
+    const vector<double> tooShort{1, 2};
+    const vector<double> empty{};
+
+    EXPECT_EQ(bank.update(tooShort), status::invalidParam);
+    EXPECT_EQ(bank.update(empty), status::emptyParams);
+    EXPECT_THROW(ExponentialMovingAverageBank(vector<uint16_t>{3, 0}), std::invalid_argument);
+    EXPECT_THROW(bank.getState(periods.size()), std::out_of_range);
+}
+
+TEST(TamaTest, DemaTemaBanksMatchPerInstrumentCompute_test) {
+    DoubleExponentialMovingAverageBank demaBank(periods);
+    TripleExponentialMovingAverageBank temaBank(periods);
+
+    vector<vector<double>> demaOut;
+    vector<vector<double>> temaOut;
+    for (const auto& row : prices) {
+        ASSERT_EQ(demaBank.update(row), status::ok);
+        ASSERT_EQ(temaBank.update(row), status::ok);
+        demaOut.emplace_back(demaBank.latest().begin(), demaBank.latest().end());
+        temaOut.emplace_back(temaBank.latest().begin(), temaBank.latest().end());
+    }
+
+    for (size_t i = 0; i < periods.size(); i++) {
+        vector<double> demaExpected;
+        vector<double> temaExpected;
+        DoubleExponentialMovingAverage dema(periods[i]);
+        TripleExponentialMovingAverage tema(periods[i]);
+        ASSERT_EQ(dema.compute(column(i), demaExpected), status::ok);
+        ASSERT_EQ(tema.compute(column(i), temaExpected), status::ok);
+
+        for (size_t t = 0; t < prices.size(); t++) {
+            EXPECT_NEAR(demaOut[t][i], demaExpected[t], 1e-12) << "instrument " << i << " differs at index " << t;
+            EXPECT_NEAR(temaOut[t][i], temaExpected[t], 1e-12) << "instrument " << i << " differs at index " << t;
+        }
+
+        const double next = 17.0;
+        DoubleExponentialMovingAverage demaResumed(demaBank.getState(i));
+        TripleExponentialMovingAverage temaResumed(temaBank.getState(i));
+        EXPECT_NEAR(demaResumed.update(next), dema.update(next), 1e-12);
+        EXPECT_NEAR(temaResumed.update(next), tema.update(next), 1e-12);
+    }
+}
+
+TEST(TamaTest, GdBankMatchesPerInstrumentCompute_test) {
+    const vector<double> volumeFactors{0.7, 0.5, 1.0, 0.3, 0.9};
+    GeneralizedDoubleExponentialMovingAverageBank bank(volumeFactors, periods);
+
+    vector<vector<double>> bankOut;
+    for (const auto& row : prices) {
+        ASSERT_EQ(bank.update(row), status::ok);
+        bankOut.emplace_back(bank.latest().begin(), bank.latest().end());
+    }
+
+    for (size_t i = 0; i < periods.size(); i++) {
+        vector<double> expected;
+        GeneralizedDoubleExponentialMovingAverage gd(volumeFactors[i], periods[i]);
+        ASSERT_EQ(gd.compute(column(i), expected), status::ok);
+
+        for (size_t t = 0; t < prices.size(); t++) {
+            EXPECT_NEAR(bankOut[t][i], expected[t], 1e-12) << "instrument " << i << " differs at index " << t;
+        }
+
+        GeneralizedDoubleExponentialMovingAverage resumed(bank.getState(i));
+        EXPECT_NEAR(resumed.update(17.0), gd.update(17.0), 1e-12);
+    }
+}
+
+TEST(TamaTest, MdBankMatchesPerInstrumentCompute_test) {
+    for (mdArithmetic arithmetic : {mdArithmetic::exact, mdArithmetic::fast}) {
+        McGinleyDynamicMovingAverageBank bank(periods, arithmetic);
+
+        vector<vector<double>> bankOut;
+        for (const auto& row : prices) {
+            ASSERT_EQ(bank.update(row), status::ok);
+            bankOut.emplace_back(bank.latest().begin(), bank.latest().end());
+        }
+
+        for (size_t i = 0; i < periods.size(); i++) {
+            vector<double> expected;
+            McGinleyDynamicMovingAverage md(periods[i], 0.0, arithmetic);
+            ASSERT_EQ(md.compute(column(i), expected), status::ok);
+
+            // Exact lanes round like compute(); fast lanes may fuse differently.
+            for (size_t t = 0; t < prices.size(); t++) {
+                if (arithmetic == mdArithmetic::exact) {
+                    EXPECT_EQ(bankOut[t][i], expected[t]) << "instrument " << i << " differs at index " << t;
+                } else {
+                    EXPECT_NEAR(bankOut[t][i], expected[t], 1e-12 * expected[t]) << "instrument " << i << " differs at index " << t;
+                }
+            }
+
+            McGinleyDynamicMovingAverage resumed(bank.getState(i));
+            EXPECT_NEAR(resumed.update(17.0), md.update(17.0), 1e-12 * md.latest());
+        }
+    }
+}
+
+TEST(TamaTest, MdBankRejectsInvalidParams_test) {
+    McGinleyDynamicMovingAverageBank bank(periods, mdArithmetic::fast);
+    const vector<double> tooShort{1, 2};
+    const vector<double> empty{};
+
+    EXPECT_EQ(bank.update(tooShort), status::invalidParam);
+    EXPECT_EQ(bank.update(empty), status::emptyParams);
+    EXPECT_THROW(McGinleyDynamicMovingAverageBank(vector<uint16_t>{3, 0}), std::invalid_argument);
+    EXPECT_THROW(bank.getState(periods.size()), std::out_of_range);
+
+    const vector<McGinleyDynamicMovingAverageState> mixed{
+        {.period = 3, .lastMd = 10.0, .initialized = true, .arithmetic = mdArithmetic::exact},
+        {.period = 5, .lastMd = 12.0, .initialized = true, .arithmetic = mdArithmetic::fast},
+    };
+    EXPECT_THROW(McGinleyDynamicMovingAverageBank{mixed}, std::invalid_argument);
+}
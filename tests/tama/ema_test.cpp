@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <tama/tama.hpp>
 #include <vector>
+#include <random>
 
 using std::vector;
 
@@ -74,4 +75,65 @@ TEST(TamaTest, EmaConstructorUsesPreviousCalculationForUpdate_test) {
     const double resumedUpdated = resumed.update(newPrice);
 
     EXPECT_NEAR(resumedUpdated, baselineUpdated, 1e-12);
-}
\ No newline at end of file
+}
+
+TEST(TamaTest, EmaSweepMatchesCompute_test) {
+    std::mt19937_64 gen(7);
+    std::uniform_real_distribution<double> dist(1.0, 100.0);
+    vector<double> prices(2'000);
+    for (double& p : prices) {
+        p = dist(gen);
+    }
+    vector<uint16_t> periods;
+    for (uint16_t p = 2; p < 39; p++) {
+        periods.push_back(p);
+    }
+
+    vector<double> periodMajor;
+    vector<double> timeMajor;
+    ASSERT_EQ(ExponentialMovingAverage::sweep(prices, periods, periodMajor), status::ok);
+    ASSERT_EQ(ExponentialMovingAverage::sweep(prices, periods, timeMajor, sweepLayout::timeMajor), status::ok);
+    ASSERT_EQ(periodMajor.size(), periods.size() * prices.size());
+
+    for (size_t k = 0; k < periods.size(); k++) {
+        vector<double> expected;
+        ASSERT_EQ(ExponentialMovingAverage(periods[k]).compute(prices, expected), status::ok);
+
+        for (size_t t = 0; t < prices.size(); t++) {
+            EXPECT_NEAR(periodMajor[k * prices.size() + t], expected[t], 1e-9) << "period " << periods[k] << " differs at index " << t;
+            EXPECT_NEAR(timeMajor[t * periods.size() + k], expected[t], 1e-9) << "period " << periods[k] << " differs at index " << t;
+        }
+    }
+}
+
+TEST(TamaTest, EmaComputeScanMatchesCompute_test) {
+    std::mt19937_64 gen(11);
+    std::uniform_real_distribution<double> dist(1.0, 100.0);
+    vector<double> prices(400'003);
+    for (double& p : prices) {
+        p = dist(gen);
+    }
+
+    for (uint16_t period : {1, 3, 200, 60'000}) {
+        vector<double> expected;
+        vector<double> simdOut;
+        vector<double> threadedOut;
+
+        ExponentialMovingAverage serial(period);
+        ExponentialMovingAverage simd(period);
+        ExponentialMovingAverage threaded(period);
+        ASSERT_EQ(serial.compute(prices, expected), status::ok);
+        ASSERT_EQ(simd.computeScan(prices, simdOut, scanMode::simd), status::ok);
+        ASSERT_EQ(threaded.computeScan(prices, threadedOut, scanMode::threaded, 4), status::ok);
+
+        ASSERT_EQ(simdOut.size(), prices.size());
+        ASSERT_EQ(threadedOut.size(), prices.size());
+        for (size_t t = 0; t < prices.size(); t++) {
+            ASSERT_NEAR(simdOut[t], expected[t], 1e-12 * expected[t]) << "period " << period << " differs at index " << t;
+            ASSERT_NEAR(threadedOut[t], expected[t], 1e-12 * expected[t]) << "period " << period << " differs at index " << t;
+        }
+
+        EXPECT_NEAR(threaded.latest(), serial.latest(), 1e-12 * serial.latest());
+        EXPECT_NEAR(threaded.update(19.0), serial.update(19.0), 1e-12 * serial.latest());
+    }
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <tama/tama.hpp>
+#include <vector>
+
+using std::vector;
+
+using namespace tama;
+
+namespace {
+    vector<double> series(size_t n, double base) {
+        vector<double> values(n);
+        for (size_t i = 0; i < n; i++) {
+            values[i] = base + static_cast<double>((i * 29) % 17) * 0.6 - static_cast<double>(i % 3);
+        }
+        return values;
+    }
+
+    // A fork must behave exactly like a deep copy taken at the same point, on both
+    // sides, including a branch forked again halfway through its window.
+    template <typename Indicator>
+    void expectForkMatchesCopy(Indicator indicator) {
+        vector<double> out;
+        ASSERT_EQ(indicator.compute(series(90, 100.0), out), status::ok);
+
+        Indicator parentCopy(indicator);
+        Indicator branchCopy(indicator);
+        Indicator branch = indicator.fork();
+
+        const vector<double> up = series(40, 104.0);
+        const vector<double> down = series(40, 93.0);
+        for (size_t i = 0; i < up.size(); i++) {
+            EXPECT_EQ(indicator.update(up[i]), parentCopy.update(up[i])) << "tick " << i;
+            EXPECT_EQ(branch.update(down[i]), branchCopy.update(down[i])) << "tick " << i;
+
+            if (i == 4) {
+                Indicator nestedCopy(branch);
+                Indicator nested = branch.fork();
+                for (double price : series(20, 110.0)) {
+                    EXPECT_EQ(nested.update(price), nestedCopy.update(price));
+                }
+            }
+        }
+    }
+}
+
+TEST(TamaTest, ForkMatchesDeepCopy_test) {
+    expectForkMatchesCopy(ExponentialMovingAverage(12));
+    expectForkMatchesCopy(SimpleMovingAverage(12));
+    expectForkMatchesCopy(WeightedMovingAverage(12));
+    expectForkMatchesCopy(HullMovingAverage(16));
+    expectForkMatchesCopy(DoubleExponentialMovingAverage(12));
+    expectForkMatchesCopy(TripleExponentialMovingAverage(12));
+    expectForkMatchesCopy(McGinleyDynamicMovingAverage(12));
+    expectForkMatchesCopy(GeneralizedDoubleExponentialMovingAverage(0.7, 12));
+}
+
+TEST(TamaTest, ForkVolumeAndOhlcVariants_test) {
+    const vector<double> prices = series(90, 100.0);
+    const vector<double> volumes = series(90, 1000.0);
+    vector<double> lows(prices);
+    vector<double> highs(prices);
+    for (size_t i = 0; i < prices.size(); i++) {
+        lows[i] -= 1.0 + static_cast<double>(i % 3);
+        highs[i] += 1.0 + static_cast<double>(i % 2);
+    }
+    vector<double> out;
+
+    VolumeWeightedMovingAverage vwma(12);
+    ASSERT_EQ(vwma.compute(prices, volumes, out), status::ok);
+    VolumeWeightedMovingAverage vwmaCopy(vwma);
+    VolumeWeightedMovingAverage vwmaBranch = vwma.fork();
+    for (size_t i = 0; i < 30; i++) {
+        const double price = 95.0 + static_cast<double>(i % 7);
+        EXPECT_EQ(vwmaBranch.update(price, 500.0), vwmaCopy.update(price, 500.0));
+    }
+    EXPECT_EQ(vwma.update(100.0, 800.0), VolumeWeightedMovingAverage(vwma).update(100.0, 800.0));
+
+    FractalAdaptiveMovingAverage frama(16);
+    ASSERT_EQ(frama.compute(prices, lows, highs, out), status::ok);
+    FractalAdaptiveMovingAverage framaCopy(frama);
+    FractalAdaptiveMovingAverage framaBranch = frama.fork();
+    for (size_t i = 0; i < 30; i++) {
+        const double close = 96.0 + static_cast<double>(i % 5);
+        EXPECT_EQ(framaBranch.update(close, close - 2.0, close + 1.5), framaCopy.update(close, close - 2.0, close + 1.5));
+    }
+}
+
+TEST(TamaTest, ForkedStateRoundTrips_test) {
+    vector<double> out;
+    HullMovingAverage hma(16);
+    ASSERT_EQ(hma.compute(series(90, 100.0), out), status::ok);
+    HullMovingAverage branch = hma.fork();
+
+    // A branch that has just amended an inherited sample, then resumed a chunk,
+    // reports the same state as a deep copy that did the same.
+    HullMovingAverage copy(hma);
+    branch.update(97.0);
+    copy.update(97.0);
+    EXPECT_EQ(branch.amend(99.5), copy.amend(99.5));
+
+    const HullMovingAverageState forked = branch.getState();
+    const HullMovingAverageState copied = copy.getState();
+    EXPECT_EQ(forked.w1.priceBuf, copied.w1.priceBuf);
+    EXPECT_EQ(forked.w2.priceBuf, copied.w2.priceBuf);
+    EXPECT_EQ(forked.w3.priceBuf, copied.w3.priceBuf);
+
+    vector<std::byte> forkedBytes(branch.packedSize());
+    vector<std::byte> copiedBytes(copy.packedSize());
+    ASSERT_EQ(branch.pack(forkedBytes), status::ok);
+    ASSERT_EQ(copy.pack(copiedBytes), status::ok);
+    EXPECT_EQ(forkedBytes, copiedBytes);
+
+    const vector<double> next = series(25, 101.0);
+    vector<double> forkedOut(next.size());
+    vector<double> copiedOut(next.size());
+    ASSERT_EQ(branch.compute(next, std::span<double>(forkedOut), computeMode::resume), status::ok);
+    ASSERT_EQ(copy.compute(next, std::span<double>(copiedOut), computeMode::resume), status::ok);
+    EXPECT_EQ(forkedOut, copiedOut);
+}
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include <tama/tama.hpp>
 #include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
 
 using std::vector;
 
@@ -55,4 +59,152 @@ TEST(TamaTest, FramaRollingUpdate) {
     double next = frama.update(nextClose, nextLow, nextHigh);
 
     EXPECT_NEAR(next, nextExp, 1e-1) << "got: " << next << " doesnt match expected: " << nextExp;
-}
\ No newline at end of file
+}
+TEST(TamaTest, FramaExtremaFollowMonotonicSeries_test) {
+    const size_t count = 64;
+    std::vector<double> high(count);
+    std::vector<double> low(count);
+    std::vector<double> close(count);
+    for (size_t i = 0; i < count; i++) {
+        low[i] = 1.0 + 0.1 * static_cast<double>(i);
+        high[i] = low[i] + 0.5;
+        close[i] = low[i] + 0.25;
+    }
+
+    const uint16_t period = 10;
+    std::vector<double> out;
+    FractalAdaptiveMovingAverage frama(period);
+    ASSERT_EQ(frama.compute(std::span<const double>(close).first(20), std::span<const double>(low).first(20), std::span<const double>(high).first(20), out), status::ok);
+
+    for (size_t i = 20; i < count; i++) {
+        frama.update(close[i], low[i], high[i]);
+
+        const FractalAdaptiveMovingAverageState state = frama.getState();
+        EXPECT_EQ(state.highBuf1Max, *std::max_element(state.highBuf1.begin(), state.highBuf1.end())) << "at index " << i;
+        EXPECT_EQ(state.highBuf2Max, *std::max_element(state.highBuf2.begin(), state.highBuf2.end())) << "at index " << i;
+        EXPECT_EQ(state.lowBuf1min, *std::min_element(state.lowBuf1.begin(), state.lowBuf1.end())) << "at index " << i;
+        EXPECT_EQ(state.lowBuf2min, *std::min_element(state.lowBuf2.begin(), state.lowBuf2.end())) << "at index " << i;
+    }
+
+    FractalAdaptiveMovingAverage resumed(frama.getState());
+    for (size_t i = 0; i < 8; i++) {
+        const double base = 10.0 - static_cast<double>(i);
+        EXPECT_EQ(resumed.update(base + 0.25, base, base + 0.5), frama.update(base + 0.25, base, base + 0.5)) << "step " << i;
+    }
+}
+
+namespace {
+    struct Ohlc {
+        vector<double> close;
+        vector<double> low;
+        vector<double> high;
+    };
+
+    // A random-walk-like series around `level`, with bar ranges about `range` of the price.
+    Ohlc bars(size_t n, double level, double range) {
+        Ohlc out;
+        double price = level;
+        for (size_t i = 0; i < n; i++) {
+            price *= 1.0 + (static_cast<double>((i * 7919) % 37) - 18.0) * range * 0.05;
+            const double spread = price * range * (0.2 + static_cast<double>((i * 31) % 11) * 0.1);
+            out.close.push_back(price);
+            out.low.push_back(price - spread * 0.6);
+            out.high.push_back(price + spread * 0.4);
+        }
+        return out;
+    }
+}
+
+TEST(TamaTest, FramaApproximateAlphaStaysWithinBound_test) {
+    // Penny stocks, FX, equities and crypto, from quiet to wild bars.
+    for (double level : {0.0123, 1.085, 100.0, 65000.0}) {
+        for (double range : {1e-4, 0.01, 0.05}) {
+            for (uint16_t period : {4, 16, 60}) {
+                for (double eulerNumber : {-4.6, -10.0}) {
+                    SCOPED_TRACE(testing::Message() << "level " << level << ", range " << range << ", period " << period << ", euler " << eulerNumber);
+                    const Ohlc series = bars(400, level, range);
+                    const size_t split = 250;
+                    vector<FractalAdaptiveMovingAverage> pair{
+                        FractalAdaptiveMovingAverage(period, eulerNumber),
+                        FractalAdaptiveMovingAverage(period, eulerNumber, framaArithmetic::approximate),
+                    };
+
+                    vector<double> exact;
+                    vector<double> approximate;
+                    const auto head = [&](const vector<double>& v) { return std::span<const double>(v.data(), split); };
+                    ASSERT_EQ(pair[0].compute(head(series.close), head(series.low), head(series.high), exact), status::ok);
+                    ASSERT_EQ(pair[1].compute(head(series.close), head(series.low), head(series.high), approximate), status::ok);
+                    for (size_t i = 0; i < split; i++) {
+                        ASSERT_NEAR(approximate[i], exact[i], 1e-13 * std::fabs(series.close[i])) << "index " << i;
+                    }
+
+                    double alphas[2];
+                    for (size_t i = split; i < series.close.size(); i++) {
+                        ASSERT_EQ(FractalAdaptiveMovingAverage::nextAlphas(pair, alphas), status::ok);
+                        ASSERT_NEAR(alphas[1], alphas[0], 1e-13 * alphas[0]) << "index " << i;
+
+                        const double e = pair[0].update(series.close[i], series.low[i], series.high[i]);
+                        const double a = pair[1].update(series.close[i], series.low[i], series.high[i]);
+                        ASSERT_NEAR(a, e, 1e-13 * std::fabs(series.close[i])) << "index " << i;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(TamaTest, FramaApproximateEntryPointsAgree_test) {
+    const Ohlc series = bars(300, 100.0, 0.01);
+    vector<double> whole;
+    FractalAdaptiveMovingAverage frama(16, -4.6, framaArithmetic::approximate);
+    ASSERT_EQ(frama.compute(series.close, series.low, series.high, whole), status::ok);
+
+    // The vectorized compute() passes, update() and nextAlphas() evaluate the same alpha.
+    const size_t split = 100;
+    const auto part = [&](const vector<double>& v, size_t from, size_t to) { return std::span<const double>(v.data() + from, to - from); };
+    vector<double> out;
+    FractalAdaptiveMovingAverage stepped(16, -4.6, framaArithmetic::approximate);
+    ASSERT_EQ(stepped.compute(part(series.close, 0, split), part(series.low, 0, split), part(series.high, 0, split), out), status::ok);
+    for (size_t i = split; i < series.close.size(); i++) {
+        double alpha;
+        ASSERT_EQ(FractalAdaptiveMovingAverage::nextAlphas(std::span<const FractalAdaptiveMovingAverage>(&stepped, 1), std::span<double>(&alpha, 1)), status::ok);
+        const double expected = alpha * series.close[i] + (1 - alpha) * stepped.latest();
+        EXPECT_NEAR(stepped.peek(series.close[i]), expected, 1e-12 * expected);
+        EXPECT_NEAR(stepped.update(series.close[i], series.low[i], series.high[i]), whole[i], 1e-12 * whole[i]) << "index " << i;
+    }
+
+    // Snapshots, views and packed bytes keep the arithmetic.
+    EXPECT_EQ(frama.view().arithmetic, framaArithmetic::approximate);
+    vector<std::byte> bytes(frama.packedSize());
+    ASSERT_EQ(frama.pack(bytes), status::ok);
+    FractalAdaptiveMovingAverage unpacked{std::span<const std::byte>(bytes)};
+    FractalAdaptiveMovingAverage restored(frama.getState());
+    EXPECT_EQ(unpacked.getState().arithmetic, framaArithmetic::approximate);
+    EXPECT_EQ(restored.update(101.0, 99.0, 102.0), frama.update(101.0, 99.0, 102.0));
+}
+
+TEST(TamaTest, FramaApproximateHandlesDegenerateWindows_test) {
+    // Two flat half-windows at different levels give ratio 0, so alpha is 1; a single
+    // flat window gives 0 / 0, which both arithmetics carry through as NaN.
+    const vector<double> stepUp{10, 10, 10, 10, 11, 11, 11, 11, 11};
+    const vector<double> flat(9, 10.0);
+    for (const vector<double>* prices : {&stepUp, &flat}) {
+        vector<double> exact;
+        vector<double> approximate;
+        ASSERT_EQ(FractalAdaptiveMovingAverage(8).compute(*prices, *prices, *prices, exact), status::ok);
+        ASSERT_EQ(FractalAdaptiveMovingAverage(8, -4.6, framaArithmetic::approximate).compute(*prices, *prices, *prices, approximate), status::ok);
+        for (size_t i = 0; i < exact.size(); i++) {
+            if (std::isnan(exact[i])) {
+                EXPECT_TRUE(std::isnan(approximate[i])) << "index " << i;
+            } else {
+                EXPECT_EQ(approximate[i], exact[i]) << "index " << i;
+            }
+        }
+    }
+
+    const vector<FractalAdaptiveMovingAverage> none;
+    double alpha = 0.0;
+    EXPECT_EQ(FractalAdaptiveMovingAverage::nextAlphas(none, std::span<double>(&alpha, 1)), status::emptyParams);
+    const vector<FractalAdaptiveMovingAverage> fresh{FractalAdaptiveMovingAverage(8)};
+    EXPECT_THROW(FractalAdaptiveMovingAverage::nextAlphas(fresh, std::span<double>(&alpha, 1)), std::runtime_error);
+}
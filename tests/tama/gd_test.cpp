@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <tama/tama.hpp>
 #include <vector>
+#include <random>
 #include <stdexcept>
 
 using std::vector;
@@ -78,3 +79,32 @@ TEST(TamaTest, GdRejectsInvalidParams_test) {
 	EXPECT_THROW(GeneralizedDoubleExponentialMovingAverage(0.0, 3), std::invalid_argument);
 	EXPECT_THROW(GeneralizedDoubleExponentialMovingAverage(0.7, 0), std::invalid_argument);
 }
+
+TEST(TamaTest, GdSweepMatchesCompute_test) {
+	std::mt19937_64 gen(7);
+	std::uniform_real_distribution<double> dist(1.0, 100.0);
+	vector<double> prices(2'000);
+	for (double& p : prices) {
+		p = dist(gen);
+	}
+	vector<uint16_t> periods;
+	for (uint16_t p = 2; p < 39; p++) {
+		periods.push_back(p);
+	}
+
+	vector<double> periodMajor;
+	vector<double> timeMajor;
+	ASSERT_EQ(GeneralizedDoubleExponentialMovingAverage::sweep(prices, 0.7, periods, periodMajor), status::ok);
+	ASSERT_EQ(GeneralizedDoubleExponentialMovingAverage::sweep(prices, 0.7, periods, timeMajor, sweepLayout::timeMajor), status::ok);
+	ASSERT_EQ(periodMajor.size(), periods.size() * prices.size());
+
+	for (size_t k = 0; k < periods.size(); k++) {
+		vector<double> expected;
+		ASSERT_EQ(GeneralizedDoubleExponentialMovingAverage(0.7, periods[k]).compute(prices, expected), status::ok);
+
+		for (size_t t = 0; t < prices.size(); t++) {
+			EXPECT_NEAR(periodMajor[k * prices.size() + t], expected[t], 1e-9) << "period " << periods[k] << " differs at index " << t;
+			EXPECT_NEAR(timeMajor[t * periods.size() + k], expected[t], 1e-9) << "period " << periods[k] << " differs at index " << t;
+		}
+	}
+}
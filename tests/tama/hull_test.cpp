@@ -2,6 +2,7 @@
 #include <tama/tama.hpp>
 #include <vector>
 #include <stdexcept>
+#include <random>
 
 using std::vector;
 
@@ -98,3 +99,50 @@ TEST(TamaTest, HullRejectsInvalidParams_test) {
 
     EXPECT_THROW(tama::HullMovingAverage(0), std::invalid_argument);
 }
+
+TEST(TamaTest, HullFusedComputeMatchesSeparateWmaPasses_test) {
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> dist(1.0, 100.0);
+    vector<double> prices(500);
+    for (double& price : prices) {
+        price = dist(gen);
+    }
+
+    for (uint16_t period : {1, 2, 3, 4, 9, 16, 50, 200}) {
+        const uint16_t p1 = std::max<uint16_t>(1, period / 2);
+        const uint16_t p2 = std::max<uint16_t>(1, static_cast<uint16_t>(std::lround(std::sqrt(static_cast<double>(period)))));
+        tama::WeightedMovingAverage w1(p1);
+        tama::WeightedMovingAverage w2(period);
+        tama::WeightedMovingAverage w3(p2);
+        vector<double> w1Out(prices.size());
+        vector<double> w2Out(prices.size());
+        vector<double> expected(prices.size());
+        ASSERT_EQ(w1.compute(prices, w1Out), status::ok);
+        ASSERT_EQ(w2.compute(prices, w2Out), status::ok);
+        for (size_t i = 0; i < prices.size(); ++i) {
+            w1Out[i] = 2.0 * w1Out[i] - w2Out[i];
+        }
+        ASSERT_EQ(w3.compute(w1Out, expected), status::ok);
+
+        tama::HullMovingAverage hma(period);
+        vector<double> hullOut;
+        ASSERT_EQ(hma.compute(prices, hullOut), status::ok);
+        for (size_t i = p2 - 1; i < prices.size(); ++i) {
+            EXPECT_EQ(hullOut[i], expected[i]) << "period " << period << " differs at index " << i;
+        }
+
+        const HullMovingAverageState state = hma.getState();
+        EXPECT_EQ(state.w1.priceBuf, w1.getState().priceBuf);
+        EXPECT_EQ(state.w2.priceBuf, w2.getState().priceBuf);
+        EXPECT_EQ(state.w3.priceBuf, w3.getState().priceBuf);
+        EXPECT_EQ(state.w3.rollingWeightedSum, w3.getState().rollingWeightedSum);
+        EXPECT_EQ(hma.update(17.0), w3.update(2.0 * w1.update(17.0) - w2.update(17.0)));
+    }
+}
+
+TEST(TamaTest, HullRejectsPeriodLongerThanInput_test) {
+    const vector<double> prices{10, 11, 12};
+    vector<double> hullOut;
+
+    EXPECT_EQ(tama::HullMovingAverage(4).compute(prices, hullOut), status::invalidParam);
+}
@@ -61,3 +61,33 @@ TEST(TamaTest, MdComputeThenUpdateMatchesKnownValues_test) {
         EXPECT_NEAR(mixedOut[i], expected[i], 1e-2) << "Vectors differ at index " << i;
     }
 }
+
+TEST(TamaTest, MdFastArithmeticStaysWithinTolerance_test) {
+    // A long random-walk-like series, so rounding differences get a chance to build up.
+    vector<double> prices(200000);
+    double price = 100.0;
+    for (size_t i = 0; i < prices.size(); i++) {
+        price *= 1.0 + (static_cast<double>((i * 7919) % 41) - 20.0) * 0.0005;
+        prices[i] = price;
+    }
+
+    for (uint16_t period : {2, 10, 200, 5000}) {
+        vector<double> exact;
+        vector<double> fast;
+        McGinleyDynamicMovingAverage mdExact(period);
+        McGinleyDynamicMovingAverage mdFast(period, 0.0, mdArithmetic::fast);
+        ASSERT_EQ(mdExact.compute(prices, exact), status::ok);
+        ASSERT_EQ(mdFast.compute(prices, fast), status::ok);
+
+        for (size_t i = 0; i < prices.size(); i++) {
+            ASSERT_NEAR(fast[i], exact[i], 1e-12 * exact[i]) << "period " << period << ", index " << i;
+        }
+
+        // Every entry point follows the arithmetic, and a snapshot keeps it.
+        McGinleyDynamicMovingAverage restored(mdFast.getState());
+        EXPECT_EQ(restored.getState().arithmetic, mdArithmetic::fast);
+        const double peeked = mdFast.peek(97.0);
+        EXPECT_EQ(restored.update(97.0), peeked);
+        EXPECT_NEAR(mdFast.update(97.0), mdExact.update(97.0), 1e-12 * peeked);
+    }
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <tama/tama.hpp>
+#include <vector>
+
+using std::vector;
+
+using namespace tama;
+
+namespace {
+    // pathCount random-walk-like series of `steps` samples, path-major.
+    vector<double> simulate(size_t pathCount, size_t steps) {
+        vector<double> values(pathCount * steps);
+        for (size_t p = 0; p < pathCount; p++) {
+            double price = 100.0 + static_cast<double>(p % 9);
+            for (size_t t = 0; t < steps; t++) {
+                price += static_cast<double>(((p + 3) * (t + 7) * 31) % 19) * 0.1 - 0.9;
+                values[p * steps + t] = price;
+            }
+        }
+        return values;
+    }
+
+    vector<double> transpose(const vector<double>& matrix, size_t rows) {
+        const size_t cols = matrix.size() / rows;
+        vector<double> out(matrix.size());
+        for (size_t r = 0; r < rows; r++) {
+            for (size_t c = 0; c < cols; c++) {
+                out[c * rows + r] = matrix[r * cols + c];
+            }
+        }
+        return out;
+    }
+
+    void expectSame(const vector<double>& actual, const vector<double>& expected, double tolerance) {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < actual.size(); i++) {
+            if (tolerance == 0.0) {
+                EXPECT_EQ(actual[i], expected[i]) << "index " << i;
+            } else {
+                EXPECT_NEAR(actual[i], expected[i], tolerance) << "index " << i;
+            }
+        }
+    }
+
+    // Every path of both layouts must match compute() on a copy of the indicator,
+    // output and end state alike, and the indicator itself must not move. EMA's
+    // a*x + b*y may be contracted into either FMA depending on where compute() is
+    // inlined, so it is held to a tolerance rather than bit equality.
+    template <typename Indicator, typename State>
+    void expectPathsMatchCompute(Indicator indicator, size_t pathCount, size_t steps, computeMode mode, double tolerance = 0.0) {
+        const vector<double> paths = simulate(pathCount, steps);
+        vector<double> out;
+        vector<State> states(pathCount);
+        ASSERT_EQ(indicator.computePaths(paths, pathCount, out, pathLayout::pathMajor, mode, states), status::ok);
+
+        vector<double> timeMajorOut;
+        ASSERT_EQ(indicator.computePaths(transpose(paths, pathCount), pathCount, timeMajorOut, pathLayout::timeMajor, mode), status::ok);
+        EXPECT_EQ(transpose(timeMajorOut, steps), out);
+
+        for (size_t p = 0; p < pathCount; p++) {
+            Indicator copy(indicator);
+            const std::span<const double> path(paths.data() + p * steps, steps);
+            vector<double> expected(steps);
+            ASSERT_EQ(copy.compute(path, std::span<double>(expected), mode), status::ok);
+            SCOPED_TRACE(p);
+            expectSame(vector<double>(out.begin() + p * steps, out.begin() + (p + 1) * steps), expected, tolerance);
+
+            // The reported end state continues like the copy.
+            Indicator resumed(states[p]);
+            EXPECT_NEAR(resumed.update(101.5), copy.update(101.5), tolerance);
+        }
+    }
+}
+
+TEST(TamaTest, ComputePathsMatchesScalarCompute_test) {
+    for (size_t pathCount : {1, 16, 37, 530}) {
+        expectPathsMatchCompute<ExponentialMovingAverage, ExponentialMovingAverageState>(ExponentialMovingAverage(12), pathCount, 60, computeMode::restart, 1e-12);
+        expectPathsMatchCompute<McGinleyDynamicMovingAverage, McGinleyDynamicMovingAverageState>(McGinleyDynamicMovingAverage(12), pathCount, 60, computeMode::restart);
+        expectPathsMatchCompute<HullMovingAverage, HullMovingAverageState>(HullMovingAverage(16), pathCount, 60, computeMode::restart);
+    }
+}
+
+TEST(TamaTest, ComputePathsResumesFromIndicator_test) {
+    vector<double> out;
+    const vector<double> history = simulate(1, 80);
+
+    ExponentialMovingAverage ema(12);
+    McGinleyDynamicMovingAverage md(12);
+    HullMovingAverage hma(16);
+    ASSERT_EQ(ema.compute(history, out), status::ok);
+    ASSERT_EQ(md.compute(history, out), status::ok);
+    ASSERT_EQ(hma.compute(history, out), status::ok);
+
+    // Paths shorter than the Hull window still read its older samples from the rings.
+    for (size_t steps : {5, 40}) {
+        expectPathsMatchCompute<ExponentialMovingAverage, ExponentialMovingAverageState>(ema, 21, steps, computeMode::resume, 1e-12);
+        expectPathsMatchCompute<McGinleyDynamicMovingAverage, McGinleyDynamicMovingAverageState>(md, 21, steps, computeMode::resume);
+        expectPathsMatchCompute<HullMovingAverage, HullMovingAverageState>(hma, 21, steps, computeMode::resume);
+    }
+}
+
+TEST(TamaTest, ComputePathsRejectsInvalidParams_test) {
+    const vector<double> paths = simulate(4, 20);
+    vector<double> out(paths.size());
+    vector<double> shortOut(paths.size() - 1);
+    vector<ExponentialMovingAverageState> states(3);
+    const ExponentialMovingAverage ema(5);
+    const HullMovingAverage hma(25);
+
+    EXPECT_EQ(ema.computePaths(vector<double>{}, 4, std::span<double>(out)), status::emptyParams);
+    EXPECT_EQ(ema.computePaths(paths, 0, std::span<double>(out)), status::emptyParams);
+    EXPECT_EQ(ema.computePaths(paths, 3, std::span<double>(out)), status::invalidParam);
+    EXPECT_EQ(ema.computePaths(paths, 4, std::span<double>(shortOut)), status::invalidParam);
+    EXPECT_EQ(ema.computePaths(paths, 4, std::span<double>(out), pathLayout::pathMajor, computeMode::restart, states), status::invalidParam);
+
+    // A fresh Hull needs a full window per path.
+    EXPECT_EQ(hma.computePaths(paths, 4, std::span<double>(out)), status::invalidParam);
+    EXPECT_EQ(hma.computePaths(paths, 4, std::span<double>(out), pathLayout::pathMajor, computeMode::resume), status::invalidParam);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <tama/tama.hpp>
+#include <vector>
+#include <stdexcept>
+
+using std::vector;
+
+using namespace tama;
+
+namespace {
+    vector<double> series(size_t n, double base) {
+        vector<double> values(n);
+        for (size_t i = 0; i < n; i++) {
+            values[i] = base + static_cast<double>((i * 41) % 13) - 0.25 * static_cast<double>(i % 7);
+        }
+        return values;
+    }
+
+    // 50 price levels around the last close, as an order ladder would ask.
+    vector<double> ladder() {
+        vector<double> levels(50);
+        for (size_t i = 0; i < levels.size(); i++) {
+            levels[i] = 95.0 + 0.2 * static_cast<double>(i);
+        }
+        return levels;
+    }
+
+    // Every candidate must match update() on a copy bit for bit, and the indicator
+    // must be left exactly as it was. tama exports -ffp-contract=off, so this holds
+    // when update() is inlined into the test as well.
+    template <typename Indicator>
+    void expectPeekMatchesUpdate(Indicator indicator) {
+        vector<double> out;
+        ASSERT_EQ(indicator.compute(series(80, 100.0), out), status::ok);
+
+        const vector<double> levels = ladder();
+        vector<double> peeked(levels.size());
+        ASSERT_EQ(indicator.peek(levels, std::span<double>(peeked)), status::ok);
+
+        const double before = indicator.latest();
+        for (size_t i = 0; i < levels.size(); i++) {
+            Indicator copy(indicator);
+            const double expected = copy.update(levels[i]);
+            EXPECT_EQ(indicator.peek(levels[i]), expected) << "level " << i;
+            EXPECT_EQ(peeked[i], expected) << "level " << i;
+        }
+        EXPECT_EQ(indicator.latest(), before);
+
+        Indicator untouched(indicator);
+        EXPECT_EQ(indicator.update(101.0), untouched.update(101.0));
+    }
+}
+
+TEST(TamaTest, PeekMatchesUpdateOnCopy_test) {
+    expectPeekMatchesUpdate(ExponentialMovingAverage(12));
+    expectPeekMatchesUpdate(SimpleMovingAverage(12));
+    expectPeekMatchesUpdate(WeightedMovingAverage(12));
+    expectPeekMatchesUpdate(HullMovingAverage(12));
+    expectPeekMatchesUpdate(DoubleExponentialMovingAverage(12));
+    expectPeekMatchesUpdate(TripleExponentialMovingAverage(12));
+    expectPeekMatchesUpdate(McGinleyDynamicMovingAverage(12));
+    expectPeekMatchesUpdate(GeneralizedDoubleExponentialMovingAverage(0.7, 12));
+}
+
+TEST(TamaTest, PeekVolumeAndOhlcVariants_test) {
+    const vector<double> prices = series(80, 100.0);
+    const vector<double> volumes = series(80, 1000.0);
+    vector<double> lows(prices);
+    vector<double> highs(prices);
+    for (size_t i = 0; i < prices.size(); i++) {
+        lows[i] -= 1.0 + static_cast<double>(i % 3);
+        highs[i] += 1.0 + static_cast<double>(i % 2);
+    }
+    vector<double> out;
+    const vector<double> levels = ladder();
+    const vector<double> levelVolumes = series(levels.size(), 900.0);
+    vector<double> peeked(levels.size());
+
+    VolumeWeightedMovingAverage vwma(12);
+    ASSERT_EQ(vwma.compute(prices, volumes, out), status::ok);
+    ASSERT_EQ(vwma.peek(levels, levelVolumes, std::span<double>(peeked)), status::ok);
+    for (size_t i = 0; i < levels.size(); i++) {
+        VolumeWeightedMovingAverage copy(vwma);
+        const double expected = copy.update(levels[i], levelVolumes[i]);
+        EXPECT_EQ(vwma.peek(levels[i], levelVolumes[i]), expected);
+        EXPECT_EQ(peeked[i], expected);
+    }
+    EXPECT_EQ(vwma.peek(levels, vector<double>{1.0}, std::span<double>(peeked)), status::invalidParam);
+
+    FractalAdaptiveMovingAverage frama(12);
+    ASSERT_EQ(frama.compute(prices, lows, highs, out), status::ok);
+    ASSERT_EQ(frama.peek(levels, std::span<double>(peeked)), status::ok);
+    for (size_t i = 0; i < levels.size(); i++) {
+        // The bar's own high and low do not reach its value.
+        FractalAdaptiveMovingAverage copy(frama);
+        const double expected = copy.update(levels[i], levels[i] - 5.0, levels[i] + 5.0);
+        EXPECT_EQ(frama.peek(levels[i]), expected);
+        EXPECT_EQ(peeked[i], expected);
+    }
+}
+
+TEST(TamaTest, PeekRejectsInvalidParams_test) {
+    const vector<double> levels = ladder();
+    vector<double> shortOut(levels.size() - 1);
+
+    SimpleMovingAverage sma(5);
+    EXPECT_THROW(sma.peek(100.0), std::runtime_error);
+    vector<double> out(levels.size());
+    EXPECT_THROW(sma.peek(levels, std::span<double>(out)), std::runtime_error);
+
+    ASSERT_EQ(sma.compute(series(20, 100.0), out), status::ok);
+    EXPECT_EQ(sma.peek(vector<double>{}, std::span<double>(shortOut)), status::emptyParams);
+    EXPECT_EQ(sma.peek(levels, std::span<double>(shortOut)), status::invalidParam);
+}
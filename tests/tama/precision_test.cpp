@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <tama/tama.hpp>
+#include <vector>
+#include <random>
+#include <stdexcept>
+
+using std::vector;
+
+using namespace tama;
+
+namespace {
+    struct Series {
+        vector<double> prices;
+        vector<double> volume;
+        vector<float> pricesF;
+        vector<float> volumeF;
+    };
+
+    // Float-representable inputs, so deviations come from storage and accumulation only.
+    Series make_series(size_t n) {
+        std::mt19937 gen(7);
+        std::uniform_real_distribution<float> price(90.0f, 110.0f);
+        std::uniform_real_distribution<float> volume(1.0f, 1000.0f);
+        Series s;
+        for (size_t i = 0; i < n; i++) {
+            s.pricesF.push_back(price(gen));
+            s.volumeF.push_back(volume(gen));
+            s.prices.push_back(s.pricesF.back());
+            s.volume.push_back(s.volumeF.back());
+        }
+        return s;
+    }
+
+    template <typename T>
+    double max_relative_deviation(const vector<T>& got, const vector<double>& expected, size_t from) {
+        double worst = 0.0;
+        for (size_t i = from; i < expected.size(); i++) {
+            worst = std::max(worst, std::abs(static_cast<double>(got[i]) - expected[i]) / std::abs(expected[i]));
+        }
+        return worst;
+    }
+}
+
+TEST(TamaTest, MixedPrecisionMatchesDoubleWithinFloatRounding_test) {
+    const Series s = make_series(20000);
+    const uint16_t period = 20;
+
+    vector<double> expected;
+    vector<float> got;
+
+    ASSERT_EQ(SimpleMovingAverage(period).compute(s.prices, expected), status::ok);
+    ASSERT_EQ(BasicSimpleMovingAverage<float>(period).compute(s.pricesF, got), status::ok);
+    EXPECT_LT(max_relative_deviation(got, expected, period - 1), 1e-6);
+
+    ASSERT_EQ(ExponentialMovingAverage(period).compute(s.prices, expected), status::ok);
+    ASSERT_EQ(BasicExponentialMovingAverage<float>(period).compute(s.pricesF, got), status::ok);
+    EXPECT_LT(max_relative_deviation(got, expected, 0), 1e-6);
+
+    ASSERT_EQ(WeightedMovingAverage(period).compute(s.prices, expected), status::ok);
+    ASSERT_EQ(BasicWeightedMovingAverage<float>(period).compute(s.pricesF, got), status::ok);
+    EXPECT_LT(max_relative_deviation(got, expected, period - 1), 1e-6);
+
+    ASSERT_EQ(VolumeWeightedMovingAverage(period).compute(s.prices, s.volume, expected), status::ok);
+    ASSERT_EQ(BasicVolumeWeightedMovingAverage<float>(period).compute(s.pricesF, s.volumeF, got), status::ok);
+    EXPECT_LT(max_relative_deviation(got, expected, period - 1), 1e-6);
+}
+
+TEST(TamaTest, SinglePrecisionStaysCloseToDouble_test) {
+    const Series s = make_series(20000);
+    const uint16_t period = 20;
+
+    vector<double> expected;
+    vector<float> got;
+
+    ASSERT_EQ(SimpleMovingAverage(period).compute(s.prices, expected), status::ok);
+    ASSERT_EQ((BasicSimpleMovingAverage<float, float>(period).compute(s.pricesF, got)), status::ok);
+    EXPECT_LT(max_relative_deviation(got, expected, period - 1), 1e-4);
+
+    ASSERT_EQ(ExponentialMovingAverage(period).compute(s.prices, expected), status::ok);
+    ASSERT_EQ((BasicExponentialMovingAverage<float, float>(period).compute(s.pricesF, got)), status::ok);
+    EXPECT_LT(max_relative_deviation(got, expected, 0), 1e-5);
+}
+
+TEST(TamaTest, MixedPrecisionComputeThenUpdateMatchesDouble_test) {
+    const Series s = make_series(200);
+    const size_t split = 150;
+    const uint16_t period = 10;
+
+    SimpleMovingAverage sma(period);
+    WeightedMovingAverage wma(period);
+    VolumeWeightedMovingAverage vwma(period);
+    ExponentialMovingAverage ema(period);
+    BasicSimpleMovingAverage<float> smaF(period);
+    BasicWeightedMovingAverage<float> wmaF(period);
+    BasicVolumeWeightedMovingAverage<float> vwmaF(period);
+    BasicExponentialMovingAverage<float> emaF(period);
+
+    vector<double> out;
+    vector<float> outF;
+    const std::span<const double> head(s.prices.data(), split);
+    const std::span<const double> headVolume(s.volume.data(), split);
+    const std::span<const float> headF(s.pricesF.data(), split);
+    const std::span<const float> headVolumeF(s.volumeF.data(), split);
+    ASSERT_EQ(sma.compute(head, out), status::ok);
+    ASSERT_EQ(wma.compute(head, out), status::ok);
+    ASSERT_EQ(vwma.compute(head, headVolume, out), status::ok);
+    ASSERT_EQ(ema.compute(head, out), status::ok);
+    ASSERT_EQ(smaF.compute(headF, outF), status::ok);
+    ASSERT_EQ(wmaF.compute(headF, outF), status::ok);
+    ASSERT_EQ(vwmaF.compute(headF, headVolumeF, outF), status::ok);
+    ASSERT_EQ(emaF.compute(headF, outF), status::ok);
+
+    for (size_t i = split; i < s.prices.size(); i++) {
+        EXPECT_NEAR(smaF.update(s.pricesF[i]), sma.update(s.prices[i]), 1e-4);
+        EXPECT_NEAR(wmaF.update(s.pricesF[i]), wma.update(s.prices[i]), 1e-4);
+        EXPECT_NEAR(vwmaF.update(s.pricesF[i], s.volumeF[i]), vwma.update(s.prices[i], s.volume[i]), 1e-4);
+        EXPECT_NEAR(emaF.update(s.pricesF[i]), ema.update(s.prices[i]), 1e-4);
+    }
+
+    BasicSimpleMovingAverage<float> warm(period, vector<float>(s.pricesF.end() - period, s.pricesF.end()));
+    EXPECT_NEAR(warm.latest(), smaF.latest(), 1e-4);
+}
+
+TEST(TamaTest, ReducedPrecisionRejectsInvalidParams_test) {
+    vector<float> out;
+    const vector<float> empty{};
+    const vector<float> shortSeries{1.0f, 2.0f};
+
+    EXPECT_THROW(BasicSimpleMovingAverage<float>(0), std::invalid_argument);
+    EXPECT_THROW(BasicExponentialMovingAverage<float>(0), std::invalid_argument);
+    EXPECT_THROW(BasicWeightedMovingAverage<float>(3, {1.0f}), std::invalid_argument);
+    EXPECT_EQ(BasicSimpleMovingAverage<float>(3).compute(empty, out), status::emptyParams);
+    EXPECT_EQ(BasicWeightedMovingAverage<float>(3).compute(shortSeries, out), status::invalidParam);
+    EXPECT_THROW(BasicVolumeWeightedMovingAverage<float>(3).update(1.0f, 1.0f), std::runtime_error);
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <tama/tama.hpp>
+#include <cmath>
 #include <vector>
+#include <random>
 
 using std::vector;
 using namespace tama;
@@ -83,4 +85,75 @@ TEST(TamaTest, SmaConstructorUsesPreviousWindowForUpdate_test) {
     const double resumedUpdated = resumed.update(newPrice);
 
     EXPECT_NEAR(resumedUpdated, baselineUpdated, 1e-12);
-}
\ No newline at end of file
+}
+TEST(TamaTest, SmaSweepMatchesCompute_test) {
+    std::mt19937_64 gen(7);
+    std::uniform_real_distribution<double> dist(1.0, 100.0);
+    vector<double> prices(10'000);
+    for (double& p : prices) {
+        p = dist(gen);
+    }
+    const vector<uint16_t> periods{3, 20, 200, 5};
+
+    vector<double> periodMajor;
+    vector<double> timeMajor;
+    ASSERT_EQ(SimpleMovingAverage::sweep(prices, periods, periodMajor), status::ok);
+    ASSERT_EQ(SimpleMovingAverage::sweep(prices, periods, timeMajor, sweepLayout::timeMajor), status::ok);
+    ASSERT_EQ(periodMajor.size(), periods.size() * prices.size());
+
+    for (size_t k = 0; k < periods.size(); k++) {
+        vector<double> expected;
+        ASSERT_EQ(SimpleMovingAverage(periods[k]).compute(prices, expected), status::ok);
+
+        for (size_t t = 0; t < prices.size(); t++) {
+            EXPECT_NEAR(periodMajor[k * prices.size() + t], expected[t], 1e-9) << "period " << periods[k] << " differs at index " << t;
+            EXPECT_NEAR(timeMajor[t * periods.size() + k], expected[t], 1e-9) << "period " << periods[k] << " differs at index " << t;
+        }
+    }
+}
+
+TEST(TamaTest, SmaSweepRejectsInvalidParams_test) {
+    const vector<double> prices{10, 11, 12};
+    const vector<uint16_t> periods{2, 3};
+    const vector<uint16_t> zeroPeriod{0};
+    vector<double> out;
+
+    EXPECT_EQ(SimpleMovingAverage::sweep(prices, periods, out), status::invalidParam);
+    EXPECT_EQ(SimpleMovingAverage::sweep(prices, zeroPeriod, out), status::invalidParam);
+    EXPECT_EQ(SimpleMovingAverage::sweep(prices, {}, out), status::emptyParams);
+}
+
+TEST(TamaTest, SmaComputeBlockedMatchesCompute_test) {
+    // A trending walk: the rolling sums drift further than on a stationary series.
+    std::mt19937_64 gen(5);
+    std::uniform_real_distribution<double> dist(-1.0, 1.05);
+    vector<double> prices(300'007);
+    double price = 100.0;
+    for (double& p : prices) {
+        price += dist(gen);
+        p = price;
+    }
+
+    for (uint16_t period : {1, 5, 50, 500, 20'000}) {
+        tama::SimpleMovingAverage serial(period);
+        tama::SimpleMovingAverage blocked(period);
+        vector<double> expected;
+        vector<double> actual;
+        ASSERT_EQ(serial.compute(prices, expected), status::ok);
+        ASSERT_EQ(blocked.computeBlocked(prices, actual), status::ok);
+
+        ASSERT_EQ(actual.size(), prices.size());
+        for (size_t t = 0; t < prices.size(); t++) {
+            ASSERT_NEAR(actual[t], expected[t], 1e-12 * std::fabs(expected[t])) << "period " << period << " differs at index " << t;
+        }
+
+        // The state continues like compute()'s.
+        EXPECT_EQ(blocked.latest(), actual.back());
+        EXPECT_NEAR(blocked.update(price + 0.5), serial.update(price + 0.5), 1e-12 * std::fabs(price));
+    }
+
+    tama::SimpleMovingAverage tooLong(10);
+    vector<double> out;
+    EXPECT_EQ(tooLong.computeBlocked(vector<double>(5, 1.0), out), status::invalidParam);
+    EXPECT_EQ(tooLong.computeBlocked(vector<double>{}, out), status::emptyParams);
+}
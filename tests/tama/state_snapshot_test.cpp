@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <tama/tama.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include <stdexcept>
+
+using std::vector;
+
+using namespace tama;
+
+namespace {
+    const vector<double> prices{11, 12, 14, 18, 12, 15, 13, 16, 10, 11, 17, 19, 14, 12, 13};
+    const vector<double> volumes{100, 120, 90, 150, 110, 130, 95, 140, 105, 115, 125, 135, 90, 100, 110};
+    const vector<double> lows{10, 11, 12, 16, 11, 13, 12, 14, 9, 10, 15, 17, 13, 11, 12};
+    const vector<double> highs{12, 13, 15, 19, 13, 16, 14, 17, 11, 12, 18, 20, 15, 13, 14};
+
+    vector<double> toVector(const helpers::RingView<double>& view) {
+        vector<double> values;
+        view.assignTo(values);
+        return values;
+    }
+
+    template <typename Indicator>
+    vector<std::byte> packed(const Indicator& indicator) {
+        vector<std::byte> bytes(indicator.packedSize());
+        EXPECT_EQ(indicator.pack(bytes), status::ok);
+        return bytes;
+    }
+}
+
+static_assert(std::is_trivially_copyable_v<SimpleMovingAverageSnapshot>);
+static_assert(std::is_trivially_copyable_v<WeightedMovingAverageSnapshot>);
+static_assert(std::is_trivially_copyable_v<VolumeWeightedMovingAverageSnapshot>);
+static_assert(std::is_trivially_copyable_v<HullMovingAverageSnapshot>);
+static_assert(std::is_trivially_copyable_v<FractalAdaptiveMovingAverageSnapshot>);
+
+TEST(TamaTest, GetStateIntoReusesCapacity_test) {
+    SimpleMovingAverage sma(5);
+    vector<double> out;
+    ASSERT_EQ(sma.compute(prices, out), status::ok);
+
+    SimpleMovingAverageState state;
+    sma.getState(state);
+    const double* storage = state.priceBuf.data();
+    EXPECT_EQ(state.priceBuf, sma.getState().priceBuf);
+
+    // The window wraps after a few updates; the same storage is refilled.
+    for (double price : {20.0, 21.0, 22.0}) {
+        sma.update(price);
+    }
+    sma.getState(state);
+    EXPECT_EQ(state.priceBuf.data(), storage);
+    EXPECT_EQ(state.priceBuf, sma.getState().priceBuf);
+    EXPECT_EQ(state.lastSma, sma.latest());
+
+    HullMovingAverage hma(6);
+    ASSERT_EQ(hma.compute(prices, out), status::ok);
+    HullMovingAverageState hullState;
+    hma.getState(hullState);
+    const HullMovingAverageState expected = hma.getState();
+    EXPECT_EQ(hullState.w1.priceBuf, expected.w1.priceBuf);
+    EXPECT_EQ(hullState.w2.priceBuf, expected.w2.priceBuf);
+    EXPECT_EQ(hullState.w3.priceBuf, expected.w3.priceBuf);
+    EXPECT_EQ(hullState.p2, expected.p2);
+}
+
+TEST(TamaTest, StateViewMatchesOwningState_test) {
+    vector<double> out;
+    VolumeWeightedMovingAverage vwma(4);
+    ASSERT_EQ(vwma.compute(prices, volumes, out), status::ok);
+    vwma.update(18.0, 160.0);
+
+    const VolumeWeightedMovingAverageStateView view = vwma.view();
+    const VolumeWeightedMovingAverageState state = vwma.getState();
+    EXPECT_EQ(toVector(view.priceBuf), state.priceBuf);
+    EXPECT_EQ(toVector(view.volumeBuf), state.volumeBuf);
+    EXPECT_EQ(view.priceBuf.size(), 4u);
+    EXPECT_EQ(view.priceBuf[3], 18.0);
+    EXPECT_EQ(view.lastCalculation, state.lastCalculation);
+
+    FractalAdaptiveMovingAverage frama(6);
+    ASSERT_EQ(frama.compute(prices, lows, highs, out), status::ok);
+    const FractalAdaptiveMovingAverageStateView framaView = frama.view();
+    const FractalAdaptiveMovingAverageState framaState = frama.getState();
+    EXPECT_EQ(toVector(framaView.highBuf1), framaState.highBuf1);
+    EXPECT_EQ(toVector(framaView.lowBuf2), framaState.lowBuf2);
+    EXPECT_EQ(framaView.highBuf2Max, framaState.highBuf2Max);
+}
+
+TEST(TamaTest, PackedSnapshotRoundTrip_test) {
+    vector<double> out;
+    SimpleMovingAverage sma(5);
+    WeightedMovingAverage wma(5);
+    VolumeWeightedMovingAverage vwma(5);
+    HullMovingAverage hma(9);
+    FractalAdaptiveMovingAverage frama(6);
+    ASSERT_EQ(sma.compute(prices, out), status::ok);
+    ASSERT_EQ(wma.compute(prices, out), status::ok);
+    ASSERT_EQ(vwma.compute(prices, volumes, out), status::ok);
+    ASSERT_EQ(hma.compute(prices, out), status::ok);
+    ASSERT_EQ(frama.compute(prices, lows, highs, out), status::ok);
+
+    SimpleMovingAverage smaRestored(packed(sma));
+    WeightedMovingAverage wmaRestored(packed(wma));
+    VolumeWeightedMovingAverage vwmaRestored(packed(vwma));
+    HullMovingAverage hmaRestored(packed(hma));
+    FractalAdaptiveMovingAverage framaRestored(packed(frama));
+
+    for (size_t i = 0; i < 4; i++) {
+        const double price = 15.0 + static_cast<double>(i);
+        EXPECT_EQ(smaRestored.update(price), sma.update(price));
+        EXPECT_EQ(wmaRestored.update(price), wma.update(price));
+        EXPECT_EQ(vwmaRestored.update(price, 100.0), vwma.update(price, 100.0));
+        EXPECT_EQ(hmaRestored.update(price), hma.update(price));
+        EXPECT_EQ(framaRestored.update(price, price - 1.0, price + 1.0), frama.update(price, price - 1.0, price + 1.0));
+    }
+}
+
+TEST(TamaTest, PackedSnapshotRejectsShortBuffers_test) {
+    vector<double> out;
+    SimpleMovingAverage sma(5);
+    ASSERT_EQ(sma.compute(prices, out), status::ok);
+
+    EXPECT_EQ(sma.packedSize(), sizeof(SimpleMovingAverageSnapshot) + 5 * sizeof(double));
+    vector<std::byte> bytes(sma.packedSize() - 1);
+    EXPECT_EQ(sma.pack(bytes), status::invalidParam);
+
+    const vector<std::byte> full = packed(sma);
+    const std::span<const std::byte> truncated(full.data(), full.size() - sizeof(double));
+    EXPECT_THROW(SimpleMovingAverage{truncated}, std::invalid_argument);
+    EXPECT_THROW(SimpleMovingAverage{std::span<const std::byte>()}, std::invalid_argument);
+
+    // An uninitialized indicator packs an empty window.
+    SimpleMovingAverage fresh(5);
+    EXPECT_EQ(fresh.packedSize(), sizeof(SimpleMovingAverageSnapshot));
+    SimpleMovingAverage freshRestored(packed(fresh));
+    EXPECT_THROW(freshRestored.update(1.0), std::runtime_error);
+}
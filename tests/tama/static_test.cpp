@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <tama/tama.hpp>
+#include <cmath>
+#include <vector>
+#include <stdexcept>
+
+using std::vector;
+
+using namespace tama;
+
+namespace {
+    vector<double> series(size_t n) {
+        vector<double> prices(n);
+        for (size_t i = 0; i < n; i++) {
+            prices[i] = 100.0 + 7.0 * std::sin(0.37 * static_cast<double>(i)) + 0.01 * static_cast<double>(i % 13);
+        }
+        return prices;
+    }
+
+    const vector<double> ticks{101.5, 99.25, 104.0, 97.75, 100.125, 102.5};
+
+    // Header-inline code is compiled with the caller's flags, so FMA contraction
+    // may round differently from the library build; compare to rounding.
+    constexpr double tolerance = 1e-9;
+
+    template <uint16_t N, typename Static, typename Dynamic>
+    void expectSameSeries() {
+        const vector<double> prices = series(64);
+        vector<double> expected;
+        vector<double> actual;
+        Dynamic dynamic(N);
+        Static fixed;
+
+        ASSERT_EQ(dynamic.compute(prices, expected), status::ok);
+        ASSERT_EQ(fixed.compute(prices, actual), status::ok);
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t t = 0; t < expected.size(); t++) {
+            EXPECT_NEAR(actual[t], expected[t], tolerance) << "period " << N << " differs at index " << t;
+        }
+
+        for (double tick : ticks) {
+            EXPECT_NEAR(fixed.update(tick), dynamic.update(tick), tolerance) << "period " << N;
+        }
+        EXPECT_NEAR(fixed.latest(), dynamic.latest(), tolerance);
+    }
+}
+
+TEST(TamaTest, StaticSmaMatchesDynamic_test) {
+    expectSameSeries<1, StaticSMA<1>, SimpleMovingAverage>();
+    expectSameSeries<5, StaticSMA<5>, SimpleMovingAverage>();
+    expectSameSeries<20, StaticSMA<20>, SimpleMovingAverage>();
+}
+
+TEST(TamaTest, StaticWmaMatchesDynamic_test) {
+    expectSameSeries<1, StaticWMA<1>, WeightedMovingAverage>();
+    expectSameSeries<7, StaticWMA<7>, WeightedMovingAverage>();
+    expectSameSeries<30, StaticWMA<30>, WeightedMovingAverage>();
+}
+
+TEST(TamaTest, StaticHmaMatchesDynamic_test) {
+    expectSameSeries<2, StaticHMA<2>, HullMovingAverage>();
+    expectSameSeries<9, StaticHMA<9>, HullMovingAverage>();
+    expectSameSeries<21, StaticHMA<21>, HullMovingAverage>();
+}
+
+TEST(TamaTest, StaticIndicatorsOverwriteReusedOutput_test) {
+    const vector<double> prices = series(40);
+    vector<double> expected;
+    ASSERT_EQ(HullMovingAverage(16).compute(prices, expected), status::ok);
+
+    // A longer buffer left over from earlier work: warm-up samples read as zero
+    // and the tail past the input is left alone, as with HullMovingAverage.
+    vector<double> reused(prices.size() + 2, 99.0);
+    StaticHMA<16> hma;
+    ASSERT_EQ(hma.compute(prices, reused), status::ok);
+    ASSERT_EQ(reused.size(), prices.size() + 2);
+    for (size_t t = 0; t < prices.size(); t++) {
+        EXPECT_NEAR(reused[t], expected[t], tolerance) << "differs at index " << t;
+    }
+    EXPECT_EQ(reused.back(), 99.0);
+
+    vector<double> wmaOut(prices.size(), 99.0);
+    StaticWMA<12> wma;
+    ASSERT_EQ(wma.compute(prices, wmaOut), status::ok);
+    for (size_t t = 0; t + 1 < 12; t++) {
+        EXPECT_EQ(wmaOut[t], 0.0) << "index " << t;
+    }
+}
+
+TEST(TamaTest, StaticIndicatorsShareDynamicState_test) {
+    const vector<double> prices = series(40);
+    vector<double> out;
+
+    SimpleMovingAverage sma(10);
+    WeightedMovingAverage wma(10);
+    HullMovingAverage hma(10);
+    ASSERT_EQ(sma.compute(prices, out), status::ok);
+    ASSERT_EQ(wma.compute(prices, out), status::ok);
+    ASSERT_EQ(hma.compute(prices, out), status::ok);
+
+    // Dynamic state -> static indicator.
+    StaticSMA<10> fixedSma(sma.getState());
+    StaticWMA<10> fixedWma(wma.getState());
+    StaticHMA<10> fixedHma(hma.getState());
+    EXPECT_NEAR(fixedSma.update(ticks[0]), sma.update(ticks[0]), tolerance);
+    EXPECT_NEAR(fixedWma.update(ticks[0]), wma.update(ticks[0]), tolerance);
+    EXPECT_NEAR(fixedHma.update(ticks[0]), hma.update(ticks[0]), tolerance);
+
+    // Static state -> dynamic indicator.
+    SimpleMovingAverage smaResumed(fixedSma.getState());
+    WeightedMovingAverage wmaResumed(fixedWma.getState());
+    HullMovingAverage hmaResumed(fixedHma.getState());
+    EXPECT_NEAR(smaResumed.update(ticks[1]), fixedSma.update(ticks[1]), tolerance);
+    EXPECT_NEAR(wmaResumed.update(ticks[1]), fixedWma.update(ticks[1]), tolerance);
+    EXPECT_NEAR(hmaResumed.update(ticks[1]), fixedHma.update(ticks[1]), tolerance);
+    EXPECT_EQ(smaResumed.getState().priceBuf, fixedSma.getState().priceBuf);
+}
+
+TEST(TamaTest, StaticIndicatorsWarmStartFromBuffer_test) {
+    const vector<double> warm = series(9);
+    StaticSMA<9> fixedSma(warm);
+    StaticWMA<9> fixedWma(warm);
+    StaticHMA<9> fixedHma(warm);
+    SimpleMovingAverage sma(9, warm);
+    WeightedMovingAverage wma(9, warm);
+    HullMovingAverage hma(9, warm);
+
+    EXPECT_NEAR(fixedSma.latest(), sma.latest(), tolerance);
+    EXPECT_NEAR(fixedWma.latest(), wma.latest(), tolerance);
+    EXPECT_NEAR(fixedHma.latest(), hma.latest(), tolerance);
+    for (double tick : ticks) {
+        EXPECT_NEAR(fixedSma.update(tick), sma.update(tick), tolerance);
+        EXPECT_NEAR(fixedWma.update(tick), wma.update(tick), tolerance);
+        EXPECT_NEAR(fixedHma.update(tick), hma.update(tick), tolerance);
+    }
+}
+
+TEST(TamaTest, StaticIndicatorsRejectInvalidInput_test) {
+    StaticSMA<5> sma;
+    StaticWMA<5> wma;
+    StaticHMA<5> hma;
+    vector<double> out;
+    const vector<double> shortPrices{1, 2, 3};
+
+    EXPECT_THROW(sma.update(1.0), std::runtime_error);
+    EXPECT_THROW(wma.update(1.0), std::runtime_error);
+    EXPECT_THROW(hma.update(1.0), std::runtime_error);
+    EXPECT_EQ(sma.compute(shortPrices, out), status::invalidParam);
+    EXPECT_EQ(wma.compute(shortPrices, out), status::invalidParam);
+    EXPECT_EQ(hma.compute({}, out), status::emptyParams);
+    EXPECT_THROW(StaticSMA<5>{shortPrices}, std::invalid_argument);
+
+    SimpleMovingAverage other(6);
+    EXPECT_THROW(StaticSMA<5>(other.getState()), std::invalid_argument);
+    HullMovingAverage otherHma(6);
+    EXPECT_THROW(StaticHMA<5>(otherHma.getState()), std::invalid_argument);
+}
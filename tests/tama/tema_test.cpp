@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <tama/tama.hpp>
 #include <vector>
+#include <random>
 #include <stdexcept>
 
 using std::vector;
@@ -38,3 +39,60 @@ TEST(TamaTest, TemaRejectsInvalidParams_test) {
 
     EXPECT_THROW(TripleExponentialMovingAverage(0), std::invalid_argument);
 }
+
+TEST(TamaTest, TemaSweepMatchesCompute_test) {
+    std::mt19937_64 gen(7);
+    std::uniform_real_distribution<double> dist(1.0, 100.0);
+    vector<double> prices(2'000);
+    for (double& p : prices) {
+        p = dist(gen);
+    }
+    vector<uint16_t> periods;
+    for (uint16_t p = 2; p < 39; p++) {
+        periods.push_back(p);
+    }
+
+    vector<double> periodMajor;
+    vector<double> timeMajor;
+    ASSERT_EQ(TripleExponentialMovingAverage::sweep(prices, periods, periodMajor), status::ok);
+    ASSERT_EQ(TripleExponentialMovingAverage::sweep(prices, periods, timeMajor, sweepLayout::timeMajor), status::ok);
+    ASSERT_EQ(periodMajor.size(), periods.size() * prices.size());
+
+    for (size_t k = 0; k < periods.size(); k++) {
+        vector<double> expected;
+        ASSERT_EQ(TripleExponentialMovingAverage(periods[k]).compute(prices, expected), status::ok);
+
+        for (size_t t = 0; t < prices.size(); t++) {
+            EXPECT_NEAR(periodMajor[k * prices.size() + t], expected[t], 1e-9) << "period " << periods[k] << " differs at index " << t;
+            EXPECT_NEAR(timeMajor[t * periods.size() + k], expected[t], 1e-9) << "period " << periods[k] << " differs at index " << t;
+        }
+    }
+}
+
+TEST(TamaTest, TemaComputeLeavesCascadedEmaState_test) {
+    const vector<double> prices{10, 12, 11, 13, 12, 14, 15, 13, 14, 16};
+    vector<double> temaOut;
+    vector<double> ema1Out;
+    vector<double> ema2Out;
+    vector<double> ema3Out;
+
+    TripleExponentialMovingAverage tema(4);
+    ASSERT_EQ(tema.compute(prices, temaOut), status::ok);
+
+    tama::ExponentialMovingAverage ema1(4);
+    tama::ExponentialMovingAverage ema2(4);
+    tama::ExponentialMovingAverage ema3(4);
+    ASSERT_EQ(ema1.compute(prices, ema1Out), status::ok);
+    ASSERT_EQ(ema2.compute(ema1Out, ema2Out), status::ok);
+    ASSERT_EQ(ema3.compute(ema2Out, ema3Out), status::ok);
+
+    const TripleExponentialMovingAverageState state = tema.getState();
+    EXPECT_TRUE(state.initialized);
+    EXPECT_NEAR(state.ema1.lastEma, ema1.latest(), 1e-12);
+    EXPECT_NEAR(state.ema2.lastEma, ema2.latest(), 1e-12);
+    EXPECT_NEAR(state.ema3.lastEma, ema3.latest(), 1e-12);
+
+    for (size_t i = 0; i < prices.size(); i++) {
+        EXPECT_NEAR(temaOut[i], 3.0 * ema1Out[i] - 3.0 * ema2Out[i] + ema3Out[i], 1e-12) << "Vectors differ at index " << i;
+    }
+}
@@ -2,6 +2,7 @@
 #include <tama/tama.hpp>
 #include <stdexcept>
 #include <vector>
+#include <random>
 
 using std::vector;
 
@@ -104,3 +105,67 @@ TEST(TamaTest, VwmaConstructorUsesPreviousWindowForUpdate_test) {
 
     EXPECT_NEAR(resumedUpdated, baselineUpdated, 1e-12);
 }
+
+TEST(TamaTest, VwmaSweepMatchesCompute_test) {
+    std::mt19937_64 gen(7);
+    std::uniform_real_distribution<double> priceDist(1.0, 100.0);
+    std::uniform_real_distribution<double> volumeDist(1.0, 1'000.0);
+    vector<double> prices(10'000);
+    vector<double> volume(10'000);
+    for (size_t i = 0; i < prices.size(); i++) {
+        prices[i] = priceDist(gen);
+        volume[i] = volumeDist(gen);
+    }
+    const vector<uint16_t> periods{3, 20, 200, 5};
+
+    vector<double> periodMajor;
+    vector<double> timeMajor;
+    ASSERT_EQ(tama::VolumeWeightedMovingAverage::sweep(prices, volume, periods, periodMajor), status::ok);
+    ASSERT_EQ(tama::VolumeWeightedMovingAverage::sweep(prices, volume, periods, timeMajor, sweepLayout::timeMajor), status::ok);
+
+    for (size_t k = 0; k < periods.size(); k++) {
+        vector<double> expected;
+        ASSERT_EQ(tama::VolumeWeightedMovingAverage(periods[k]).compute(prices, volume, expected), status::ok);
+
+        for (size_t t = periods[k] - 1; t < prices.size(); t++) {
+            EXPECT_NEAR(periodMajor[k * prices.size() + t], expected[t], 1e-9) << "period " << periods[k] << " differs at index " << t;
+            EXPECT_NEAR(timeMajor[t * periods.size() + k], expected[t], 1e-9) << "period " << periods[k] << " differs at index " << t;
+        }
+    }
+
+    const vector<double> shortVolume{1.0};
+    EXPECT_EQ(tama::VolumeWeightedMovingAverage::sweep(prices, shortVolume, periods, periodMajor), status::invalidParam);
+}
+
+TEST(TamaTest, VwmaComputeMatchesWindowSumsAcrossBlocks_test) {
+    std::mt19937_64 gen(11);
+    std::uniform_real_distribution<double> priceDist(50.0, 150.0);
+    std::uniform_real_distribution<double> volumeDist(10.0, 5'000.0);
+    vector<double> prices(2'000);
+    vector<double> volume(2'000);
+    for (size_t i = 0; i < prices.size(); i++) {
+        prices[i] = priceDist(gen);
+        volume[i] = volumeDist(gen);
+    }
+
+    // Periods shorter and longer than a block, with a resume that evicts a
+    // full ring of 300 samples before reaching its own inputs.
+    for (size_t period : {1, 7, 255, 256, 300}) {
+        const size_t split = 700;
+        tama::VolumeWeightedMovingAverage vwma(static_cast<uint16_t>(period));
+        vector<double> out(prices.size());
+        ASSERT_EQ(vwma.compute(std::span<const double>(prices).first(split), std::span<const double>(volume).first(split), std::span<double>(out).first(split)), status::ok);
+        ASSERT_EQ(vwma.compute(std::span<const double>(prices).subspan(split), std::span<const double>(volume).subspan(split), std::span<double>(out).subspan(split), computeMode::resume), status::ok);
+
+        for (size_t t = period - 1; t < prices.size(); t++) {
+            double numerator = 0.0;
+            double denominator = 0.0;
+            for (size_t i = t + 1 - period; i <= t; i++) {
+                numerator += prices[i] * volume[i];
+                denominator += volume[i];
+            }
+            EXPECT_NEAR(out[t], numerator / denominator, 1e-9) << "period " << period << " differs at index " << t;
+        }
+        EXPECT_EQ(vwma.latest(), out.back());
+    }
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <tama/tama.hpp>
+#include <vector>
+#include <stdexcept>
+
+using std::vector;
+
+using namespace tama;
+
+namespace {
+    // prices[t][i] is the tick at time t for instrument i.
+    const vector<vector<double>> prices{
+        {11, 10, 101, 55, 7},
+        {12, 12, 99, 54, 8},
+        {14, 11, 98, 56, 9},
+        {18, 13, 102, 57, 7},
+        {12, 12, 104, 53, 6},
+        {15, 14, 103, 52, 8},
+        {13, 15, 101, 58, 9},
+        {16, 13, 100, 59, 10},
+        {10, 14, 97, 60, 9},
+    };
+    const vector<vector<double>> volumes{
+        {100, 250, 10, 40, 1},
+        {120, 200, 12, 45, 2},
+        {90, 210, 11, 50, 1},
+        {150, 240, 9, 35, 3},
+        {110, 260, 14, 42, 2},
+        {130, 230, 10, 48, 1},
+        {95, 220, 13, 41, 2},
+        {140, 215, 12, 39, 3},
+        {105, 245, 11, 44, 2},
+    };
+    // Instruments 0/2 and 1/4 share a bucket.
+    const vector<uint16_t> periods{3, 5, 3, 4, 5};
+
+    vector<double> column(const vector<vector<double>>& rows, size_t instrument) {
+        vector<double> values;
+        for (const auto& row : rows) {
+            values.push_back(row[instrument]);
+        }
+        return values;
+    }
+}
+
+TEST(TamaTest, SmaWmaBanksMatchPerInstrumentCompute_test) {
+    SimpleMovingAverageBank smaBank(periods);
+    WeightedMovingAverageBank wmaBank(periods);
+
+    vector<vector<double>> smaOut;
+    vector<vector<double>> wmaOut;
+    for (const auto& row : prices) {
+        ASSERT_EQ(smaBank.update(row), status::ok);
+        ASSERT_EQ(wmaBank.update(row), status::ok);
+        smaOut.emplace_back(smaBank.latest().begin(), smaBank.latest().end());
+        wmaOut.emplace_back(wmaBank.latest().begin(), wmaBank.latest().end());
+    }
+
+    for (size_t i = 0; i < periods.size(); i++) {
+        vector<double> smaExpected;
+        vector<double> wmaExpected;
+        SimpleMovingAverage sma(periods[i]);
+        WeightedMovingAverage wma(periods[i]);
+        ASSERT_EQ(sma.compute(column(prices, i), smaExpected), status::ok);
+        ASSERT_EQ(wma.compute(column(prices, i), wmaExpected), status::ok);
+
+        for (size_t t = periods[i] - 1; t < prices.size(); t++) {
+            EXPECT_NEAR(smaOut[t][i], smaExpected[t], 1e-12) << "instrument " << i << " differs at index " << t;
+            EXPECT_NEAR(wmaOut[t][i], wmaExpected[t], 1e-12) << "instrument " << i << " differs at index " << t;
+        }
+
+        const SimpleMovingAverageState smaState = smaBank.getState(i);
+        const WeightedMovingAverageState wmaState = wmaBank.getState(i);
+        EXPECT_TRUE(smaState.initialized);
+        EXPECT_EQ(smaState.priceBuf, sma.getState().priceBuf);
+        EXPECT_EQ(wmaState.priceBuf, wma.getState().priceBuf);
+
+        SimpleMovingAverage smaResumed(smaState);
+        WeightedMovingAverage wmaResumed(wmaState);
+        EXPECT_NEAR(smaResumed.update(17.0), sma.update(17.0), 1e-12);
+        EXPECT_NEAR(wmaResumed.update(17.0), wma.update(17.0), 1e-12);
+    }
+}
+
+TEST(TamaTest, VwmaBankMatchesPerInstrumentCompute_test) {
+    VolumeWeightedMovingAverageBank bank(periods);
+
+    vector<vector<double>> bankOut;
+    for (size_t t = 0; t < prices.size(); t++) {
+        ASSERT_EQ(bank.update(prices[t], volumes[t]), status::ok);
+        bankOut.emplace_back(bank.latest().begin(), bank.latest().end());
+    }
+
+    for (size_t i = 0; i < periods.size(); i++) {
+        vector<double> expected;
+        VolumeWeightedMovingAverage vwma(periods[i]);
+        ASSERT_EQ(vwma.compute(column(prices, i), column(volumes, i), expected), status::ok);
+
+        for (size_t t = periods[i] - 1; t < prices.size(); t++) {
+            EXPECT_NEAR(bankOut[t][i], expected[t], 1e-12) << "instrument " << i << " differs at index " << t;
+        }
+
+        VolumeWeightedMovingAverage resumed(bank.getState(i));
+        EXPECT_NEAR(resumed.update(17.0, 100.0), vwma.update(17.0, 100.0), 1e-12);
+    }
+}
+
+TEST(TamaTest, WindowBankStateRoundTrip_test) {
+    SimpleMovingAverageBank bank(periods);
+    for (size_t t = 0; t < 4; t++) {
+        ASSERT_EQ(bank.update(prices[t]), status::ok);
+    }
+
+    // Instruments with period 5 are still warming up.
+    vector<SimpleMovingAverageState> states;
+    for (size_t i = 0; i < bank.size(); i++) {
+        states.push_back(bank.getState(i));
+    }
+    EXPECT_FALSE(states[1].initialized);
+    EXPECT_TRUE(states[3].initialized);
+
+    // A lane that is still warming up reports a fresh state: the four samples
+    // it has absorbed are not carried over.
+    EXPECT_TRUE(states[1].priceBuf.empty());
+    EXPECT_EQ(states[1].rollingSum, 0.0);
+    EXPECT_TRUE(WeightedMovingAverageBank(periods).getState(1).priceBuf.empty());
+    EXPECT_TRUE(VolumeWeightedMovingAverageBank(periods).getState(1).volumeBuf.empty());
+
+    SimpleMovingAverageBank resumed(states);
+    for (size_t t = 4; t < prices.size(); t++) {
+        ASSERT_EQ(bank.update(prices[t]), status::ok);
+        ASSERT_EQ(resumed.update(prices[t]), status::ok);
+
+        // So the rebuilt lane needs a full period of its own before reporting.
+        if (t < 8) {
+            EXPECT_NE(bank.latest()[1], 0.0) << "tick " << t;
+            EXPECT_EQ(resumed.latest()[1], 0.0) << "tick " << t;
+        }
+    }
+
+    for (size_t i : {0u, 2u, 3u}) {
+        EXPECT_NEAR(resumed.latest()[i], bank.latest()[i], 1e-12) << "instrument " << i;
+    }
+}
+
+TEST(TamaTest, WindowBankRejectsInvalidParams_test) {
+    SimpleMovingAverageBank bank(periods);
+    VolumeWeightedMovingAverageBank vwmaBank(periods);
+    const vector<double> tooShort{1, 2};
+    const vector<double> empty{};
+
+    EXPECT_EQ(bank.update(tooShort), status::invalidParam);
+    EXPECT_EQ(bank.update(empty), status::emptyParams);
+    EXPECT_EQ(vwmaBank.update(prices[0], tooShort), status::invalidParam);
+    EXPECT_THROW(SimpleMovingAverageBank(vector<uint16_t>{3, 0}), std::invalid_argument);
+    EXPECT_THROW(bank.getState(periods.size()), std::out_of_range);
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <tama/tama.hpp>
+#include <cmath>
 #include <vector>
+#include <random>
 
 using std::vector;
 
@@ -109,3 +111,74 @@ TEST(TamaTest, WmaComputeThenUpdateMatchesKnownValues_test) {
         EXPECT_NEAR(mixedOut[i], expected[i], 1e-1) << "Vectors differ at index " << i;
     }
 }
+
+TEST(TamaTest, WmaSweepMatchesCompute_test) {
+    std::mt19937_64 gen(7);
+    std::uniform_real_distribution<double> dist(1.0, 100.0);
+    vector<double> prices(10'000);
+    for (double& p : prices) {
+        p = dist(gen);
+    }
+    const vector<uint16_t> periods{3, 20, 200, 5};
+
+    vector<double> periodMajor;
+    vector<double> timeMajor;
+    ASSERT_EQ(tama::WeightedMovingAverage::sweep(prices, periods, periodMajor), status::ok);
+    ASSERT_EQ(tama::WeightedMovingAverage::sweep(prices, periods, timeMajor, sweepLayout::timeMajor), status::ok);
+    ASSERT_EQ(periodMajor.size(), periods.size() * prices.size());
+
+    for (size_t k = 0; k < periods.size(); k++) {
+        vector<double> expected;
+        ASSERT_EQ(tama::WeightedMovingAverage(periods[k]).compute(prices, expected), status::ok);
+
+        for (size_t t = periods[k] - 1; t < prices.size(); t++) {
+            EXPECT_NEAR(periodMajor[k * prices.size() + t], expected[t], 1e-7) << "period " << periods[k] << " differs at index " << t;
+            EXPECT_NEAR(timeMajor[t * periods.size() + k], expected[t], 1e-7) << "period " << periods[k] << " differs at index " << t;
+        }
+    }
+}
+
+TEST(TamaTest, WmaComputeBlockedMatchesCompute_test) {
+    // A trending walk: the rolling sums drift further than on a stationary series.
+    std::mt19937_64 gen(5);
+    std::uniform_real_distribution<double> dist(-1.0, 1.05);
+    vector<double> prices(300'007);
+    double price = 100.0;
+    for (double& p : prices) {
+        price += dist(gen);
+        p = price;
+    }
+
+    for (uint16_t period : {1, 5, 50, 500, 20'000}) {
+        tama::WeightedMovingAverage serial(period);
+        tama::WeightedMovingAverage blocked(period);
+        vector<double> expected;
+        vector<double> actual;
+        ASSERT_EQ(serial.compute(prices, expected), status::ok);
+        ASSERT_EQ(blocked.computeBlocked(prices, actual), status::ok);
+
+        // compute()'s own weighted sum drifts by up to ~1e-10 here; the blocked
+        // one restarts from exact sums and stays well within 1e-11 of the true WMA.
+        ASSERT_EQ(actual.size(), prices.size());
+        for (size_t t = 0; t < prices.size(); t++) {
+            ASSERT_NEAR(actual[t], expected[t], 1e-9 * std::fabs(expected[t])) << "period " << period << " differs at index " << t;
+            if (period <= 50 && t + 1 >= period) {
+                long double weighted = 0.0L;
+                for (size_t i = 0; i < period; i++) {
+                    weighted += static_cast<long double>(prices[t + 1 - period + i]) * static_cast<long double>(i + 1);
+                }
+                const double exact = static_cast<double>(weighted / (static_cast<long double>(period) * (period + 1) / 2));
+                ASSERT_NEAR(actual[t], exact, 1e-11 * std::fabs(exact)) << "period " << period << " drifts at index " << t;
+            }
+        }
+
+        // The state continues like compute()'s.
+        EXPECT_EQ(blocked.latest(), actual.back());
+        EXPECT_NEAR(blocked.update(price + 0.5), serial.update(price + 0.5), 1e-9 * std::fabs(price));
+    }
+
+    tama::WeightedMovingAverage tooLong(10);
+    vector<double> out;
+    EXPECT_EQ(tooLong.computeBlocked(vector<double>(5, 1.0), out), status::invalidParam);
+    EXPECT_EQ(tooLong.computeBlocked(vector<double>{}, out), status::emptyParams);
+}